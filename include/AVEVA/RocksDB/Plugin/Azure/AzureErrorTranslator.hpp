@@ -4,10 +4,12 @@
 #pragma once
 #include <rocksdb/io_status.h>
 #include <azure/core/http/http_status_code.hpp>
+#include <system_error>
 namespace AVEVA::RocksDB::Plugin::Azure
 {
     struct AzureErrorTranslator
     {
         static rocksdb::IOStatus IOStatusFromError(const std::string& context, const ::Azure::Core::Http::HttpStatusCode& statusCode);
+        static rocksdb::IOStatus IOStatusFromError(const std::system_error& error);
     };
 }
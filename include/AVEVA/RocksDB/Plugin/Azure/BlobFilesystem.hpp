@@ -144,5 +144,14 @@ namespace AVEVA::RocksDB::Plugin::Azure
         virtual rocksdb::IOStatus AbortIO(std::vector<void*>& io_handles) override;
         void DiscardCacheForDirectory(const std::string& path) override;
         void SupportedOps(int64_t& supported_ops) override;
+
+        [[nodiscard]] Core::FileCacheMetrics::Snapshot GetFileCacheMetrics() const;
+        [[nodiscard]] std::vector<Core::FileCache::EntryInfo> GetFileCacheEntries() const;
+
+        /// <summary>
+        /// Moves the SST and blob files under <paramref name="path"/> to the stripes they belong on after the
+        /// configured stripes changed. Run it while the database is closed. Returns the number of files moved.
+        /// </summary>
+        size_t RebalanceStripes(const std::string& path);
     };
 }
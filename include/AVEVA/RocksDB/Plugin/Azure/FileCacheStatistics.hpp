@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include "AVEVA/RocksDB/Plugin/Azure/BlobFilesystem.hpp"
+
+#include <rocksdb/env.h>
+#include <rocksdb/statistics.h>
+
+#include <map>
+#include <memory>
+#include <string>
+namespace AVEVA::RocksDB::Plugin::Azure
+{
+    /// <summary>
+    /// Wraps a RocksDB statistics object and appends the file cache counters of a blob filesystem
+    /// to its ticker map and string dump. Everything else is forwarded to the wrapped object.
+    /// </summary>
+    class FileCacheStatistics final : public rocksdb::Statistics
+    {
+        std::shared_ptr<rocksdb::Statistics> m_statistics;
+        std::shared_ptr<BlobFilesystem> m_filesystem;
+    public:
+        FileCacheStatistics(std::shared_ptr<rocksdb::Statistics> statistics, std::shared_ptr<BlobFilesystem> filesystem);
+
+        /// <summary>
+        /// Wraps <paramref name="statistics"/> if <paramref name="env"/> was registered by the plugin,
+        /// otherwise returns <paramref name="statistics"/> unchanged. Assign the result to DBOptions::statistics.
+        /// </summary>
+        [[nodiscard]] static std::shared_ptr<rocksdb::Statistics> Create(const rocksdb::Env& env, std::shared_ptr<rocksdb::Statistics> statistics);
+
+        virtual const char* Name() const override;
+        virtual uint64_t getTickerCount(uint32_t tickerType) const override;
+        virtual void histogramData(uint32_t type, rocksdb::HistogramData* const data) const override;
+        virtual std::string getHistogramString(uint32_t type) const override;
+        virtual void recordTick(uint32_t tickerType, uint64_t count) override;
+        virtual void setTickerCount(uint32_t tickerType, uint64_t count) override;
+        virtual uint64_t getAndResetTickerCount(uint32_t tickerType) override;
+        virtual void reportTimeToHistogram(uint32_t histogramType, uint64_t time) override;
+        virtual void recordInHistogram(uint32_t histogramType, uint64_t time) override;
+        virtual rocksdb::Status Reset() override;
+        using rocksdb::Statistics::ToString;
+        virtual std::string ToString() const override;
+        virtual bool getTickerMap(std::map<std::string, uint64_t>* stats) const override;
+        virtual bool HistEnabledForType(uint32_t type) const override;
+    };
+}
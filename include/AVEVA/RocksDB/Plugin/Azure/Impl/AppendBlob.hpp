@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include "AVEVA/RocksDB/Plugin/Core/BlobClient.hpp"
+#include <azure/storage/blobs/append_blob_client.hpp>
+#include <azure/core/etag.hpp>
+
+#include <cstdint>
+#include <string>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    /// <summary>
+    /// An append only blob. Every flush is one Append Block request with just the new bytes, conditional on the
+    /// blob still ending where the writer expects, and the blob's length is the file size.
+    /// </summary>
+    class AppendBlob final : public Core::BlobClient
+    {
+        ::Azure::Storage::Blobs::AppendBlobClient m_client;
+
+    public:
+        explicit AppendBlob(::Azure::Storage::Blobs::AppendBlobClient client);
+
+        virtual int64_t GetSize() override;
+        virtual void SetSize(int64_t size) override;
+        virtual int64_t GetCapacity() override;
+        virtual void SetCapacity(int64_t capacity) override;
+        virtual void DownloadTo(const std::string& path, int64_t offset, int64_t length) override;
+        virtual int64_t DownloadTo(std::span<char> buffer, int64_t blobOffset, int64_t readLength) override;
+        virtual int64_t Download(std::span<char> buffer, int64_t blobOffset, int64_t readLength, const ::Azure::ETag& ifMatch) override;
+        virtual void UploadPages(const std::span<char> buffer, int64_t blobOffset) override;
+        virtual bool IsAppendOnly() const override;
+        virtual void AppendBlock(std::span<const char> data, int64_t blobOffset) override;
+        virtual ::Azure::ETag GetEtag() override;
+    };
+}
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    /// <summary>
+    /// Files held by a blob of another name. A WAL recycled under a new file number keeps the blob of the log it
+    /// replaces, with the new name in the blob's metadata, so lookups by the new name have to be sent to that blob.
+    /// Which blob holds a file is learnt from recycling and from listings, which report the names in the metadata.
+    /// </summary>
+    class BlobAliases
+    {
+        mutable std::mutex m_mutex;
+        std::map<std::string, std::string, std::less<>> m_blobs;
+
+    public:
+        /// <summary>
+        /// Returns the name of the blob holding <paramref name="realPath"/>, which is the file's own name unless
+        /// the file is known to be held by another blob.
+        /// </summary>
+        [[nodiscard]] std::string Resolve(std::string_view realPath) const;
+
+        /// <summary>
+        /// Returns true if the blob named <paramref name="realPath"/> now holds another file, so that file is gone.
+        /// </summary>
+        [[nodiscard]] bool IsRecycled(std::string_view realPath) const;
+
+        /// <summary>
+        /// Records that <paramref name="blobName"/> holds <paramref name="realPath"/>, and no longer any file it held before.
+        /// </summary>
+        void Record(std::string_view realPath, std::string_view blobName);
+
+        /// <summary>
+        /// Forgets where <paramref name="realPath"/> is held, once it was deleted, renamed or replaced. Returns the blob
+        /// that held it, if it wasn't its own.
+        /// </summary>
+        std::optional<std::string> Forget(std::string_view realPath);
+
+        /// <summary>
+        /// Forgets every file whose name starts with <paramref name="prefix"/>.
+        /// </summary>
+        void ForgetPrefix(std::string_view prefix);
+    };
+}
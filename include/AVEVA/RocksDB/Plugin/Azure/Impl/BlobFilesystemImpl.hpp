@@ -12,13 +12,23 @@
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/LoggerImpl.hpp"
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/LockFileImpl.hpp"
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/BlobAttributes.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/BlobPool.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/BlobAliases.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/CopySource.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/DeletionQueue.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/SmallFileCache.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/NamespaceIndex.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/StripeSet.hpp"
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/DirectoryImpl.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/FilesystemOptions.hpp"
 
 #include <azure/storage/blobs/blob_service_client.hpp>
 #include <azure/storage/blobs/blob_container_client.hpp>
 #include <boost/log/trivial.hpp>
 
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
 #include <unordered_map>
 #include <mutex>
@@ -33,19 +43,41 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         {
             ServiceContainer(::Azure::Storage::Blobs::BlobServiceClient service,
                 ::Azure::Storage::Blobs::BlobContainerClient container)
-                : ServiceClient(std::move(service)), ContainerClient(std::move(container))
+                : ServiceClient(std::move(service)), ContainerClient(std::move(container)),
+                Source(std::make_shared<CopySource>(ServiceClient, ContainerClient))
             {
             }
 
             ::Azure::Storage::Blobs::BlobServiceClient ServiceClient;
             ::Azure::Storage::Blobs::BlobContainerClient ContainerClient;
+            std::shared_ptr<CopySource> Source;
+        };
+
+        struct IndexedDirectory
+        {
+            std::string Prefix;
+            const LockFileImpl* Lock;
+            std::shared_ptr<NamespaceIndex> Index;
         };
 
         std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> m_logger;
         int64_t m_dataFileInitialSize;
         int64_t m_dataFileBufferSize;
+        FilesystemOptions m_options;
+        std::map<Core::RocksDBHelpers::FileClass, FileProfile> m_profiles;
         std::unordered_map<std::string, ServiceContainer, Core::StringHash, Core::StringEqual> m_clients;
+        std::unordered_map<std::string, std::shared_ptr<StripeSet>, Core::StringHash, Core::StringEqual> m_stripeSets;
+        std::unordered_map<std::string, std::vector<std::shared_ptr<CopySource>>, Core::StringHash, Core::StringEqual> m_stripeSources;
         std::unordered_map<std::string, std::shared_ptr<Core::FileCache>, Core::StringHash, Core::StringEqual> m_fileCaches;
+        mutable std::mutex m_blobPoolsMutex;
+        mutable std::unordered_map<std::string, std::unique_ptr<BlobPool>, Core::StringHash, Core::StringEqual> m_blobPools;
+        mutable std::mutex m_deletionQueuesMutex;
+        mutable std::unordered_map<std::string, std::unique_ptr<DeletionQueue>, Core::StringHash, Core::StringEqual> m_deletionQueues;
+        mutable std::mutex m_aliasesMutex;
+        mutable std::unordered_map<std::string, std::unique_ptr<BlobAliases>, Core::StringHash, Core::StringEqual> m_aliases;
+        std::shared_ptr<SmallFileCache> m_smallFiles;
+        mutable std::mutex m_indexesMutex;
+        std::vector<IndexedDirectory> m_indexes;
         std::mutex m_lockFilesMutex;
         boost::intrusive::list<LockFileImpl, boost::intrusive::constant_time_size<false>> m_locks;
         std::stop_source m_filesystemStopSource;
@@ -59,7 +91,8 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
             int64_t dataFileBufferSize,
             std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
             std::optional<std::string_view> cachePath = {},
-            size_t maxCacheSize = Configuration::MaxCacheSize);
+            size_t maxCacheSize = Configuration::MaxCacheSize,
+            const FilesystemOptions& options = {});
         BlobFilesystemImpl(const std::string& name,
             const std::string& storageAccountUrl,
             const std::string& servicePrincipalId,
@@ -69,7 +102,8 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
             int64_t dataFileBufferSize,
             std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
             std::optional<std::string_view> cachePath = {},
-            size_t maxCacheSize = Configuration::MaxCacheSize);
+            size_t maxCacheSize = Configuration::MaxCacheSize,
+            const FilesystemOptions& options = {});
         BlobFilesystemImpl(const std::string& name,
             const std::string& storageAccountUrl,
             const std::string& tenantId,
@@ -80,27 +114,37 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
             int64_t dataFileBufferSize,
             std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
             std::optional<std::string_view> cachePath = {},
-            size_t maxCacheSize = Configuration::MaxCacheSize);
+            size_t maxCacheSize = Configuration::MaxCacheSize,
+            const FilesystemOptions& options = {});
         BlobFilesystemImpl(Models::ChainedCredentialInfo primary,
             std::optional<Models::ChainedCredentialInfo> backup,
             int64_t dataFileInitialSize,
             int64_t dataFileBufferSize,
             std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
             std::optional<std::string_view> cachePath = {},
-            size_t maxCacheSize = Configuration::MaxCacheSize);
+            size_t maxCacheSize = Configuration::MaxCacheSize,
+            const FilesystemOptions& options = {});
         BlobFilesystemImpl(Models::ServicePrincipalStorageInfo primary,
             std::optional<Models::ServicePrincipalStorageInfo> backup,
             int64_t dataFileInitialSize,
             int64_t dataFileBufferSize,
             std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
             std::optional<std::string_view> cachePath = {},
-            size_t maxCacheSize = Configuration::MaxCacheSize);
+            size_t maxCacheSize = Configuration::MaxCacheSize,
+            const FilesystemOptions& options = {});
 
         [[nodiscard]] ReadableFileImpl CreateReadableFile(const std::string& filePath);
         [[nodiscard]] WriteableFileImpl CreateWriteableFile(const std::string& filePath);
         [[nodiscard]] ReadWriteFileImpl CreateReadWriteFile(const std::string& filePath);
         [[nodiscard]] WriteableFileImpl ReopenWriteableFile(const std::string& filePath);
-        [[nodiscard]] WriteableFileImpl ReuseWritableFile(const std::string& filePath);
+
+        /// <summary>
+        /// Opens <paramref name="filePath"/> as an empty file held by the page blob of <paramref name="oldFilePath"/>,
+        /// which keeps its name and capacity, with stale data past the new size left for RocksDB's recyclable log
+        /// format to skip. The new name goes in the blob's metadata. Other kinds of blob can't be emptied, so the file
+        /// then gets a new blob and the old one is deleted in the background.
+        /// </summary>
+        [[nodiscard]] WriteableFileImpl ReuseWritableFile(const std::string& filePath, const std::string& oldFilePath = {});
         LoggerImpl CreateLogger(const std::string& filePath, int logLevel);
         std::shared_ptr<LockFileImpl> LockFile(const std::string& filePath);
         void UnlockFile(LockFileImpl& lock);
@@ -115,10 +159,118 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         [[nodiscard]] int64_t GetFileSize(const std::string& filePath) const;
         [[nodiscard]] uint64_t GetFileModificationTime(const std::string& filePath) const;
         size_t GetLeaseClientCount();
+
+        /// <summary>
+        /// Returns the counters of every file cache combined.
+        /// </summary>
+        [[nodiscard]] Core::FileCacheMetrics::Snapshot GetFileCacheMetrics() const;
+
+        /// <summary>
+        /// Returns the entries of every file cache. Paths include the database prefix, as they are passed to the filesystem.
+        /// </summary>
+        [[nodiscard]] std::vector<Core::FileCache::EntryInfo> GetFileCacheEntries() const;
         void RenameFile(const std::string& fromFilePath, const std::string& toFilePath) const;
+
+        /// <summary>
+        /// Moves the striped files under <paramref name="directoryPath"/> that aren't on the stripe they belong on
+        /// there, after stripes were added or retired. Each file is copied by blob storage, and once the copy is
+        /// verified the file is found on its new stripe and the old blob is queued for background deletion. Run it
+        /// while the database is closed. Returns the number of files moved.
+        /// </summary>
+        size_t RebalanceStripes(const std::string& directoryPath);
+
+        /// <summary>
+        /// Derives the profile of every file class from the data file sizes and <paramref name="options"/>. Throws
+        /// std::invalid_argument if a class is given a blob kind its files can't be written as.
+        /// </summary>
+        [[nodiscard]] static std::map<Core::RocksDBHelpers::FileClass, FileProfile> ResolveProfiles(int64_t dataFileInitialSize,
+            int64_t dataFileBufferSize,
+            const FilesystemOptions& options);
     private:
-        BlobFilesystemImpl(std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>>&& logger, int64_t dataFileInitialSize = 0, int64_t dataFileBufferSize = 0);
+        BlobFilesystemImpl(std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>>&& logger, int64_t dataFileInitialSize = 0, int64_t dataFileBufferSize = 0, FilesystemOptions options = {});
+        void AddFileCache(const std::string& uniquePrefix,
+            const ::Azure::Storage::Blobs::BlobContainerClient& containerClient,
+            std::string_view cachePath,
+            size_t maxCacheSize);
         [[nodiscard]] const ::Azure::Storage::Blobs::BlobContainerClient& GetContainer(std::string_view prefix) const;
+
+        /// <summary>
+        /// Returns the container <paramref name="realPath"/> is in, which is a stripe's for a striped file.
+        /// </summary>
+        [[nodiscard]] const ::Azure::Storage::Blobs::BlobContainerClient& GetContainer(std::string_view prefix, std::string_view realPath) const;
+        void AddStripes(const std::string& uniquePrefix,
+            ::Azure::Storage::Blobs::BlobServiceClient& serviceClient,
+            const ::Azure::Storage::Blobs::BlobContainerClient& containerClient,
+            const std::string& storageAccountUrl,
+            const std::function<::Azure::Storage::Blobs::BlobServiceClient(const std::string&)>& connect);
+        [[nodiscard]] StripeSet* GetStripes(std::string_view prefix) const;
+        [[nodiscard]] size_t StripeCount(std::string_view prefix) const;
+        [[nodiscard]] const ::Azure::Storage::Blobs::BlobContainerClient& GetStripeContainer(std::string_view prefix, size_t stripe) const;
+
+        /// <summary>
+        /// Returns what authorizes blob storage to copy from the stripe's container.
+        /// </summary>
+        [[nodiscard]] CopySource& GetCopySource(std::string_view prefix, size_t stripe) const;
+        [[nodiscard]] size_t LocateStripe(std::string_view prefix, std::string_view realPath) const;
+
+        /// <summary>
+        /// Decides the stripe of a file about to be created and remembers it.
+        /// </summary>
+        size_t PlaceFile(std::string_view prefix, std::string_view realPath) const;
+        [[nodiscard]] const FileProfile& GetProfile(Core::RocksDBHelpers::FileClass fileType) const;
+
+        /// <summary>
+        /// Returns the file cache of the storage account, or nullptr if there is none or the profile doesn't use it.
+        /// </summary>
+        [[nodiscard]] std::shared_ptr<Core::FileCache> GetFileCache(std::string_view prefix, const FileProfile& profile) const;
+        [[nodiscard]] BlobPool* GetBlobPool(std::string_view prefix, bool create) const;
+        [[nodiscard]] DeletionQueue* GetDeletionQueue(std::string_view prefix, bool create, size_t stripe = 0) const;
+
+        /// <summary>
+        /// Finishes a background deletion of <paramref name="realPath"/> before a new blob is created under the name.
+        /// </summary>
+        void SettleDeletion(std::string_view prefix, std::string_view realPath) const;
+        [[nodiscard]] BlobAliases* GetAliases(std::string_view prefix, bool create) const;
+
+        /// <summary>
+        /// Returns the name of the blob holding <paramref name="realPath"/>.
+        /// </summary>
+        [[nodiscard]] std::string ResolveBlob(std::string_view prefix, std::string_view realPath) const;
+
+        /// <summary>
+        /// Returns the name of the file a listed blob holds, and remembers the blob if it was recycled for it.
+        /// </summary>
+        [[nodiscard]] std::string ListedFileName(std::string_view prefix, const ::Azure::Storage::Blobs::Models::BlobItem& blob) const;
+
+        /// <summary>
+        /// Deletes the recycled blob holding <paramref name="realPath"/> in the background, before the name is
+        /// given a blob of its own.
+        /// </summary>
+        void DropAlias(std::string_view prefix, std::string_view realPath) const;
+        void LoadNamespaceIndex(std::string_view prefix, std::string_view lockPath, const LockFileImpl& lock);
+
+        /// <summary>
+        /// Returns the index of the locked directory holding <paramref name="realPath"/>, or nullptr if it isn't indexed.
+        /// </summary>
+        [[nodiscard]] std::shared_ptr<NamespaceIndex> FindIndex(std::string_view prefix, std::string_view realPath) const;
+
+        /// <summary>
+        /// Records a file opened for writing in the index and keeps its size current as it is synced.
+        /// </summary>
+        [[nodiscard]] WriteableFileImpl TrackFile(std::string_view prefix, std::string_view realPath, WriteableFileImpl file) const;
+
+        /// <summary>
+        /// Applies the growth policy of <paramref name="profile"/> to a newly opened file and tracks it.
+        /// </summary>
+        [[nodiscard]] WriteableFileImpl FinishOpen(std::string_view prefix, std::string_view realPath, const FileProfile& profile, WriteableFileImpl file) const;
+        void RenameInIndex(std::string_view prefix, std::string_view from, std::string_view to) const;
+        void ReportIndexMismatch(std::string_view operation, const std::string& path) const;
+        [[nodiscard]] WriteableFileImpl CreateBlockBlobFile(std::string_view prefix, std::string_view realPath, const FileProfile& profile, int64_t bufferCount, DurabilityMode durability);
+        [[nodiscard]] std::optional<int64_t> RecycleBlob(const ::Azure::Storage::Blobs::PageBlobClient& client, bool sizeTrailer, std::string_view fileName) const;
+        [[nodiscard]] std::shared_ptr<Core::BlobClient> OpenSmallFile(const ::Azure::Storage::Blobs::BlobContainerClient& container, const std::string& filePath, std::string_view realPath);
+        void ReplaceWithOtherType(const ::Azure::Storage::Blobs::BlobContainerClient& container, CopySource& source, const ::Azure::Storage::Blobs::BlobClient& srcClient, std::string_view realPathFrom, std::string_view realPathTo) const;
+        void RenameSmallFile(const ::Azure::Storage::Blobs::BlobContainerClient& container, SmallFileCache::Entry entry, const std::string& fromFilePath, std::string_view realPathFrom, const std::string& toFilePath, std::string_view realPathTo) const;
+        [[nodiscard]] WriteableFileImpl CreateAppendBlobFile(std::string_view prefix, std::string_view realPath, const FileProfile& profile, DurabilityMode durability, bool create);
         void RenewLease(std::stop_token stopToken);
         void EnsureLiveness(std::source_location location = std::source_location::current()) const;
     };
@@ -5,6 +5,7 @@
 // #include "AVEVA/RocksDB/Plugin/Azure/Impl/AzureContainerClient.hpp"
 #include "AVEVA/RocksDB/Plugin/Azure/Models/ServicePrincipalStorageInfo.hpp"
 #include "AVEVA/RocksDB/Plugin/Azure/Models/ChainedCredentialInfo.hpp"
+#include "AVEVA/RocksDB/Plugin/Core/BlobClient.hpp"
 
 #include <azure/storage/blobs/page_blob_client.hpp>
 #include <azure/storage/blobs/blob_container_client.hpp>
@@ -13,17 +14,68 @@
 #include <azure/identity/azure_pipelines_credential.hpp>
 
 #include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <utility>
 namespace AVEVA::RocksDB::Plugin::Azure::Impl
 {
     struct BlobHelpers
     {
-        static void SetFileSize(const ::Azure::Storage::Blobs::PageBlobClient& client, int64_t size);
+        /// <summary>
+        /// Stores the file size in the metadata. A blob recycled for a file of another name is given that
+        /// <paramref name="fileName"/> again, since the update replaces all of the metadata.
+        /// </summary>
+        static void SetFileSize(const ::Azure::Storage::Blobs::PageBlobClient& client, int64_t size, std::string_view fileName = {});
         static int64_t GetFileSize(const ::Azure::Storage::Blobs::PageBlobClient& client);
+
+        /// <summary>
+        /// Returns the file size of a blob from a listing that included metadata, without any request. A WAL still
+        /// open with a size trailer is reported as empty, its size is only known from the trailer.
+        /// </summary>
+        static int64_t GetFileSize(const ::Azure::Storage::Blobs::Models::BlobItem& blob);
+
+        /// <summary>
+        /// Returns true if the listed blob keeps its size in a trailer, so the listing doesn't know its size.
+        /// </summary>
+        static bool HasSizeTrailer(const ::Azure::Storage::Blobs::Models::BlobItem& blob);
+
+        /// <summary>
+        /// Returns the name of the file a blob from a listing that included metadata holds. That is the blob's own
+        /// name unless the blob was recycled for a file of another name.
+        /// </summary>
+        static std::string GetFileName(const ::Azure::Storage::Blobs::Models::BlobItem& blob);
+
+        /// <summary>
+        /// Returns the file size of the blob a download came from, using the metadata returned with the data.
+        /// </summary>
+        static int64_t GetFileSize(const ::Azure::Storage::Blobs::Models::DownloadBlobResult& download, const ::Azure::Storage::Blobs::PageBlobClient& client);
+        static ::Azure::Storage::Metadata FileSizeMetadata(int64_t size, std::string_view fileName = {});
+
+        /// <summary>
+        /// Metadata marking a blob whose size is kept in a trailer page right after its data instead of in
+        /// the metadata. Setting the size with <see cref="SetFileSize"/> replaces the marker.
+        /// </summary>
+        static ::Azure::Storage::Metadata SizeTrailerMetadata(std::string_view fileName = {});
+        static void WriteSizeTrailer(std::span<char> page, int64_t size);
+        static std::optional<int64_t> ReadSizeTrailer(std::span<const char> page, int64_t pageOffset);
         static int64_t GetBlobCapacity(const ::Azure::Storage::Blobs::PageBlobClient& client);
         static std::pair<int64_t, int64_t> RoundToEndOfNearestPage(int64_t size);
         static std::pair<int64_t, int64_t> RoundToBeginningOfNearestPage(int64_t size);
+
+        /// <summary>
+        /// Uploads page aligned data in chunks no larger than the Put Page limit, with up to
+        /// <paramref name="maxConcurrency"/> chunks in flight. Rethrows the first failure once every chunk has finished.
+        /// </summary>
+        static void UploadPages(Core::BlobClient& client, std::span<char> pages, int64_t blobOffset, int64_t maxConcurrency = 1);
+
+        /// <summary>
+        /// Calls <paramref name="task"/> with every index below <paramref name="taskCount"/>, running up to
+        /// <paramref name="maxConcurrency"/> at once on the caller and helper threads. Rethrows the first failure once all have stopped.
+        /// </summary>
+        static void RunConcurrently(int64_t taskCount, int64_t maxConcurrency, const std::function<void(int64_t)>& task);
         static ::Azure::Storage::Blobs::BlobClientOptions CreateBlobClientOptions();
         static ::Azure::Identity::ClientSecretCredentialOptions CreateClientSecretCredentialOptions();
         static ::Azure::Identity::AzurePipelinesCredentialOptions CreatePipelinesCredentialOptions();
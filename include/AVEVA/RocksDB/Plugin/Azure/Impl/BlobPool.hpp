@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include <azure/storage/blobs/blob_container_client.hpp>
+#include <boost/log/trivial.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    /// <summary>
+    /// Creates empty page blobs in the background under the names RocksDB is expected to ask for next, so creating
+    /// a WAL or SST file is usually claiming a blob that already exists. Pooled blobs are hidden from listings until
+    /// claimed and carry a metadata marker until the writer first sets the file size. Marked blobs left behind by an
+    /// earlier process are deleted before the pool creates its first blob.
+    /// </summary>
+    class BlobPool
+    {
+        enum class State
+        {
+            Queued,
+            Creating,
+            Ready,
+        };
+
+        ::Azure::Storage::Blobs::BlobContainerClient m_container;
+        int64_t m_depth;
+        int64_t m_initialSize;
+        std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> m_logger;
+
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::map<std::string, State, std::less<>> m_blobs;
+        std::deque<std::string> m_createQueue;
+        std::deque<std::string> m_deleteQueue;
+        std::deque<std::string> m_garbagePrefixes;
+        std::set<std::string, std::less<>> m_collectedPrefixes;
+        std::stop_source m_stopSource;
+        std::jthread m_worker;
+
+    public:
+        BlobPool(::Azure::Storage::Blobs::BlobContainerClient container,
+            int64_t depth,
+            int64_t initialSize,
+            std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger);
+        ~BlobPool();
+        BlobPool(const BlobPool&) = delete;
+        BlobPool& operator=(const BlobPool&) = delete;
+
+        /// <summary>
+        /// Takes the pooled blob for <paramref name="realPath"/> out of the pool. Returns false if it isn't ready,
+        /// and the caller has to create the blob itself. A blob still being created then won't replace it.
+        /// </summary>
+        [[nodiscard]] bool Claim(std::string_view realPath);
+
+        /// <summary>
+        /// Queues blobs for the file numbers following <paramref name="realPath"/> and drops those it passed.
+        /// </summary>
+        void Replenish(std::string_view realPath);
+
+        /// <summary>
+        /// Returns true if <paramref name="realPath"/> is a pooled blob that no file has claimed.
+        /// </summary>
+        [[nodiscard]] bool Contains(std::string_view realPath);
+
+        /// <summary>
+        /// Stops tracking <paramref name="realPath"/>, once it was deleted or replaced by another file.
+        /// </summary>
+        void Forget(std::string_view realPath);
+
+        /// <summary>
+        /// Returns the <paramref name="count"/> file names following <paramref name="realPath"/> with the same
+        /// directory, extension and number width, or none if the name doesn't end in a RocksDB file number.
+        /// </summary>
+        [[nodiscard]] static std::vector<std::string> PredictNames(std::string_view realPath, int64_t count);
+
+    private:
+        struct FileName
+        {
+            std::string_view Directory;
+            uint64_t Number;
+            size_t Width;
+            std::string_view Extension;
+        };
+
+        [[nodiscard]] static std::optional<FileName> ParseName(std::string_view realPath);
+        void Work(std::stop_token stopToken);
+        void Create(const std::string& realPath);
+        void CollectGarbage(const std::string& prefix);
+        void DeleteUnclaimed();
+    };
+}
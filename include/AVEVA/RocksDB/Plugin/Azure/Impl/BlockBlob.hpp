@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include "AVEVA/RocksDB/Plugin/Core/BlobClient.hpp"
+#include <azure/storage/blobs/block_blob_client.hpp>
+#include <azure/core/etag.hpp>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    /// <summary>
+    /// Writes a new block blob through the page oriented client interface. Uploaded pages are staged as blocks
+    /// keyed by their offset and SetSize commits the block list, so the blob's length is the file size.
+    /// Writes must be sequential: an upload may only restart at the last page uploaded so far.
+    /// </summary>
+    class BlockBlob final : public Core::BlobClient
+    {
+        ::Azure::Storage::Blobs::BlockBlobClient m_client;
+        std::mutex m_mutex;
+        std::map<int64_t, int64_t> m_blocks; // Staged block lengths by blob offset.
+        std::vector<char> m_lastPage;        // Copy of the last staged page, restaged to the file size on commit.
+        int64_t m_lastPageOffset;
+        int64_t m_size;
+        bool m_committed;
+
+    public:
+        explicit BlockBlob(::Azure::Storage::Blobs::BlockBlobClient client);
+
+        virtual int64_t GetSize() override;
+        virtual void SetSize(int64_t size) override;
+        virtual int64_t GetCapacity() override;
+        virtual void SetCapacity(int64_t capacity) override;
+        virtual void DownloadTo(const std::string& path, int64_t offset, int64_t length) override;
+        virtual int64_t DownloadTo(std::span<char> buffer, int64_t blobOffset, int64_t readLength) override;
+        virtual int64_t Download(std::span<char> buffer, int64_t blobOffset, int64_t readLength, const ::Azure::ETag& ifMatch) override;
+        virtual void UploadPages(const std::span<char> buffer, int64_t blobOffset) override;
+        virtual ::Azure::ETag GetEtag() override;
+
+    private:
+        void StageBlock(std::span<char> data, int64_t blobOffset);
+        [[nodiscard]] static std::string BlockId(int64_t blobOffset);
+    };
+}
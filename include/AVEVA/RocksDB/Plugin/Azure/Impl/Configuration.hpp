@@ -4,6 +4,7 @@
 #pragma once
 #include <cstdint>
 #include <chrono>
+#include <cstddef>
 namespace AVEVA::RocksDB::Plugin::Azure::Impl
 {
     struct Configuration
@@ -14,11 +15,45 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
             static const constexpr int64_t PageBits = 9;
             static const constexpr int64_t DefaultSize = 128 * PageSize * 2;
             static const constexpr int64_t DefaultBufferSize = 128 * PageSize * 2;
+            static const constexpr int64_t MaxUploadSize = static_cast<int64_t>(4) * 1024 * 1024; // Put Page limit
+            static const constexpr int64_t DefaultUploadConcurrency = 4;
         };
 
         static const constexpr std::chrono::seconds LeaseLength = std::chrono::seconds(20);
         static const constexpr std::chrono::seconds RenewalDelay = std::chrono::seconds(5);
         static const constexpr size_t MaxCacheSize = static_cast<size_t>(1024) * 1024 * 1024; // 1GB
         static const constexpr int MaxClientRetries = 8;
+        static const constexpr std::chrono::milliseconds CopyPollInterval = std::chrono::milliseconds(50);
+        static const constexpr size_t SmallFileCacheCount = 32;
+
+        struct Deletion
+        {
+            static const constexpr size_t MaxBatchSize = 256; // Blob Batch subrequest limit
+            static const constexpr int64_t Concurrency = 4;
+            static const constexpr int MaxAttempts = 5;
+            static const constexpr std::chrono::milliseconds InitialBackoff = std::chrono::milliseconds(100);
+        };
+
+        struct Copy
+        {
+            // Server-side copies read their source for as long as they run, so the SAS is generous.
+            static const constexpr std::chrono::hours SasLifetime = std::chrono::hours(1);
+            static const constexpr std::chrono::hours KeyLifetime = std::chrono::hours(24);
+            static const constexpr std::chrono::minutes ClockSkew = std::chrono::minutes(5);
+        };
+
+        struct NamespaceIndex
+        {
+            // Blob storage stamps its own clock on every page written, the index the local time of the last sync.
+            static const constexpr std::chrono::seconds ModifiedTimeTolerance = std::chrono::seconds(60);
+        };
+
+        struct InfoLog
+        {
+            static const constexpr size_t RingCapacity = 1024;
+            static const constexpr size_t MaxSpillSize = static_cast<size_t>(16) * 1024 * 1024;
+            static const constexpr std::chrono::milliseconds WriteInterval = std::chrono::milliseconds(1000);
+            static const constexpr std::chrono::milliseconds FlushTimeout = std::chrono::milliseconds(10000);
+        };
     };
 }
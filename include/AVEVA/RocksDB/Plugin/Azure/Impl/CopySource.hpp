@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include <azure/storage/blobs/blob_container_client.hpp>
+#include <azure/storage/blobs/blob_service_client.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    /// <summary>
+    /// Authorizes blob storage to read the blobs of a container as the source of a server-side copy. The token
+    /// credential of the service client only authorizes this host's own requests, so copy sources are passed with a
+    /// read-only user delegation SAS. The user delegation key is requested once and reused until it is about to expire.
+    /// </summary>
+    class CopySource
+    {
+        ::Azure::Storage::Blobs::BlobServiceClient m_service;
+        ::Azure::Storage::Blobs::BlobContainerClient m_container;
+        std::string m_accountName;
+        std::string m_containerName;
+        std::mutex m_mutex;
+        std::optional<::Azure::Storage::Blobs::Models::UserDelegationKey> m_key;
+        std::chrono::system_clock::time_point m_keyExpiresOn;
+
+    public:
+        CopySource(::Azure::Storage::Blobs::BlobServiceClient service, ::Azure::Storage::Blobs::BlobContainerClient container);
+
+        /// <summary>
+        /// Returns the URL of <paramref name="blobName"/> in the container with a SAS that lets blob storage read it
+        /// for Configuration::Copy::SasLifetime.
+        /// </summary>
+        [[nodiscard]] std::string Url(const std::string& blobName);
+    };
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include <azure/storage/blobs/blob_container_client.hpp>
+#include <boost/log/trivial.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    /// <summary>
+    /// Deletes blobs in the background. Queued names are collected into Blob Batch requests of up to 256
+    /// deletions, several batches are submitted at once, and failed deletions are retried with backoff.
+    /// A blob already gone counts as deleted.
+    /// </summary>
+    class DeletionQueue
+    {
+        ::Azure::Storage::Blobs::BlobContainerClient m_container;
+        int64_t m_concurrency;
+        std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> m_logger;
+
+        enum class PendingState
+        {
+            Queued,
+            Submitting,
+            // Enqueued again while its batch was submitted, the blob may have been recreated in between.
+            SubmittingRequeue
+        };
+
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::deque<std::string> m_queue;
+        std::map<std::string, PendingState, std::less<>> m_pending;
+        std::stop_source m_stopSource;
+        std::jthread m_worker;
+
+    public:
+        DeletionQueue(::Azure::Storage::Blobs::BlobContainerClient container,
+            int64_t concurrency,
+            std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger);
+
+        /// <summary>
+        /// Stops the background thread once every queued deletion was submitted.
+        /// </summary>
+        ~DeletionQueue();
+        DeletionQueue(const DeletionQueue&) = delete;
+        DeletionQueue& operator=(const DeletionQueue&) = delete;
+
+        void Enqueue(std::string_view realPath);
+
+        /// <summary>
+        /// Returns true if <paramref name="realPath"/> is waiting to be deleted, so it must look deleted already.
+        /// </summary>
+        [[nodiscard]] bool Contains(std::string_view realPath);
+
+        /// <summary>
+        /// Finishes a pending deletion of <paramref name="realPath"/> before the name is used for a new blob. A queued
+        /// deletion is carried out right away, and one in a batch being submitted is waited for.
+        /// </summary>
+        void Settle(std::string_view realPath);
+
+        /// <summary>
+        /// Deletes <paramref name="realPaths"/> on the calling thread with concurrent batches and retries.
+        /// Returns the number of blobs that could not be deleted.
+        /// </summary>
+        [[nodiscard]] size_t DeleteNow(std::span<const std::string> realPaths);
+
+    private:
+        void Work(std::stop_token stopToken);
+        [[nodiscard]] std::vector<std::string> DeleteWithRetry(std::vector<std::string> realPaths);
+
+        /// <summary>
+        /// Submits one round of batches and returns the names whose deletion failed.
+        /// </summary>
+        [[nodiscard]] std::vector<std::string> SubmitBatches(std::span<const std::string> realPaths);
+    };
+}
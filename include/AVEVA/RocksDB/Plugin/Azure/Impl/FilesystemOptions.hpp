@@ -0,0 +1,279 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include "AVEVA/RocksDB/Plugin/Core/RocksDBHelpers.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/Configuration.hpp"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    /// <summary>
+    /// When the data appended to a writeable file reaches blob storage. Full write buffers are uploaded
+    /// as they fill in every mode, so a crash may leave any prefix of the unsynced data behind.
+    /// </summary>
+    enum class DurabilityMode
+    {
+        /// <summary>
+        /// Flush uploads the buffer, including the partial last page, and Sync also stores the size.
+        /// Data flushed before a process crash is in the blob but only visible up to the last synced size.
+        /// </summary>
+        Flush,
+
+        /// <summary>
+        /// Flush only keeps the data in memory and Sync uploads it and stores the size. A process crash
+        /// loses everything appended since the last Sync, like a machine crash with a local filesystem.
+        /// </summary>
+        Sync,
+
+        /// <summary>
+        /// Flush and Sync only keep the data in memory and Close uploads it and stores the size. A crash
+        /// before Close loses the whole file, so this is only meant for bulk loads that are restarted on failure.
+        /// </summary>
+        Close,
+    };
+
+    /// <summary>
+    /// What happens to info log records while the ring between the logging threads and the log writer is full.
+    /// Either way the logging thread carries on without waiting for blob storage.
+    /// </summary>
+    enum class LogOverflowPolicy
+    {
+        /// <summary>
+        /// The record is discarded, and the writer notes how many were lost in the log.
+        /// </summary>
+        Drop,
+
+        /// <summary>
+        /// The record is queued in memory behind the ring, up to Configuration::InfoLog::MaxSpillSize, and dropped beyond that.
+        /// </summary>
+        Spill,
+    };
+
+    /// <summary>
+    /// How file existence, sizes, modification times and directory listings are answered inside a database
+    /// directory this process holds the LOCK of.
+    /// </summary>
+    enum class NamespaceIndexMode
+    {
+        /// <summary>
+        /// Every question is a request to blob storage.
+        /// </summary>
+        Off,
+
+        /// <summary>
+        /// The directory is listed once when it is locked, and the index kept by the filesystem's own writes,
+        /// renames and deletions answers from then on. Files changed behind the filesystem's back, which the
+        /// lease rules out for RocksDB, aren't noticed.
+        /// </summary>
+        Authoritative,
+
+        /// <summary>
+        /// The index is kept as with Authoritative but every answer still comes from blob storage, and a warning
+        /// is logged whenever the two disagree.
+        /// </summary>
+        Validate,
+    };
+
+    /// <summary>
+    /// Kind of blob a new file is written as.
+    /// </summary>
+    enum class BlobKind
+    {
+        /// <summary>
+        /// A page blob sized ahead of the data, with the file size in its metadata.
+        /// </summary>
+        Page,
+
+        /// <summary>
+        /// A block blob staged as the file is written and committed by Sync or Close.
+        /// </summary>
+        Block,
+
+        /// <summary>
+        /// An append blob, one Append Block per flush.
+        /// </summary>
+        Append,
+
+        /// <summary>
+        /// Kept in memory and stored with one Put Blob on Close, for files that are small and written at once.
+        /// </summary>
+        OneShot,
+    };
+
+    /// <summary>
+    /// How the files of one class are written and read.
+    /// </summary>
+    struct FileProfile
+    {
+        /// <summary>
+        /// Size of each write buffer.
+        /// </summary>
+        int64_t BufferSize;
+
+        /// <summary>
+        /// Capacity a new page blob is created with.
+        /// </summary>
+        int64_t InitialSize;
+
+        /// <summary>
+        /// Step a page blob grows in when a flush runs past its capacity. Zero doubles the capacity instead,
+        /// and RocksDB's own preallocation block size still replaces either.
+        /// </summary>
+        int64_t GrowthBlockSize;
+
+        /// <summary>
+        /// Bytes fetched by a sequential read that misses the readahead buffer, when more than asked for.
+        /// Zero downloads exactly what is asked for.
+        /// </summary>
+        int64_t Readahead;
+
+        /// <summary>
+        /// Whether reads and writes go through the file cache. The cache only ever keeps SST and blob files,
+        /// which don't change once written.
+        /// </summary>
+        bool Cacheable;
+
+        BlobKind BlobType;
+    };
+
+    /// <summary>
+    /// Replaces parts of the profile FilesystemOptions derive for a file class. Unset fields keep the derived value.
+    /// </summary>
+    struct FileProfileOverride
+    {
+        std::optional<int64_t> BufferSize;
+        std::optional<int64_t> InitialSize;
+        std::optional<int64_t> GrowthBlockSize;
+        std::optional<int64_t> Readahead;
+        std::optional<bool> Cacheable;
+        std::optional<BlobKind> BlobType;
+    };
+
+    /// <summary>
+    /// A container the SST and blob files of the database are striped over, in addition to the database's own.
+    /// </summary>
+    struct StripeTarget
+    {
+        /// <summary>
+        /// Storage account holding the container, reached with the filesystem's credential. Empty means the primary
+        /// storage account. A shared key only signs requests to its own account.
+        /// </summary>
+        std::string StorageAccountUrl;
+        std::string ContainerName;
+
+        /// <summary>
+        /// Place new files on this stripe. A stripe being retired keeps serving its files, and RebalanceStripes
+        /// moves them to the stripes they now belong on.
+        /// </summary>
+        bool AcceptsNewFiles = true;
+    };
+
+    struct FilesystemOptions
+    {
+        /// <summary>
+        /// Share the cache directory and its byte budget with every other process pointed at the same directory.
+        /// Files are kept per database inside the directory, so processes opening the same database
+        /// (e.g. read-only views) reuse each other's downloads.
+        /// </summary>
+        bool SharedFileCache = false;
+
+        /// <summary>
+        /// Number of write buffers per WAL or SST file. With more than one, full buffers are uploaded
+        /// in the background while appends fill the next buffer, and Sync/Close wait for the uploads.
+        /// </summary>
+        int64_t WriteBufferCount = 1;
+
+        /// <summary>
+        /// Maximum number of Put Page requests in flight for a single flush. Flushes larger than
+        /// the 4 MiB Put Page limit are split into chunks, so this only matters for large buffers.
+        /// </summary>
+        int64_t UploadConcurrency = Configuration::PageBlob::DefaultUploadConcurrency;
+
+        /// <summary>
+        /// Keep the size of new WAL files in a trailer page uploaded with the data, so Sync is a single
+        /// Put Page instead of a Put Page followed by a metadata update. The size moves to the metadata
+        /// on Close. Blobs written either way are read correctly. Implies one write buffer for WAL files.
+        /// Syncs larger than the 4 MiB Put Page limit are uploaded one chunk at a time. Looking up the size of a
+        /// WAL that is still open costs a Get Page Ranges and a ranged read to find the trailer. Listings skip the
+        /// lookup and report such a WAL as empty until it is closed.
+        /// </summary>
+        bool WalSizeTrailer = false;
+
+        /// <summary>
+        /// Durability of WAL and SST files. Other files, such as the MANIFEST, always use DurabilityMode::Flush.
+        /// </summary>
+        DurabilityMode Durability = DurabilityMode::Flush;
+
+        /// <summary>
+        /// Byte budget of the page cache of each random read/write file. Written pages stay cached until they
+        /// are written back, and reads are served from the cache before going to blob storage.
+        /// </summary>
+        int64_t ReadWriteCacheSize = Configuration::PageBlob::DefaultBufferSize;
+
+        /// <summary>
+        /// Write new SST files as block blobs. Blocks are staged as the file is written and committed by Sync or
+        /// Close, so no resizing or size metadata is needed. WAL, MANIFEST and other files stay page blobs.
+        /// </summary>
+        bool BlockBlobSst = false;
+
+        /// <summary>
+        /// Write new WAL and info LOG files as append blobs. Every flush is a single Append Block carrying just the
+        /// new bytes, and the blob's length is the file size. Implies one write buffer and no size trailer for WAL
+        /// files. Existing page blob WALs are still reopened as page blobs, and the MANIFEST stays a page blob.
+        /// </summary>
+        bool AppendBlobLogs = false;
+
+        /// <summary>
+        /// Number of page blobs created ahead of time for the WAL and SST file numbers following the last one created,
+        /// so creating one of them doesn't wait for blob storage. Zero disables the pool. Not used for files written
+        /// as block or append blobs or with a size trailer.
+        /// </summary>
+        int64_t BlobPoolDepth = 0;
+
+        /// <summary>
+        /// Write CURRENT, OPTIONS, IDENTITY and temporary files in memory and store them with one Put Blob on Close,
+        /// as block blobs whose length is the file size. Renaming one uploads the copy kept in memory instead of
+        /// downloading it again, and reads of small files are revalidated against an in-process cache.
+        /// </summary>
+        bool OneShotSmallFiles = false;
+
+        /// <summary>
+        /// Handling of info log records produced faster than the background writer can upload them.
+        /// </summary>
+        LogOverflowPolicy InfoLogOverflow = LogOverflowPolicy::Spill;
+
+        /// <summary>
+        /// Delete files in the background. DeleteFile hides the file and removes it from the file cache at once,
+        /// and the blobs are deleted in concurrent Blob Batch requests with retries. A missing file is still reported
+        /// as not found, from the index inside a locked database directory and with a properties call elsewhere.
+        /// </summary>
+        bool AsyncDelete = false;
+
+        /// <summary>
+        /// Answer metadata questions about a locked database directory from an in-memory index.
+        /// </summary>
+        NamespaceIndexMode NamespaceIndexing = NamespaceIndexMode::Off;
+
+        /// <summary>
+        /// Per file class changes to the profile derived from the data file sizes and the options above. Files are
+        /// classified by RocksDB's file name grammar once when they are opened. The blob pool only serves WAL and SST
+        /// files written as page blobs, and an existing file is reopened as the kind of blob it already is. Only
+        /// CURRENT, OPTIONS, IDENTITY and temporary files can be one shot blobs, WAL, MANIFEST and temporary files
+        /// can't be block blobs, and info logs can only be page or append blobs. Other choices are rejected.
+        /// </summary>
+        std::map<Core::RocksDBHelpers::FileClass, FileProfileOverride> FileProfiles;
+
+        /// <summary>
+        /// Containers to spread SST and blob files over, so their requests are shared between several accounts'
+        /// limits. Files are placed by a consistent hash of their file number, and CURRENT, MANIFEST, WAL and other
+        /// files stay in the primary container. Listings cover every stripe. Stripes are added to the primary
+        /// database only, and the blob pool only serves files placed in the primary container.
+        /// </summary>
+        std::vector<StripeTarget> Stripes;
+    };
+}
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    /// <summary>
+    /// Bounded lock-free queue of log records with any number of producers and a single consumer.
+    /// Every slot carries a sequence number telling producers and the consumer whose turn it is.
+    /// </summary>
+    class LogRing
+    {
+        struct Slot
+        {
+            std::atomic<uint64_t> Sequence;
+            std::string Record;
+        };
+
+        std::unique_ptr<Slot[]> m_slots;
+        size_t m_mask;
+        alignas(64) std::atomic<uint64_t> m_enqueuePosition;
+        alignas(64) std::atomic<uint64_t> m_dequeuePosition;
+
+    public:
+        /// <summary>
+        /// Creates a ring of at least <paramref name="capacity"/> slots, rounded up to a power of two.
+        /// </summary>
+        explicit LogRing(size_t capacity);
+
+        /// <summary>
+        /// Moves <paramref name="record"/> into the ring. Returns false and leaves it untouched if the ring is full.
+        /// </summary>
+        [[nodiscard]] bool TryPush(std::string& record);
+
+        /// <summary>
+        /// Moves the oldest record into <paramref name="record"/>. Only one thread may pop at a time.
+        /// </summary>
+        [[nodiscard]] bool TryPop(std::string& record);
+
+        [[nodiscard]] size_t Capacity() const;
+        [[nodiscard]] size_t SizeApprox() const;
+    };
+}
@@ -3,21 +3,34 @@
 
 #pragma once
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/WriteableFileImpl.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/FilesystemOptions.hpp"
 #include <cstdarg>
 #include <memory>
-#include <vector>
 namespace AVEVA::RocksDB::Plugin::Azure::Impl
 {
+    /// <summary>
+    /// Info log whose records are formatted by the logging thread and handed to a background writer through a
+    /// lock-free ring. The writer uploads everything queued in one batch per interval, or sooner when asked to
+    /// flush or when the ring fills up, so logging never waits for blob storage. Only Flush waits for the writer.
+    /// </summary>
     class LoggerImpl
     {
-        std::unique_ptr<WriteableFileImpl> m_file;
+        struct Writer;
+        std::unique_ptr<Writer> m_writer;
         int m_logLevel;
-        std::vector<char> m_buffer;
     public:
-        LoggerImpl(std::unique_ptr<WriteableFileImpl> file, int logLevel);
+        LoggerImpl(std::unique_ptr<WriteableFileImpl> file, int logLevel, LogOverflowPolicy overflow = LogOverflowPolicy::Spill);
+        ~LoggerImpl();
+        LoggerImpl(LoggerImpl&& other) noexcept;
+        LoggerImpl& operator=(LoggerImpl&& other) noexcept;
 
         void Logv(int logLevel, const char* format, ...);
         void Logv(int logLevel, const char* format, va_list ap);
+
+        /// <summary>
+        /// Asks the writer to upload the records queued so far and waits until it has, or until
+        /// Configuration::InfoLog::FlushTimeout runs out.
+        /// </summary>
         void Flush();
     };
 }
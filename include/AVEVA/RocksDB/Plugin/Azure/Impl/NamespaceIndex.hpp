@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    /// <summary>
+    /// Names, sizes and modification times of the files in a database directory. The lease on the directory's
+    /// LOCK file makes this process its only writer, so after one listing the index is kept current by the
+    /// filesystem's own operations and metadata questions are answered without asking blob storage.
+    /// </summary>
+    class NamespaceIndex
+    {
+    public:
+        /// <summary>
+        /// A file whose size isn't tracked, such as one open for random writes, only has its existence recorded.
+        /// </summary>
+        struct Entry
+        {
+            std::optional<int64_t> Size;
+            uint64_t ModifiedTime;
+        };
+
+    private:
+        std::string m_directory;
+        mutable std::mutex m_mutex;
+        std::map<std::string, Entry, std::less<>> m_entries;
+
+    public:
+        /// <summary>
+        /// Indexes the blobs under <paramref name="directory"/>, where an empty directory is the whole container.
+        /// </summary>
+        explicit NamespaceIndex(std::string directory);
+
+        /// <summary>
+        /// Returns true if <paramref name="realPath"/> is the indexed directory or a path inside it.
+        /// </summary>
+        [[nodiscard]] bool Covers(std::string_view realPath) const noexcept;
+
+        /// <summary>
+        /// Prefix of every blob in the directory, to list them with.
+        /// </summary>
+        [[nodiscard]] std::string ListingPrefix() const;
+
+        void Put(std::string_view realPath, std::optional<int64_t> size, uint64_t modifiedTime);
+
+        /// <summary>
+        /// Records a new size of a file still in the index. A file deleted while it was open stays deleted.
+        /// </summary>
+        void Update(std::string_view realPath, int64_t size, uint64_t modifiedTime);
+
+        /// <summary>
+        /// Returns true if the file was in the index.
+        /// </summary>
+        bool Remove(std::string_view realPath);
+
+        /// <summary>
+        /// Removes every entry whose name starts with <paramref name="prefix"/>.
+        /// </summary>
+        void RemovePrefix(std::string_view prefix);
+        void Rename(std::string_view from, std::string_view to, uint64_t modifiedTime);
+
+        [[nodiscard]] std::optional<Entry> Find(std::string_view realPath) const;
+
+        /// <summary>
+        /// Returns true if any file is inside <paramref name="realPath"/> taken as a directory.
+        /// </summary>
+        [[nodiscard]] bool HasChildren(std::string_view realPath) const;
+
+        /// <summary>
+        /// Returns the entries whose name starts with <paramref name="prefix"/>, in name order, like a listing would.
+        /// </summary>
+        [[nodiscard]] std::vector<std::pair<std::string, Entry>> List(std::string_view prefix) const;
+    };
+}
@@ -5,14 +5,21 @@
 #include "AVEVA/RocksDB/Plugin/Core/BlobClient.hpp"
 #include <azure/storage/blobs/page_blob_client.hpp>
 #include <azure/core/etag.hpp>
+
+#include <string>
 namespace AVEVA::RocksDB::Plugin::Azure::Impl
 {
     class PageBlob final : public Core::BlobClient
     {
         ::Azure::Storage::Blobs::PageBlobClient m_client;
+        std::string m_fileName;
 
     public:
-        explicit PageBlob(::Azure::Storage::Blobs::PageBlobClient client);
+        /// <summary>
+        /// A non-empty <paramref name="fileName"/> is the file a blob recycled under another name holds, and is
+        /// kept in the metadata whenever the size is stored.
+        /// </summary>
+        explicit PageBlob(::Azure::Storage::Blobs::PageBlobClient client, std::string fileName = {});
 
         virtual int64_t GetSize() override;
         virtual void SetSize(int64_t size) override;
@@ -21,6 +28,7 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         virtual void DownloadTo(const std::string& path, int64_t offset, int64_t length) override;
         virtual int64_t DownloadTo(std::span<char> buffer, int64_t blobOffset, int64_t readLength) override;
         virtual int64_t Download(std::span<char> buffer, int64_t blobOffset, int64_t readLength, const ::Azure::ETag& ifMatch) override;
+        virtual int64_t DownloadLatest(std::span<char> buffer, int64_t blobOffset, int64_t readLength, BlobInfo& info) override;
         virtual void UploadPages(const std::span<char> buffer, int64_t blobOffset) override;
         virtual ::Azure::ETag GetEtag() override;
     };
@@ -4,20 +4,34 @@
 #pragma once
 #include "AVEVA/RocksDB/Plugin/Core/FileCache.hpp"
 #include "AVEVA/RocksDB/Plugin/Core/BlobClient.hpp"
-#include "AVEVA/RocksDB/Plugin/Azure/Impl/BufferChunkInfo.hpp"
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/Configuration.hpp"
 
 #include <boost/log/trivial.hpp>
 
+#include <array>
+#include <bitset>
 #include <cstdint>
+#include <map>
 #include <string_view>
 #include <string>
 #include <memory>
 #include <vector>
 namespace AVEVA::RocksDB::Plugin::Azure::Impl
 {
+    /// <summary>
+    /// A page blob opened for random reads and writes. Writes go to a page-granular cache that is written
+    /// back on Flush, Sync or when it reaches its byte budget, and reads see the cached writes.
+    /// </summary>
     class ReadWriteFileImpl
     {
+        struct CachedPage
+        {
+            std::array<char, Configuration::PageBlob::PageSize> Data{};
+            std::bitset<Configuration::PageBlob::PageSize> Written; // Bytes written locally, only tracked until Loaded.
+            bool Loaded = false;                                   // The bytes not written locally hold the blob's data.
+            bool Dirty = false;
+        };
+
         std::string m_name;
         std::shared_ptr<Core::BlobClient> m_blobClient;
         std::shared_ptr<Core::FileCache> m_fileCache;
@@ -25,16 +39,18 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
 
         int64_t m_size;
         int64_t m_syncSize;
+        int64_t m_flushedSize;
         int64_t m_capacity;
+        int64_t m_cacheSize;
         bool m_closed;
 
-        std::vector<char> m_buffer;
-        std::vector<BufferChunkInfo> m_bufferStats; // to track where page info is to be inserted
+        std::map<int64_t, CachedPage> m_pages; // Keyed by page index.
     public:
         ReadWriteFileImpl(std::string_view name,
             std::shared_ptr<Core::BlobClient> blobClient,
             std::shared_ptr<Core::FileCache> fileCache,
-            std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger);
+            std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
+            int64_t cacheSize = Configuration::PageBlob::DefaultBufferSize);
         ~ReadWriteFileImpl();
         ReadWriteFileImpl(const ReadWriteFileImpl&) = delete;
         ReadWriteFileImpl& operator=(const ReadWriteFileImpl&) = delete;
@@ -49,5 +65,8 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
 
     private:
         void Expand();
+        CachedPage& GetPageForWrite(int64_t pageIndex);
+        void EvictCleanPages(int64_t targetSize);
+        int64_t ReadFromBlob(int64_t offset, int64_t length, char* buffer) const;
     };
 }
@@ -11,8 +11,15 @@
 #include <string>
 #include <string_view>
 #include <memory>
+#include <mutex>
+#include <vector>
 namespace AVEVA::RocksDB::Plugin::Azure::Impl
 {
+    /// <summary>
+    /// Reads a blob without fetching its properties on open. The first read downloads the data together with
+    /// the blob's size and ETag, and later reads are made against that ETag. A blob that doesn't exist makes the
+    /// first read throw a std::system_error with std::errc::no_such_file_or_directory.
+    /// </summary>
     class ReadableFileImpl
     {
         std::string m_name;
@@ -21,6 +28,10 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         int64_t m_offset;
         mutable int64_t m_size;
         mutable ::Azure::ETag m_etag;
+        std::unique_ptr<std::once_flag> m_firstRead;
+        int64_t m_readahead;
+        std::vector<char> m_readaheadBuffer;
+        int64_t m_readaheadOffset;
         std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> m_logger;
 
         int64_t DownloadWithRetry(const int64_t offset, const int64_t bytesToRead, char* buffer) const;
@@ -29,9 +40,10 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         ReadableFileImpl(std::string_view name,
             std::shared_ptr<Core::BlobClient> blobClient,
             std::shared_ptr<Core::FileCache> fileCache,
-            std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger);
+            std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
+            int64_t readahead = 0);
 
-        // NOTE: Increments m_offset
+        // NOTE: Increments m_offset. Downloads at least the readahead size and serves the following reads from it.
         [[nodiscard]] int64_t SequentialRead(int64_t bytesToRead, char* buffer);
 
         // NOTE: Random so doesn't affect the sequential reads
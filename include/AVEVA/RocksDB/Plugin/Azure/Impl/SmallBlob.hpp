@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include "AVEVA/RocksDB/Plugin/Core/BlobClient.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/SmallFileCache.hpp"
+#include <azure/storage/blobs/block_blob_client.hpp>
+#include <azure/core/etag.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    /// <summary>
+    /// Holds a small file entirely in memory. Uploaded pages are only copied into the buffer and SetSize writes
+    /// the whole file with a single Put Blob, as a block blob whose length is the file size. Reads are served from
+    /// the buffer, and every version written or read is kept in the small file cache.
+    /// </summary>
+    class SmallBlob final : public Core::BlobClient
+    {
+        ::Azure::Storage::Blobs::BlockBlobClient m_client;
+        std::shared_ptr<SmallFileCache> m_cache;
+        std::string m_cacheKey;
+        std::mutex m_mutex;
+        std::vector<char> m_data;
+        ::Azure::ETag m_etag;
+        bool m_dirty;
+
+    public:
+        /// <summary>
+        /// Opens a new, empty file. Nothing is written to blob storage until the first SetSize.
+        /// </summary>
+        SmallBlob(::Azure::Storage::Blobs::BlockBlobClient client, std::shared_ptr<SmallFileCache> cache, std::string cacheKey);
+
+        /// <summary>
+        /// Opens the existing file whose contents were already downloaded or found in the cache.
+        /// </summary>
+        SmallBlob(::Azure::Storage::Blobs::BlockBlobClient client, std::shared_ptr<SmallFileCache> cache, std::string cacheKey, SmallFileCache::Entry contents);
+
+        virtual int64_t GetSize() override;
+        virtual void SetSize(int64_t size) override;
+        virtual int64_t GetCapacity() override;
+        virtual void SetCapacity(int64_t capacity) override;
+        virtual void DownloadTo(const std::string& path, int64_t offset, int64_t length) override;
+        virtual int64_t DownloadTo(std::span<char> buffer, int64_t blobOffset, int64_t readLength) override;
+        virtual int64_t Download(std::span<char> buffer, int64_t blobOffset, int64_t readLength, const ::Azure::ETag& ifMatch) override;
+        virtual void UploadPages(const std::span<char> buffer, int64_t blobOffset) override;
+        virtual ::Azure::ETag GetEtag() override;
+
+    private:
+        [[nodiscard]] int64_t Copy(std::span<char> buffer, int64_t offset, int64_t length);
+    };
+}
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/Configuration.hpp"
+#include <azure/core/etag.hpp>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    /// <summary>
+    /// Keeps the contents of the last few small files written or read by this process, together with the ETag of
+    /// the blob they came from, so readers can revalidate an entry instead of downloading the file again.
+    /// </summary>
+    class SmallFileCache
+    {
+    public:
+        struct Entry
+        {
+            std::vector<char> Contents;
+            ::Azure::ETag ETag;
+        };
+
+    private:
+        struct Slot
+        {
+            Entry Value;
+            uint64_t LastUsed;
+        };
+
+        size_t m_maxFiles;
+        std::mutex m_mutex;
+        std::map<std::string, Slot, std::less<>> m_files;
+        uint64_t m_clock;
+
+    public:
+        explicit SmallFileCache(size_t maxFiles = Configuration::SmallFileCacheCount);
+
+        [[nodiscard]] std::optional<Entry> Find(std::string_view name);
+
+        /// <summary>
+        /// Adds or replaces the entry for <paramref name="name"/>, evicting the least recently used file when full.
+        /// </summary>
+        void Put(std::string_view name, Entry entry);
+        void Remove(std::string_view name);
+
+        /// <summary>
+        /// Removes every entry whose name starts with <paramref name="prefix"/>.
+        /// </summary>
+        void RemovePrefix(std::string_view prefix);
+    };
+}
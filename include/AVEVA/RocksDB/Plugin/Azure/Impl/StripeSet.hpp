@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include <azure/storage/blobs/blob_container_client.hpp>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    /// <summary>
+    /// Containers a database's SST and blob files are spread over, the first being the database's own container.
+    /// A file is placed by rendezvous hashing of its file number over the stripes that accept new files, so adding
+    /// or retiring a stripe only moves the files that belong on it. Where existing files actually are is learnt
+    /// from listings and creations, since files written under an earlier stripe set stay where they were put.
+    /// </summary>
+    class StripeSet
+    {
+    public:
+        struct Stripe
+        {
+            /// <summary>
+            /// Identifies the stripe in the placement hash, so it must stay the same for as long as files are on it.
+            /// </summary>
+            std::string Name;
+            ::Azure::Storage::Blobs::BlobContainerClient Container;
+            bool AcceptsNewFiles;
+        };
+
+    private:
+        std::vector<Stripe> m_stripes;
+        std::vector<uint64_t> m_seeds;
+        mutable std::mutex m_mutex;
+        std::map<std::string, size_t, std::less<>> m_locations;
+
+    public:
+        /// <summary>
+        /// The primary stripe, the first of <paramref name="stripes"/>, always accepts new files.
+        /// </summary>
+        explicit StripeSet(std::vector<Stripe> stripes);
+
+        /// <summary>
+        /// Returns true for the files spread over the stripes. Everything else stays in the primary container.
+        /// </summary>
+        [[nodiscard]] static bool IsStriped(std::string_view realPath);
+
+        /// <summary>
+        /// Returns the stripe a new file named <paramref name="realPath"/> belongs on.
+        /// </summary>
+        [[nodiscard]] size_t Place(std::string_view realPath) const;
+
+        /// <summary>
+        /// Returns the stripe the file is known to be on, or the one it belongs on if nothing is known about it.
+        /// </summary>
+        [[nodiscard]] size_t Locate(std::string_view realPath) const;
+        [[nodiscard]] std::optional<size_t> Find(std::string_view realPath) const;
+        void Record(std::string_view realPath, size_t stripe);
+
+        /// <summary>
+        /// Records a file found on <paramref name="stripe"/> by a listing. A file listed on two stripes is left over
+        /// from an interrupted move, and the copy on the stripe it was moving to may be incomplete, so the other is kept.
+        /// </summary>
+        void RecordListed(std::string_view realPath, size_t stripe);
+        void Forget(std::string_view realPath);
+
+        /// <summary>
+        /// Forgets every file whose name starts with <paramref name="prefix"/>.
+        /// </summary>
+        void ForgetPrefix(std::string_view prefix);
+
+        [[nodiscard]] const Stripe& Get(size_t stripe) const;
+        [[nodiscard]] size_t Size() const noexcept;
+    };
+}
@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include "AVEVA/RocksDB/Plugin/Core/ContainerClient.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/StripeSet.hpp"
+
+#include <memory>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    /// <summary>
+    /// Opens each blob in the stripe it is on, for the file cache's downloads.
+    /// </summary>
+    class StripedContainerClient final : public Core::ContainerClient
+    {
+        std::shared_ptr<StripeSet> m_stripes;
+
+    public:
+        StripedContainerClient(std::shared_ptr<StripeSet> stripes);
+        virtual std::unique_ptr<Core::BlobClient> GetBlobClient(const std::string& path) override;
+    };
+}
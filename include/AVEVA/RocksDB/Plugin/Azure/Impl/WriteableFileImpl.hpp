@@ -3,21 +3,46 @@
 
 #pragma once
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/Configuration.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/FilesystemOptions.hpp"
 #include "AVEVA/RocksDB/Plugin/Core/FileCache.hpp"
 
 #include <azure/storage/blobs/page_blob_client.hpp>
 #include <boost/log/trivial.hpp>
 
 #include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <vector>
 namespace AVEVA::RocksDB::Plugin::Azure::Impl
 {
     class WriteableFileImpl
     {
+        struct PendingUpload
+        {
+            std::vector<char> Buffer;
+            std::future<void> Result;
+        };
+
+        struct Synchronization
+        {
+            std::mutex Syncs;   // Held by the sync uploading for a group; the rest of the group queues behind it.
+            std::mutex State;   // Buffer, sizes and background uploads.
+            std::mutex Uploads; // Keeps overlapping Put Page requests in the order their data was buffered.
+            uint64_t SyncRequests = 0;
+            uint64_t SyncsCompleted = 0;
+            std::vector<char> Pages;
+        };
+
         std::string m_name;
         int64_t m_bufferSize;
+        int64_t m_bufferCount;
+        int64_t m_uploadConcurrency;
+        int64_t m_preallocationBlockSize;
+        DurabilityMode m_durability;
         std::shared_ptr<Core::BlobClient> m_blobClient;
         std::shared_ptr<Core::FileCache> m_fileCache;
         std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> m_logger;
@@ -28,15 +53,45 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         int64_t m_bufferOffset;
         bool m_closed;
         bool m_flushed;
+        bool m_sizeTrailer;
+        bool m_appendOnly;
 
         std::vector<char> m_buffer;
+        std::vector<std::vector<char>> m_freeBuffers;
+        std::vector<PendingUpload> m_pendingUploads;
+        std::exception_ptr m_uploadError;
+        std::unique_ptr<Synchronization> m_sync;
+        std::function<void(int64_t)> m_sizeListener;
 
     public:
+        /// <summary>
+        /// Size and capacity of a blob the caller already knows, such as one it just created, so they aren't fetched again.
+        /// </summary>
+        struct BlobState
+        {
+            int64_t Size;
+            int64_t Capacity;
+        };
+
+        WriteableFileImpl(std::string_view name,
+            std::shared_ptr<Core::BlobClient> blobClient,
+            std::shared_ptr<Core::FileCache> fileCache,
+            std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
+            int64_t bufferSize = Configuration::PageBlob::DefaultBufferSize,
+            int64_t bufferCount = 1,
+            int64_t uploadConcurrency = Configuration::PageBlob::DefaultUploadConcurrency,
+            bool sizeTrailer = false,
+            DurabilityMode durability = DurabilityMode::Flush);
         WriteableFileImpl(std::string_view name,
             std::shared_ptr<Core::BlobClient> blobClient,
+            BlobState state,
             std::shared_ptr<Core::FileCache> fileCache,
             std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
-            int64_t bufferSize = Configuration::PageBlob::DefaultBufferSize);
+            int64_t bufferSize = Configuration::PageBlob::DefaultBufferSize,
+            int64_t bufferCount = 1,
+            int64_t uploadConcurrency = Configuration::PageBlob::DefaultUploadConcurrency,
+            bool sizeTrailer = false,
+            DurabilityMode durability = DurabilityMode::Flush);
         ~WriteableFileImpl();
         WriteableFileImpl(const WriteableFileImpl&) = delete;
         WriteableFileImpl& operator=(const WriteableFileImpl&) = delete;
@@ -48,10 +103,36 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         void Flush();
         void Sync();
         void Truncate(int64_t size);
+
+        /// <summary>
+        /// Grows the blob to hold at least <paramref name="capacity"/> bytes now, so flushes up to that point don't resize it.
+        /// </summary>
+        void Reserve(int64_t capacity);
+
+        /// <summary>
+        /// Grow the blob in multiples of <paramref name="blockSize"/> instead of doubling when a flush runs past its capacity.
+        /// </summary>
+        void SetPreallocationBlockSize(int64_t blockSize);
+
+        /// <summary>
+        /// Calls <paramref name="listener"/> with the size stored in blob storage whenever a sync or truncate changes it.
+        /// </summary>
+        void SetSizeListener(std::function<void(int64_t)> listener);
         [[nodiscard]] int64_t GetFileSize() const noexcept;
         [[nodiscard]] int64_t GetUniqueId(char* id, int64_t maxIdSize) const noexcept;
 
     private:
-        void Expand();
+        void Expand(int64_t requiredCapacity);
+        void FlushBuffer();
+        int64_t UploadDirect(std::span<const char> data);
+        int64_t ReserveFlush();
+        void UploadBuffer(std::span<char> buffer, int64_t bytesToWrite, int64_t blobOffset, int64_t size);
+        void SyncToBlob();
+        void SyncGroup();
+        void UploadFullPagesAsync();
+        [[nodiscard]] std::vector<char> AcquireBuffer();
+        void WaitForOldestUpload();
+        void WaitForUploads();
+        void ThrowIfUploadFailed() const;
     };
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/Configuration.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/FilesystemOptions.hpp"
 #include "AVEVA/RocksDB/Plugin/Azure/Models/ServicePrincipalStorageInfo.hpp"
 #include "AVEVA/RocksDB/Plugin/Azure/Models/ChainedCredentialInfo.hpp"
 
@@ -25,7 +26,8 @@ namespace AVEVA::RocksDB::Plugin::Azure
             int64_t dataFileBufferSize = Impl::Configuration::PageBlob::DefaultBufferSize,
             int64_t dataFileInitialSize = Impl::Configuration::PageBlob::DefaultSize,
             std::optional<std::string_view> cachePath = {},
-            size_t maxCacheSize = Impl::Configuration::MaxCacheSize);
+            size_t maxCacheSize = Impl::Configuration::MaxCacheSize,
+            Impl::FilesystemOptions options = {});
         static rocksdb::Status Register(rocksdb::ConfigOptions& configOptions,
             rocksdb::Env** env,
             std::shared_ptr<rocksdb::Env>* guard,
@@ -35,6 +37,7 @@ namespace AVEVA::RocksDB::Plugin::Azure
             int64_t dataFileBufferSize = Impl::Configuration::PageBlob::DefaultBufferSize,
             int64_t dataFileInitialSize = Impl::Configuration::PageBlob::DefaultSize,
             std::optional<std::string_view> cachePath = {},
-            size_t maxCacheSize = Impl::Configuration::MaxCacheSize);
+            size_t maxCacheSize = Impl::Configuration::MaxCacheSize,
+            Impl::FilesystemOptions options = {});
     };
 }
@@ -21,5 +21,7 @@ namespace AVEVA::RocksDB::Plugin::Azure
         virtual rocksdb::IOStatus Flush(const rocksdb::IOOptions& options, rocksdb::IODebugContext* dbg) override;
         virtual rocksdb::IOStatus Sync(const rocksdb::IOOptions& options, rocksdb::IODebugContext* dbg) override;
         virtual uint64_t GetFileSize(const rocksdb::IOOptions&, rocksdb::IODebugContext*) override;
+        virtual rocksdb::IOStatus Allocate(uint64_t offset, uint64_t len, const rocksdb::IOOptions& options, rocksdb::IODebugContext* dbg) override;
+        virtual void SetPreallocationBlockSize(size_t size) override;
     };
 }
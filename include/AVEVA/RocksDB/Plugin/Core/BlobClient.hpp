@@ -3,14 +3,25 @@
 
 #pragma once
 #include <azure/core/etag.hpp>
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <span>
+#include <stdexcept>
 namespace AVEVA::RocksDB::Plugin::Core
 {
     class BlobClient
     {
     public:
+        /// <summary>
+        /// Size and ETag of the blob a read was served from.
+        /// </summary>
+        struct BlobInfo
+        {
+            int64_t Size;
+            ::Azure::ETag ETag;
+        };
+
         virtual ~BlobClient() = default;
 
         /// <summary>
@@ -61,6 +72,25 @@ namespace AVEVA::RocksDB::Plugin::Core
         /// <param name="blobOffset">The offset within the blob where the data should be uploaded.</param>
         virtual void UploadPages(const std::span<char> buffer, int64_t blobOffset) = 0;
 
+        /// <summary>
+        /// Returns true if data can only be added to the end of the blob with <see cref="AppendBlock"/> instead of
+        /// being written in pages. The blob is then exactly as long as the data appended to it.
+        /// </summary>
+        virtual bool IsAppendOnly() const
+        {
+            return false;
+        }
+
+        /// <summary>
+        /// Appends data to the end of an append only blob.
+        /// </summary>
+        /// <param name="data">The bytes to append, of any length.</param>
+        /// <param name="blobOffset">The current length of the blob, where the data is expected to land.</param>
+        virtual void AppendBlock(std::span<const char> /*data*/, int64_t /*blobOffset*/)
+        {
+            throw std::logic_error("Blob does not support appends");
+        }
+
         /// <summary>
         /// Retrieve the current ETag of the blob.
         /// </summary>
@@ -76,5 +106,21 @@ namespace AVEVA::RocksDB::Plugin::Core
         /// <param name="ifMatch">The ETag to check against.</param>
         /// <returns>The number of bytes actually downloaded.</returns>
         virtual int64_t Download(std::span<char> buffer, int64_t blobOffset, int64_t readLength, const ::Azure::ETag& ifMatch) = 0;
+
+        /// <summary>
+        /// Downloads a portion of the blob as it is now and describes the blob the data came from, so a reader that
+        /// hasn't fetched the blob's properties learns them from its first read.
+        /// </summary>
+        /// <param name="buffer">A span of bytes where the downloaded data will be stored.</param>
+        /// <param name="blobOffset">The starting position (in bytes) in the blob from which to begin downloading.</param>
+        /// <param name="readLength">The number of bytes to download from the offset.</param>
+        /// <param name="info">Receives the size and ETag of the blob.</param>
+        /// <returns>The number of bytes downloaded that are part of the file.</returns>
+        virtual int64_t DownloadLatest(std::span<char> buffer, int64_t blobOffset, int64_t readLength, BlobInfo& info)
+        {
+            info = BlobInfo{ GetSize(), GetEtag() };
+            const auto toRead = std::min(readLength, info.Size - blobOffset);
+            return toRead > 0 ? Download(buffer.first(static_cast<size_t>(toRead)), blobOffset, toRead, info.ETag) : 0;
+        }
     };
 }
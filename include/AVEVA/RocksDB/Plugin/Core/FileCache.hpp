@@ -3,13 +3,16 @@
 
 #pragma once
 #include "AVEVA/RocksDB/Plugin/Core/FileCacheEntry.hpp"
+#include "AVEVA/RocksDB/Plugin/Core/FileCacheMetrics.hpp"
 #include "AVEVA/RocksDB/Plugin/Core/ContainerClient.hpp"
 #include "AVEVA/RocksDB/Plugin/Core/Filesystem.hpp"
+#include "AVEVA/RocksDB/Plugin/Core/SharedFileCacheIndex.hpp"
 #include "AVEVA/RocksDB/Plugin/Core/Util.hpp"
 
 #include <boost/intrusive/list.hpp>
 #include <boost/log/trivial.hpp>
 
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
 #include <memory>
@@ -17,18 +20,34 @@
 #include <optional>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 #include <queue>
+#include <span>
 #include <condition_variable>
 #include <stop_token>
 namespace AVEVA::RocksDB::Plugin::Core
 {
     class FileCache
     {
+    public:
+        struct EntryInfo
+        {
+            std::string FilePath;
+            FileCacheEntry::State State;
+            int64_t Size;
+            uint64_t AccessCount;
+            std::chrono::time_point<std::chrono::system_clock> LastAccessTime;
+        };
+
+    private:
         std::filesystem::path m_cachePath;
         int64_t m_maxSize;
         std::shared_ptr<ContainerClient> m_containerClient;
         std::shared_ptr<Filesystem> m_filesystem;
         std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> m_logger;
+        std::shared_ptr<SharedFileCacheIndex> m_sharedIndex;
+        std::string m_keyPrefix;
+        FileCacheMetrics m_metrics;
 
         std::mutex m_mutex;
         std::stop_source m_stopSource;
@@ -42,7 +61,9 @@ namespace AVEVA::RocksDB::Plugin::Core
             int64_t maxCacheSize,
             std::shared_ptr<ContainerClient> containerClient,
             std::shared_ptr<Filesystem> filesystem,
-            std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger);
+            std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
+            std::shared_ptr<SharedFileCacheIndex> sharedIndex = nullptr,
+            std::string keyPrefix = {});
         ~FileCache();
         FileCache(const FileCache&) = delete;
         FileCache& operator=(const FileCache&) = delete;
@@ -55,11 +76,35 @@ namespace AVEVA::RocksDB::Plugin::Core
         void RemoveFile(std::string_view filePath);
         [[nodiscard]] int64_t CacheSize();
         void SetCacheSize(int64_t size);
+
+        /// <summary>
+        /// Returns the cache counters. The counters are updated without taking the cache lock,
+        /// so the values are not guaranteed to be consistent with each other.
+        /// </summary>
+        [[nodiscard]] FileCacheMetrics::Snapshot GetMetrics();
+
+        /// <summary>
+        /// Adds up the metrics of several caches. Caches sharing an index each report the index's used and
+        /// maximum bytes, so those are counted once per index.
+        /// </summary>
+        [[nodiscard]] static FileCacheMetrics::Snapshot CombineMetrics(std::span<FileCache* const> caches);
+
+        /// <summary>
+        /// Returns every entry in the cache, most recently used first.
+        /// </summary>
+        [[nodiscard]] std::vector<EntryInfo> GetEntries();
     private:
         void BackgroundDownload(std::stop_token stopToken);
         void EntryAccessedUnsafe(FileCacheEntry& file);
         bool EvictAtLeast(int64_t bytes);
         void RemoveFileUnsafe(std::string_view filePath);
+        void ForgetFileUnsafe(std::string_view filePath);
+        bool ClaimSharedDownloadUnsafe(FileCacheEntry& file);
+        int64_t ReadCachedFile(std::string_view filePath, int64_t offset, int64_t bytesToRead, char* buffer);
+        void RecordMiss(int64_t bytesToRead, bool queued) noexcept;
+        static uint64_t ElapsedMicros(std::chrono::steady_clock::time_point start) noexcept;
+        std::string SharedKey(std::string_view filePath) const;
+        std::filesystem::path CachedFilePath(std::string_view filePath) const;
         int64_t GetCurrentSizeUnsafe() const noexcept;
     };
 }
@@ -23,6 +23,8 @@ namespace AVEVA::RocksDB::Plugin::Core
         State m_state;
         std::string m_filePath;
         int64_t m_size;
+        uint64_t m_generation;
+        uint64_t m_accessCount;
         std::chrono::time_point<std::chrono::system_clock> m_lastAccessTime;
 
     public:
@@ -32,9 +34,13 @@ namespace AVEVA::RocksDB::Plugin::Core
         int64_t GetSize() const noexcept;
         const std::string& GetFilePath() const noexcept;
         State GetState() const noexcept;
+        uint64_t GetGeneration() const noexcept;
+        uint64_t GetAccessCount() const noexcept;
+        std::chrono::time_point<std::chrono::system_clock> GetLastAccessTime() const noexcept;
 
         void SetSize(int64_t size) noexcept;
         void SetState(State state) noexcept;
+        void SetGeneration(uint64_t generation) noexcept;
 
         void unlink();
         bool is_linked();
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+namespace AVEVA::RocksDB::Plugin::Core
+{
+    /// <summary>
+    /// A lock-free histogram with power of two buckets. Bucket 0 holds zero and bucket i holds values in [2^(i-1), 2^i).
+    /// </summary>
+    class LatencyHistogram
+    {
+    public:
+        static const constexpr size_t BucketCount = 40;
+
+        struct Snapshot
+        {
+            uint64_t Count = 0;
+            uint64_t Sum = 0;
+            uint64_t Max = 0;
+            std::array<uint64_t, BucketCount> Buckets{};
+
+            [[nodiscard]] double Average() const noexcept;
+            [[nodiscard]] double Percentile(double percentile) const noexcept;
+            Snapshot& operator+=(const Snapshot& other) noexcept;
+        };
+
+    private:
+        std::array<std::atomic<uint64_t>, BucketCount> m_buckets{};
+        std::atomic<uint64_t> m_count{ 0 };
+        std::atomic<uint64_t> m_sum{ 0 };
+        std::atomic<uint64_t> m_max{ 0 };
+
+    public:
+        void Record(uint64_t value) noexcept;
+        [[nodiscard]] Snapshot GetSnapshot() const noexcept;
+    };
+
+    class FileCacheMetrics
+    {
+    public:
+        enum class Ticker
+        {
+            Hits,
+            Misses,
+            BytesRead,
+            BytesMissed,
+            DownloadsQueued,
+            DownloadsCompleted,
+            DownloadsFailed,
+            DownloadsSkipped,
+            BytesDownloaded,
+            Evictions,
+            EvictionsUnused,
+            BytesEvicted,
+            Invalidations,
+            Count,
+        };
+
+        enum class Histogram
+        {
+            DownloadMicros,
+            ReadMicros,
+            Count,
+        };
+
+        static const constexpr size_t TickerCount = static_cast<size_t>(Ticker::Count);
+        static const constexpr size_t HistogramCount = static_cast<size_t>(Histogram::Count);
+
+        struct Snapshot
+        {
+            std::array<uint64_t, TickerCount> Tickers{};
+            std::array<LatencyHistogram::Snapshot, HistogramCount> Histograms{};
+            int64_t QueueDepth = 0;
+            int64_t UsedBytes = 0;
+            int64_t MaxBytes = 0;
+
+            [[nodiscard]] uint64_t Get(Ticker ticker) const noexcept;
+            [[nodiscard]] const LatencyHistogram::Snapshot& Get(Histogram histogram) const noexcept;
+            Snapshot& operator+=(const Snapshot& other) noexcept;
+        };
+
+    private:
+        std::array<std::atomic<uint64_t>, TickerCount> m_tickers{};
+        std::array<LatencyHistogram, HistogramCount> m_histograms{};
+        std::atomic<int64_t> m_queueDepth{ 0 };
+
+    public:
+        void Record(Ticker ticker, uint64_t count = 1) noexcept;
+        void Record(Histogram histogram, uint64_t value) noexcept;
+        void AdjustQueueDepth(int64_t delta) noexcept;
+        [[nodiscard]] Snapshot GetSnapshot() const noexcept;
+
+        [[nodiscard]] static std::string_view Name(Ticker ticker) noexcept;
+        [[nodiscard]] static std::string_view Name(Histogram histogram) noexcept;
+    };
+}
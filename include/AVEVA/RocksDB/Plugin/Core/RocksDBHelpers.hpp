@@ -3,7 +3,6 @@
 
 #pragma once
 #include <string_view>
-#include <string>
 namespace AVEVA::RocksDB::Plugin::Core
 {
     struct RocksDBHelpers
@@ -13,8 +12,13 @@ namespace AVEVA::RocksDB::Plugin::Core
             static constexpr std::string_view sst = ".sst";
             static constexpr std::string_view ldb = ".ldb";
             static constexpr std::string_view log = ".log";
+            static constexpr std::string_view dbtmp = ".dbtmp";
+            static constexpr std::string_view blob = ".blob";
         };
 
+        /// <summary>
+        /// Kind of file named by RocksDB's file name grammar. Names outside the grammar, such as directories, are Directory.
+        /// </summary>
         enum class FileClass
         {
             Directory = 0,
@@ -22,11 +26,34 @@ namespace AVEVA::RocksDB::Plugin::Core
             WAL = 2, // log file
             Manifest = 3, // also log file
             Identity = 4,
+            Current = 5,
+            Options = 6,
+            Lock = 7,
+            InfoLog = 8, // LOG and LOG.old.*
+            Blob = 9, // BlobDB value file
+            Temp = 10, // *.dbtmp, written and then renamed into place
         };
 
         [[nodiscard]] static bool IsManifestFile(std::string_view pathname);
         [[nodiscard]] static bool IsIdentityFile(std::string_view pathname);
+        [[nodiscard]] static bool IsCurrentFile(std::string_view pathname);
+        [[nodiscard]] static bool IsOptionsFile(std::string_view pathname);
+
+        /// <summary>
+        /// Returns true for the small metadata files RocksDB writes in one go: CURRENT, OPTIONS-*, IDENTITY and *.dbtmp.
+        /// </summary>
+        [[nodiscard]] static bool IsSmallFile(std::string_view pathname);
+        [[nodiscard]] static bool IsSmallFile(FileClass fileType);
         [[nodiscard]] static bool IsLogFile(const FileClass fileType);
+
+        /// <summary>
+        /// Returns true for files that never change once written, so a copy of them can't go stale.
+        /// </summary>
+        [[nodiscard]] static bool IsImmutableFile(FileClass fileType);
+
+        /// <summary>
+        /// Classifies the last component of <paramref name="pathname"/> without allocating.
+        /// </summary>
         [[nodiscard]] static FileClass GetFileType(std::string_view pathname);
     };
 }
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#pragma once
+#include "AVEVA/RocksDB/Plugin/Core/Filesystem.hpp"
+#include "AVEVA/RocksDB/Plugin/Core/Util.hpp"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
+#include <boost/log/trivial.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+namespace AVEVA::RocksDB::Plugin::Core
+{
+    /// <summary>
+    /// An on-disk index that lets several processes share one cache directory and one byte budget.
+    /// The index lives in a memory mapped file inside the cache directory and is guarded by a
+    /// cross-process file lock. Every attached process owns a slot whose lock file is held for the
+    /// lifetime of the process, which lets survivors detect crashed processes and reclaim their
+    /// reference counts and half-finished downloads.
+    /// </summary>
+    class SharedFileCacheIndex
+    {
+    public:
+        static const constexpr uint32_t MaxProcesses = 64;
+        static const constexpr uint32_t MaxEntries = 8192;
+        static const constexpr size_t MaxKeyLength = 255;
+
+        enum class DownloadClaim
+        {
+            /// <summary>The caller owns the download and the space has been reserved.</summary>
+            Claimed,
+            /// <summary>Another process already finished downloading the file.</summary>
+            Cached,
+            /// <summary>Another process is downloading the file or readers still hold a stale copy.</summary>
+            Busy,
+            /// <summary>The file does not fit in the shared budget.</summary>
+            NoSpace,
+        };
+
+        struct CachedFile
+        {
+            int64_t Size;
+            uint64_t Generation;
+        };
+
+    private:
+        struct Header;
+        struct Entry;
+
+        std::filesystem::path m_cachePath;
+        std::filesystem::path m_dataPath;
+        std::shared_ptr<Filesystem> m_filesystem;
+        std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> m_logger;
+        std::mutex m_mutex;
+        boost::interprocess::file_lock m_indexLock;
+        boost::interprocess::file_lock m_processLock;
+        boost::interprocess::file_mapping m_mapping;
+        boost::interprocess::mapped_region m_region;
+        uint32_t m_processSlot;
+        std::unordered_map<std::string, int64_t, StringHash, StringEqual> m_pins;
+
+    public:
+        SharedFileCacheIndex(std::filesystem::path cachePath,
+            int64_t maxCacheSize,
+            std::shared_ptr<Filesystem> filesystem,
+            std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger);
+        ~SharedFileCacheIndex();
+        SharedFileCacheIndex(const SharedFileCacheIndex&) = delete;
+        SharedFileCacheIndex& operator=(const SharedFileCacheIndex&) = delete;
+        SharedFileCacheIndex(SharedFileCacheIndex&&) = delete;
+        SharedFileCacheIndex& operator=(SharedFileCacheIndex&&) = delete;
+
+        /// <summary>
+        /// Returns the index for a cache directory, attaching to it if this process has not already done so.
+        /// All file caches in a process that point at the same directory share a single index instance.
+        /// </summary>
+        [[nodiscard]] static std::shared_ptr<SharedFileCacheIndex> Open(const std::filesystem::path& cachePath,
+            int64_t maxCacheSize,
+            std::shared_ptr<Filesystem> filesystem,
+            std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger);
+
+        /// <summary>
+        /// Looks up a fully downloaded file.
+        /// </summary>
+        [[nodiscard]] std::optional<CachedFile> Find(std::string_view key);
+
+        /// <summary>
+        /// Takes a reference on a downloaded file so that no process evicts it while it is being read.
+        /// Fails if the file was evicted, invalidated or replaced since <paramref name="generation"/> was observed.
+        /// </summary>
+        [[nodiscard]] bool Pin(std::string_view key, uint64_t generation);
+        void Unpin(std::string_view key);
+
+        /// <summary>
+        /// Claims the right to download a file and reserves its size in the shared budget,
+        /// evicting the least recently used unreferenced files of any process if needed.
+        /// </summary>
+        [[nodiscard]] DownloadClaim BeginDownload(std::string_view key, int64_t size, CachedFile& existing);
+
+        /// <summary>
+        /// Publishes a claimed download. Returns the generation readers must pin, or nothing if
+        /// the file was invalidated while it was being downloaded.
+        /// </summary>
+        [[nodiscard]] std::optional<uint64_t> CompleteDownload(std::string_view key);
+        void AbortDownload(std::string_view key);
+
+        /// <summary>
+        /// Drops a file from the shared cache. The file is deleted immediately if nobody references it,
+        /// otherwise when the last reference is released.
+        /// </summary>
+        void Invalidate(std::string_view key);
+
+        [[nodiscard]] int64_t UsedBytes();
+        [[nodiscard]] int64_t MaxSize();
+        void SetMaxSize(int64_t size);
+        [[nodiscard]] uint32_t ProcessSlot() const noexcept;
+
+        /// <summary>
+        /// Directory the shared files are kept in, named by their keys. Nothing else under the cache path is touched.
+        /// </summary>
+        [[nodiscard]] const std::filesystem::path& DataPath() const noexcept;
+
+    private:
+        Header& GetHeader() noexcept;
+        Entry* Entries() noexcept;
+        Entry* FindUnsafe(std::string_view key, uint64_t hash) noexcept;
+        Entry* InsertUnsafe(std::string_view key, uint64_t hash) noexcept;
+        void EraseUnsafe(Entry& entry);
+        bool EvictAtLeastUnsafe(int64_t bytes);
+        bool IsProcessAlive(uint32_t slot);
+        void ReapProcessUnsafe(uint32_t slot);
+        void ReapDeadProcessesUnsafe();
+        void InitializeUnsafe(int64_t maxCacheSize);
+        uint32_t ClaimProcessSlot();
+        std::filesystem::path ProcessLockPath(uint32_t slot) const;
+    };
+}
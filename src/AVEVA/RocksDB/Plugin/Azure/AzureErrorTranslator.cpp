@@ -27,4 +27,14 @@ namespace AVEVA::RocksDB::Plugin::Azure
             return IOStatus::IOError(context);
         }
     }
+
+    rocksdb::IOStatus AzureErrorTranslator::IOStatusFromError(const std::system_error& error)
+    {
+        if (error.code() == std::errc::no_such_file_or_directory)
+        {
+            return rocksdb::IOStatus::PathNotFound(error.what());
+        }
+
+        return rocksdb::IOStatus::IOError(error.what());
+    }
 }
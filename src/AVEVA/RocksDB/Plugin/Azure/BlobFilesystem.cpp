@@ -140,14 +140,14 @@ namespace AVEVA::RocksDB::Plugin::Azure
     }
 
     rocksdb::IOStatus BlobFilesystem::ReuseWritableFile(const std::string& fname,
-        const std::string&,
+        const std::string& old_fname,
         const rocksdb::FileOptions&,
         std::unique_ptr<rocksdb::FSWritableFile>* r,
         rocksdb::IODebugContext*)
     {
         try
         {
-            *r = std::unique_ptr<rocksdb::FSWritableFile>(new WriteableFile(m_filesystem->ReuseWritableFile(fname), m_logger));
+            *r = std::unique_ptr<rocksdb::FSWritableFile>(new WriteableFile(m_filesystem->ReuseWritableFile(fname, old_fname), m_logger));
             return rocksdb::IOStatus::OK();
         }
         catch (const ::Azure::Core::RequestFailedException& ex)
@@ -671,4 +671,19 @@ namespace AVEVA::RocksDB::Plugin::Azure
     {
         supported_ops = rocksdb::FSSupportedOps::kAsyncIO;
     }
+
+    Core::FileCacheMetrics::Snapshot BlobFilesystem::GetFileCacheMetrics() const
+    {
+        return m_filesystem->GetFileCacheMetrics();
+    }
+
+    std::vector<Core::FileCache::EntryInfo> BlobFilesystem::GetFileCacheEntries() const
+    {
+        return m_filesystem->GetFileCacheEntries();
+    }
+
+    size_t BlobFilesystem::RebalanceStripes(const std::string& path)
+    {
+        return m_filesystem->RebalanceStripes(path);
+    }
 }
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/FileCacheStatistics.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Plugin.hpp"
+
+#include <algorithm>
+#include <sstream>
+namespace AVEVA::RocksDB::Plugin::Azure
+{
+    using Core::FileCacheMetrics;
+
+    static std::string MetricName(const std::string_view name)
+    {
+        std::string result;
+        result.reserve(Plugin::Name.size() + 1 + name.size());
+        result.append(Plugin::Name).append(".").append(name);
+        return result;
+    }
+
+    static void AddGauges(const FileCacheMetrics::Snapshot& snapshot, std::map<std::string, uint64_t>& stats)
+    {
+        stats[MetricName("file.cache.queue.depth")] = static_cast<uint64_t>(std::max<int64_t>(snapshot.QueueDepth, 0));
+        stats[MetricName("file.cache.bytes.used")] = static_cast<uint64_t>(std::max<int64_t>(snapshot.UsedBytes, 0));
+        stats[MetricName("file.cache.bytes.capacity")] = static_cast<uint64_t>(std::max<int64_t>(snapshot.MaxBytes, 0));
+    }
+
+    FileCacheStatistics::FileCacheStatistics(std::shared_ptr<rocksdb::Statistics> statistics, std::shared_ptr<BlobFilesystem> filesystem)
+        : m_statistics(std::move(statistics)), m_filesystem(std::move(filesystem))
+    {
+        // RocksDB checks the level on the object it was given, not on the wrapped one.
+        set_stats_level(m_statistics->get_stats_level());
+    }
+
+    std::shared_ptr<rocksdb::Statistics> FileCacheStatistics::Create(const rocksdb::Env& env, std::shared_ptr<rocksdb::Statistics> statistics)
+    {
+        auto filesystem = std::dynamic_pointer_cast<BlobFilesystem>(env.GetFileSystem());
+        if (!filesystem || !statistics)
+        {
+            return statistics;
+        }
+
+        return std::make_shared<FileCacheStatistics>(std::move(statistics), std::move(filesystem));
+    }
+
+    const char* FileCacheStatistics::Name() const
+    {
+        return "FileCacheStatistics";
+    }
+
+    uint64_t FileCacheStatistics::getTickerCount(uint32_t tickerType) const
+    {
+        return m_statistics->getTickerCount(tickerType);
+    }
+
+    void FileCacheStatistics::histogramData(uint32_t type, rocksdb::HistogramData* const data) const
+    {
+        m_statistics->histogramData(type, data);
+    }
+
+    std::string FileCacheStatistics::getHistogramString(uint32_t type) const
+    {
+        return m_statistics->getHistogramString(type);
+    }
+
+    void FileCacheStatistics::recordTick(uint32_t tickerType, uint64_t count)
+    {
+        m_statistics->recordTick(tickerType, count);
+    }
+
+    void FileCacheStatistics::setTickerCount(uint32_t tickerType, uint64_t count)
+    {
+        m_statistics->setTickerCount(tickerType, count);
+    }
+
+    uint64_t FileCacheStatistics::getAndResetTickerCount(uint32_t tickerType)
+    {
+        return m_statistics->getAndResetTickerCount(tickerType);
+    }
+
+    void FileCacheStatistics::reportTimeToHistogram(uint32_t histogramType, uint64_t time)
+    {
+        m_statistics->reportTimeToHistogram(histogramType, time);
+    }
+
+    void FileCacheStatistics::recordInHistogram(uint32_t histogramType, uint64_t time)
+    {
+        m_statistics->recordInHistogram(histogramType, time);
+    }
+
+    rocksdb::Status FileCacheStatistics::Reset()
+    {
+        // NOTE: the file cache counters are cumulative for the lifetime of the filesystem and are not reset.
+        return m_statistics->Reset();
+    }
+
+    std::string FileCacheStatistics::ToString() const
+    {
+        const auto snapshot = m_filesystem->GetFileCacheMetrics();
+
+        // Use the same layout as the RocksDB dump so existing tooling can parse the file cache lines.
+        std::stringstream ss;
+        ss << m_statistics->ToString();
+        for (size_t i = 0; i < FileCacheMetrics::TickerCount; ++i)
+        {
+            const auto ticker = static_cast<FileCacheMetrics::Ticker>(i);
+            ss << MetricName(FileCacheMetrics::Name(ticker)) << " COUNT : " << snapshot.Get(ticker) << "\n";
+        }
+
+        std::map<std::string, uint64_t> gauges;
+        AddGauges(snapshot, gauges);
+        for (const auto& [name, value] : gauges)
+        {
+            ss << name << " COUNT : " << value << "\n";
+        }
+
+        ss << std::fixed;
+        for (size_t i = 0; i < FileCacheMetrics::HistogramCount; ++i)
+        {
+            const auto histogram = static_cast<FileCacheMetrics::Histogram>(i);
+            const auto& data = snapshot.Get(histogram);
+            ss << MetricName(FileCacheMetrics::Name(histogram))
+                << " P50 : " << data.Percentile(50.0)
+                << " P95 : " << data.Percentile(95.0)
+                << " P99 : " << data.Percentile(99.0)
+                << " P100 : " << static_cast<double>(data.Max)
+                << " COUNT : " << data.Count
+                << " SUM : " << data.Sum << "\n";
+        }
+
+        return ss.str();
+    }
+
+    bool FileCacheStatistics::getTickerMap(std::map<std::string, uint64_t>* stats) const
+    {
+        m_statistics->getTickerMap(stats);
+
+        const auto snapshot = m_filesystem->GetFileCacheMetrics();
+        for (size_t i = 0; i < FileCacheMetrics::TickerCount; ++i)
+        {
+            const auto ticker = static_cast<FileCacheMetrics::Ticker>(i);
+            (*stats)[MetricName(FileCacheMetrics::Name(ticker))] = snapshot.Get(ticker);
+        }
+
+        AddGauges(snapshot, *stats);
+        return true;
+    }
+
+    bool FileCacheStatistics::HistEnabledForType(uint32_t type) const
+    {
+        return m_statistics->HistEnabledForType(type);
+    }
+}
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/AppendBlob.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/Configuration.hpp"
+#include <azure/core/etag.hpp>
+#include <azure/core/context.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    AppendBlob::AppendBlob(::Azure::Storage::Blobs::AppendBlobClient client)
+        : m_client(std::move(client))
+    {
+    }
+
+    int64_t AppendBlob::GetSize()
+    {
+        return m_client.GetProperties().Value.BlobSize;
+    }
+
+    void AppendBlob::SetSize(const int64_t size)
+    {
+        // The length is the size. It only moves with appends, there's nothing to record.
+        if (size != GetSize())
+        {
+            throw std::invalid_argument("The size of an append blob can't be set apart from appending to it");
+        }
+    }
+
+    int64_t AppendBlob::GetCapacity()
+    {
+        // Append blobs grow with every append, there is nothing to reserve.
+        return std::numeric_limits<int64_t>::max();
+    }
+
+    void AppendBlob::SetCapacity(int64_t)
+    {
+    }
+
+    void AppendBlob::DownloadTo(const std::string& path, int64_t offset, int64_t length)
+    {
+        ::Azure::Storage::Blobs::DownloadBlobToOptions options;
+        options.Range = ::Azure::Core::Http::HttpRange(offset, length);
+        m_client.DownloadTo(path, options);
+    }
+
+    int64_t AppendBlob::DownloadTo(std::span<char> buffer, int64_t offset, int64_t length)
+    {
+        ::Azure::Storage::Blobs::DownloadBlobToOptions options
+        {
+          .Range = ::Azure::Core::Http::HttpRange { offset, length }
+        };
+
+        const auto result = m_client.DownloadTo(reinterpret_cast<uint8_t*>(buffer.data()), buffer.size(), options);
+        const auto& downloadedLength = result.Value.ContentRange.Length;
+        return downloadedLength.ValueOr(-1);
+    }
+
+    void AppendBlob::UploadPages(const std::span<char>, const int64_t)
+    {
+        throw std::logic_error("Append blobs can only be written with AppendBlock");
+    }
+
+    bool AppendBlob::IsAppendOnly() const
+    {
+        return true;
+    }
+
+    void AppendBlob::AppendBlock(const std::span<const char> data, const int64_t blobOffset)
+    {
+        // Blocks are appended in order, each one only once the blob ends where the previous one did.
+        int64_t offset = 0;
+        const auto size = static_cast<int64_t>(data.size());
+        while (offset < size)
+        {
+            const auto length = std::min(size - offset, Configuration::PageBlob::MaxUploadSize);
+            const auto block = data.subspan(static_cast<size_t>(offset), static_cast<size_t>(length));
+            ::Azure::Core::IO::MemoryBodyStream dataStream(reinterpret_cast<const uint8_t*>(block.data()), block.size());
+            ::Azure::Storage::Blobs::AppendBlockOptions options;
+            options.AccessConditions.IfAppendPositionEqual = blobOffset + offset;
+            try
+            {
+                m_client.AppendBlock(dataStream, options);
+            }
+            catch (const ::Azure::Storage::StorageException& ex)
+            {
+                // A retried request fails the position check when the first attempt already went through.
+                // Anything else means another writer appended, which must not be papered over.
+                if (ex.StatusCode != ::Azure::Core::Http::HttpStatusCode::PreconditionFailed ||
+                    GetSize() != blobOffset + offset + length)
+                {
+                    throw;
+                }
+            }
+
+            offset += length;
+        }
+    }
+
+    ::Azure::ETag AppendBlob::GetEtag()
+    {
+        const auto properties = m_client.GetProperties();
+        return properties.Value.ETag;
+    }
+
+    int64_t AppendBlob::Download(std::span<char> buffer, int64_t offset, int64_t length, const ::Azure::ETag& ifMatch)
+    {
+        ::Azure::Storage::Blobs::DownloadBlobOptions options
+        {
+          .Range = ::Azure::Core::Http::HttpRange { offset, length }
+        };
+        options.AccessConditions.IfMatch = ifMatch;
+        const auto result = m_client.Download(options, ::Azure::Core::Context{});
+        const auto& content = result.Value;
+
+        return static_cast<int64_t>(content.BodyStream->ReadToCount(reinterpret_cast<uint8_t*>(buffer.data()), buffer.size()));
+    }
+}
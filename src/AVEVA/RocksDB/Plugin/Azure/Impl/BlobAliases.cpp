@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/BlobAliases.hpp"
+
+#include <algorithm>
+
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    std::string BlobAliases::Resolve(const std::string_view realPath) const
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_blobs.find(realPath);
+        return it != m_blobs.end() ? it->second : std::string(realPath);
+    }
+
+    bool BlobAliases::IsRecycled(const std::string_view realPath) const
+    {
+        std::scoped_lock lock(m_mutex);
+        return std::ranges::any_of(m_blobs, [realPath](const auto& alias) { return alias.second == realPath; }) && !m_blobs.contains(realPath);
+    }
+
+    void BlobAliases::Record(const std::string_view realPath, const std::string_view blobName)
+    {
+        std::scoped_lock lock(m_mutex);
+
+        // A blob holds one file at a time, so the name it was recycled from is gone.
+        std::erase_if(m_blobs, [blobName](const auto& alias) { return alias.second == blobName; });
+        if (realPath == blobName)
+        {
+            m_blobs.erase(std::string(realPath));
+            return;
+        }
+
+        m_blobs.insert_or_assign(std::string(realPath), std::string(blobName));
+    }
+
+    std::optional<std::string> BlobAliases::Forget(const std::string_view realPath)
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_blobs.find(realPath);
+        if (it == m_blobs.end())
+        {
+            return std::nullopt;
+        }
+
+        auto blobName = std::move(it->second);
+        m_blobs.erase(it);
+        return blobName;
+    }
+
+    void BlobAliases::ForgetPrefix(const std::string_view prefix)
+    {
+        std::scoped_lock lock(m_mutex);
+        auto it = m_blobs.lower_bound(prefix);
+        while (it != m_blobs.end() && it->first.starts_with(prefix))
+        {
+            it = m_blobs.erase(it);
+        }
+    }
+}
@@ -8,14 +8,143 @@
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/StorageAccount.hpp"
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/BlobHelpers.hpp"
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/AzureContainerClient.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/StripedContainerClient.hpp"
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/PageBlob.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/BlockBlob.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/AppendBlob.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/SmallBlob.hpp"
 
 #include <azure/storage/blobs.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <future>
+
 using boost::log::trivial::severity_level;
 
 namespace AVEVA::RocksDB::Plugin::Azure::Impl
 {
+    static uint64_t PosixNow()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+    static const constexpr std::string_view g_renameSuffix = ".renaming";
+
+    static ::Azure::Storage::Blobs::Models::BlobProperties CopyBlob(const ::Azure::Storage::Blobs::BlobClient& destClient,
+        const std::string& sourceUrl,
+        const std::string_view realPathFrom,
+        const std::string_view realPathTo,
+        const ::Azure::Storage::Blobs::StartBlobCopyFromUriOptions& options = {})
+    {
+        auto properties = destClient.StartCopyFromUri(sourceUrl, options).PollUntilDone(Configuration::CopyPollInterval).Value;
+        if (properties.CopyStatus.HasValue() && properties.CopyStatus.Value() != ::Azure::Storage::Blobs::Models::CopyStatus::Success)
+        {
+            throw std::runtime_error("Failed to copy '" + std::string(realPathFrom) + "' to '" + std::string(realPathTo) + "'");
+        }
+
+        return properties;
+    }
+
+    static bool BlobExists(const ::Azure::Storage::Blobs::BlobClient& client)
+    {
+        try
+        {
+            client.GetProperties();
+            return true;
+        }
+        catch (const ::Azure::Storage::StorageException& ex)
+        {
+            if (ex.StatusCode != ::Azure::Core::Http::HttpStatusCode::NotFound)
+            {
+                throw;
+            }
+
+            return false;
+        }
+    }
+
+    static void ValidateProfile(const Core::RocksDBHelpers::FileClass fileType, const BlobKind blobType)
+    {
+        using FileClass = Core::RocksDBHelpers::FileClass;
+        if (blobType == BlobKind::OneShot && !Core::RocksDBHelpers::IsSmallFile(fileType))
+        {
+            // Sync is a no-op and the whole file is held in memory until Close.
+            throw std::invalid_argument("Only CURRENT, OPTIONS, IDENTITY and temporary files can be written as one shot blobs");
+        }
+
+        if (blobType == BlobKind::Block && (fileType == FileClass::WAL || fileType == FileClass::Manifest || fileType == FileClass::Temp))
+        {
+            // Reopening continues a file as a page blob, and temporary files are renamed into place.
+            throw std::invalid_argument("WAL, MANIFEST and temporary files can't be written as block blobs");
+        }
+
+        if (fileType == FileClass::InfoLog && blobType != BlobKind::Page && blobType != BlobKind::Append)
+        {
+            throw std::invalid_argument("Info logs are appended to across restarts, so they can only be page or append blobs");
+        }
+    }
+
+    std::map<Core::RocksDBHelpers::FileClass, FileProfile> BlobFilesystemImpl::ResolveProfiles(const int64_t dataFileInitialSize,
+        const int64_t dataFileBufferSize,
+        const FilesystemOptions& options)
+    {
+        using FileClass = Core::RocksDBHelpers::FileClass;
+        static const constexpr FileClass fileClasses[] =
+        {
+            FileClass::Directory, FileClass::SST, FileClass::WAL, FileClass::Manifest, FileClass::Identity, FileClass::Current,
+            FileClass::Options, FileClass::Lock, FileClass::InfoLog, FileClass::Blob, FileClass::Temp,
+        };
+
+        std::map<FileClass, FileProfile> profiles;
+        for (const auto fileType : fileClasses)
+        {
+            // The defaults are what the options meant before profiles could be set per class.
+            const auto isData = fileType == FileClass::WAL || fileType == FileClass::SST || fileType == FileClass::Blob;
+            auto blobType = BlobKind::Page;
+            if (options.OneShotSmallFiles && Core::RocksDBHelpers::IsSmallFile(fileType))
+            {
+                blobType = BlobKind::OneShot;
+            }
+            else if (options.BlockBlobSst && fileType == FileClass::SST)
+            {
+                blobType = BlobKind::Block;
+            }
+            else if (options.AppendBlobLogs && (fileType == FileClass::WAL || fileType == FileClass::InfoLog))
+            {
+                blobType = BlobKind::Append;
+            }
+
+            FileProfile profile
+            {
+                .BufferSize = isData ? dataFileBufferSize
+                    : fileType == FileClass::InfoLog ? Configuration::PageBlob::DefaultSize : Configuration::PageBlob::DefaultBufferSize,
+                .InitialSize = isData ? dataFileInitialSize : Configuration::PageBlob::DefaultSize,
+                .GrowthBlockSize = 0,
+                .Readahead = 0,
+                .Cacheable = fileType != FileClass::InfoLog,
+                .BlobType = blobType,
+            };
+
+            if (const auto it = options.FileProfiles.find(fileType); it != options.FileProfiles.end())
+            {
+                const auto& changes = it->second;
+                profile.BufferSize = changes.BufferSize.value_or(profile.BufferSize);
+                profile.InitialSize = changes.InitialSize.value_or(profile.InitialSize);
+                profile.GrowthBlockSize = changes.GrowthBlockSize.value_or(profile.GrowthBlockSize);
+                profile.Readahead = changes.Readahead.value_or(profile.Readahead);
+                profile.Cacheable = changes.Cacheable.value_or(profile.Cacheable);
+                profile.BlobType = changes.BlobType.value_or(profile.BlobType);
+            }
+
+            ValidateProfile(fileType, profile.BlobType);
+
+            profiles.emplace(fileType, profile);
+        }
+
+        return profiles;
+    }
+
     BlobFilesystemImpl::BlobFilesystemImpl(const std::string& name,
         const std::string& storageAccountUrl,
         const std::string& storageAccountKey,
@@ -23,26 +152,27 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         int64_t dataFileBufferSize,
         std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
         std::optional<std::string_view> cachePath,
-        size_t maxCacheSize)
-        : BlobFilesystemImpl(std::move(logger), dataFileInitialSize, dataFileBufferSize)
+        size_t maxCacheSize,
+        const FilesystemOptions& options)
+        : BlobFilesystemImpl(std::move(logger), dataFileInitialSize, dataFileBufferSize, options)
     {
+        auto credential = std::make_shared<::Azure::Storage::StorageSharedKeyCredential>(storageAccountUrl, storageAccountKey);
         ::Azure::Storage::Blobs::BlobServiceClient serviceClient
         {
             storageAccountUrl,
-            std::make_shared<::Azure::Storage::StorageSharedKeyCredential>(storageAccountUrl, storageAccountKey),
+            credential,
             BlobHelpers::CreateBlobClientOptions()
         };
 
         auto containerClient = BlobHelpers::GetContainerClient(serviceClient, name);
         const auto uniquePrefix = StorageAccount::UniquePrefix(storageAccountUrl, name);
+        AddStripes(uniquePrefix, serviceClient, containerClient, storageAccountUrl, [&credential](const std::string& url)
+            {
+                return ::Azure::Storage::Blobs::BlobServiceClient{ url, credential, BlobHelpers::CreateBlobClientOptions() };
+            });
         if (cachePath)
         {
-            m_fileCaches.emplace(uniquePrefix,
-                std::make_shared<Core::FileCache>(*cachePath,
-                    maxCacheSize,
-                    std::make_shared<AzureContainerClient>(containerClient),
-                    std::make_shared<Core::LocalFilesystem>(m_logger),
-                    m_logger));
+            AddFileCache(uniquePrefix, containerClient, *cachePath, maxCacheSize);
         }
 
         m_clients.emplace(uniquePrefix, ServiceContainer{ std::move(serviceClient), std::move(containerClient) });
@@ -57,26 +187,27 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         int64_t dataFileBufferSize,
         std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
         std::optional<std::string_view> cachePath,
-        size_t maxCacheSize)
-        : BlobFilesystemImpl(std::move(logger), dataFileInitialSize, dataFileBufferSize)
+        size_t maxCacheSize,
+        const FilesystemOptions& options)
+        : BlobFilesystemImpl(std::move(logger), dataFileInitialSize, dataFileBufferSize, options)
     {
+        auto credential = std::make_shared<::Azure::Identity::ClientSecretCredential>(tenantId, servicePrincipalId, servicePrincipalSecret, BlobHelpers::CreateClientSecretCredentialOptions());
         ::Azure::Storage::Blobs::BlobServiceClient serviceClient
         {
             storageAccountUrl,
-            std::make_shared<::Azure::Identity::ClientSecretCredential>(tenantId, servicePrincipalId, servicePrincipalSecret, BlobHelpers::CreateClientSecretCredentialOptions()),
+            credential,
             BlobHelpers::CreateBlobClientOptions()
         };
 
         auto containerClient = BlobHelpers::GetContainerClient(serviceClient, name);
         const auto uniquePrefix = StorageAccount::UniquePrefix(storageAccountUrl, name);
+        AddStripes(uniquePrefix, serviceClient, containerClient, storageAccountUrl, [&credential](const std::string& url)
+            {
+                return ::Azure::Storage::Blobs::BlobServiceClient{ url, credential, BlobHelpers::CreateBlobClientOptions() };
+            });
         if (cachePath)
         {
-            m_fileCaches.emplace(uniquePrefix,
-                std::make_shared<Core::FileCache>(*cachePath,
-                    maxCacheSize,
-                    std::make_shared<AzureContainerClient>(containerClient),
-                    std::make_shared<Core::LocalFilesystem>(m_logger),
-                    m_logger));
+            AddFileCache(uniquePrefix, containerClient, *cachePath, maxCacheSize);
         }
 
         m_clients.emplace(uniquePrefix, ServiceContainer{ std::move(serviceClient), std::move(containerClient) });
@@ -91,26 +222,27 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         int64_t dataFileInitialSize,
         int64_t dataFileBufferSize,
         std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
-        std::optional<std::string_view> cachePath, size_t maxCacheSize)
-        : BlobFilesystemImpl(std::move(logger), dataFileInitialSize, dataFileBufferSize)
+        std::optional<std::string_view> cachePath, size_t maxCacheSize,
+        const FilesystemOptions& options)
+        : BlobFilesystemImpl(std::move(logger), dataFileInitialSize, dataFileBufferSize, options)
     {
+        auto credential = std::make_shared<::Azure::Identity::AzurePipelinesCredential>(tenantId, clientId, serviceConnectionId, accessToken, BlobHelpers::CreatePipelinesCredentialOptions());
         ::Azure::Storage::Blobs::BlobServiceClient serviceClient
         {
             storageAccountUrl,
-            std::make_shared<::Azure::Identity::AzurePipelinesCredential>(tenantId, clientId, serviceConnectionId, accessToken, BlobHelpers::CreatePipelinesCredentialOptions()),
+            credential,
             BlobHelpers::CreateBlobClientOptions()
         };
 
         auto containerClient = BlobHelpers::GetContainerClient(serviceClient, name);
         const auto uniquePrefix = StorageAccount::UniquePrefix(storageAccountUrl, name);
+        AddStripes(uniquePrefix, serviceClient, containerClient, storageAccountUrl, [&credential](const std::string& url)
+            {
+                return ::Azure::Storage::Blobs::BlobServiceClient{ url, credential, BlobHelpers::CreateBlobClientOptions() };
+            });
         if (cachePath)
         {
-            m_fileCaches.emplace(uniquePrefix,
-                std::make_shared<Core::FileCache>(*cachePath,
-                    maxCacheSize,
-                    std::make_shared<AzureContainerClient>(containerClient),
-                    std::make_shared<Core::LocalFilesystem>(m_logger),
-                    m_logger));
+            AddFileCache(uniquePrefix, containerClient, *cachePath, maxCacheSize);
         }
 
         m_clients.emplace(uniquePrefix, ServiceContainer{ std::move(serviceClient), std::move(containerClient) });
@@ -122,20 +254,21 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         int64_t dataFileBufferSize,
         std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
         std::optional<std::string_view> cachePath,
-        size_t maxCacheSize)
-        : BlobFilesystemImpl(std::move(logger), dataFileInitialSize, dataFileBufferSize)
+        size_t maxCacheSize,
+        const FilesystemOptions& options)
+        : BlobFilesystemImpl(std::move(logger), dataFileInitialSize, dataFileBufferSize, options)
     {
         auto serviceClient = BlobHelpers::CreateServiceClient(primary);
         auto containerClient = BlobHelpers::GetContainerClient(serviceClient, primary.GetDbName());
         const auto uniquePrefix = StorageAccount::UniquePrefix(primary.GetStorageAccountUrl(), primary.GetDbName());
+        AddStripes(uniquePrefix, serviceClient, containerClient, primary.GetStorageAccountUrl(), [&primary](const std::string& url)
+            {
+                return BlobHelpers::CreateServiceClient(Models::ChainedCredentialInfo{ primary.GetDbName(), url, primary.GetServicePrincipalId(), primary.GetServicePrincipalSecret(), primary.GetTenantId(),
+                    primary.GetManagedIdentityId() ? std::optional<std::string>(*primary.GetManagedIdentityId()) : std::nullopt });
+            });
         if (cachePath)
         {
-            m_fileCaches.emplace(uniquePrefix,
-                std::make_shared<Core::FileCache>(*cachePath,
-                    maxCacheSize,
-                    std::make_shared<AzureContainerClient>(containerClient),
-                    std::make_shared<Core::LocalFilesystem>(m_logger),
-                    m_logger));
+            AddFileCache(uniquePrefix, containerClient, *cachePath, maxCacheSize);
         }
 
         m_clients.emplace(uniquePrefix, ServiceContainer{ std::move(serviceClient), std::move(containerClient) });
@@ -159,20 +292,20 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         int64_t dataFileBufferSize,
         std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
         std::optional<std::string_view> cachePath,
-        size_t maxCacheSize)
-        : BlobFilesystemImpl(std::move(logger), dataFileInitialSize, dataFileBufferSize)
+        size_t maxCacheSize,
+        const FilesystemOptions& options)
+        : BlobFilesystemImpl(std::move(logger), dataFileInitialSize, dataFileBufferSize, options)
     {
         auto serviceClient = BlobHelpers::CreateServiceClient(primary);
         auto containerClient = BlobHelpers::GetContainerClient(serviceClient, primary.GetDbName());
         const auto uniquePrefix = StorageAccount::UniquePrefix(primary.GetStorageAccountUrl(), primary.GetDbName());
+        AddStripes(uniquePrefix, serviceClient, containerClient, primary.GetStorageAccountUrl(), [&primary](const std::string& url)
+            {
+                return BlobHelpers::CreateServiceClient(Models::ServicePrincipalStorageInfo{ primary.GetDbName(), url, primary.GetServicePrincipalId(), primary.GetServicePrincipalSecret(), primary.GetTenantId() });
+            });
         if (cachePath)
         {
-            m_fileCaches.emplace(uniquePrefix,
-                std::make_shared<Core::FileCache>(*cachePath,
-                    maxCacheSize,
-                    std::make_shared<AzureContainerClient>(containerClient),
-                    std::make_shared<Core::LocalFilesystem>(m_logger),
-                    m_logger));
+            AddFileCache(uniquePrefix, containerClient, *cachePath, maxCacheSize);
         }
 
         m_clients.emplace(uniquePrefix, ServiceContainer{ std::move(serviceClient), std::move(containerClient) });
@@ -195,18 +328,26 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         EnsureLiveness();
 
         const auto [prefix, realPath] = StorageAccount::StripPrefix(filePath);
-        const auto& container = GetContainer(prefix);
-        auto pageBlobClient = container.GetPageBlobClient(std::string(realPath));
-        auto blobClient = std::make_shared<PageBlob>(std::move(pageBlobClient));
-        auto cache = m_fileCaches.find(prefix);
-        if (cache != m_fileCaches.end())
+        const auto& container = GetContainer(prefix, realPath);
+        const auto& profile = GetProfile(Core::RocksDBHelpers::GetFileType(realPath));
+        if (profile.BlobType == BlobKind::OneShot)
         {
-            return ReadableFileImpl{ realPath, std::move(blobClient), cache->second, m_logger };
+            if (auto smallBlobClient = OpenSmallFile(container, filePath, realPath))
+            {
+                return ReadableFileImpl{ realPath, std::move(smallBlobClient), nullptr, m_logger };
+            }
         }
-        else
+
+        auto pageBlobClient = container.GetPageBlobClient(ResolveBlob(prefix, realPath));
+        auto blobClient = std::make_shared<PageBlob>(std::move(pageBlobClient));
+        if (auto index = FindIndex(prefix, realPath); index && !index->Find(realPath))
         {
-            return ReadableFileImpl{ realPath, std::move(blobClient), nullptr, m_logger};
+            // Opening is local and a missing file only shows on the first read, unless the index says it's missing.
+            // Asking for the properties then fails the open the way it always did.
+            blobClient->GetEtag();
         }
+
+        return ReadableFileImpl{ realPath, std::move(blobClient), GetFileCache(prefix, profile), m_logger, profile.Readahead };
     }
 
     WriteableFileImpl BlobFilesystemImpl::CreateWriteableFile(const std::string& filePath)
@@ -214,41 +355,138 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         EnsureLiveness();
 
         const auto fileType = Core::RocksDBHelpers::GetFileType(filePath);
+        const auto& profile = GetProfile(fileType);
         const auto isData = fileType == Core::RocksDBHelpers::FileClass::WAL ||
             fileType == Core::RocksDBHelpers::FileClass::SST;
-        const auto initialSize =
-            isData ? m_dataFileInitialSize : Configuration::PageBlob::DefaultSize;
-        const auto bufferSize =
-            isData ? m_dataFileBufferSize : Configuration::PageBlob::DefaultBufferSize;
+        const auto sizeTrailer = m_options.WalSizeTrailer && fileType == Core::RocksDBHelpers::FileClass::WAL;
+        const auto bufferCount = isData && !sizeTrailer ? m_options.WriteBufferCount : 1;
+        const auto durability = isData ? m_options.Durability : DurabilityMode::Flush;
 
         const auto [prefix, realPath] = StorageAccount::StripPrefix(filePath);
-        const auto& container = GetContainer(prefix);
+        SettleDeletion(prefix, realPath);
+        DropAlias(prefix, realPath);
+        const auto stripe = PlaceFile(prefix, realPath);
+        const auto& container = GetStripeContainer(prefix, stripe);
+        switch (profile.BlobType)
+        {
+        case BlobKind::OneShot:
+        {
+            // Nothing is sent until Close writes the whole file with one Put Blob, which also replaces whatever
+            // was stored under the name before. Syncing a small file before closing it is a no-op.
+            auto blobClient = std::make_shared<SmallBlob>(container.GetBlockBlobClient(std::string(realPath)), m_smallFiles, filePath);
+            const WriteableFileImpl::BlobState state{ 0, blobClient->GetCapacity() };
+            return TrackFile(prefix, realPath, WriteableFileImpl{ realPath, std::move(blobClient), state, nullptr, m_logger, profile.BufferSize, 1, m_options.UploadConcurrency, false, DurabilityMode::Close });
+        }
+        case BlobKind::Block:
+            return TrackFile(prefix, realPath, CreateBlockBlobFile(prefix, realPath, profile, bufferCount, durability));
+        case BlobKind::Append:
+            return TrackFile(prefix, realPath, CreateAppendBlobFile(prefix, realPath, profile, durability, true));
+        case BlobKind::Page:
+            break;
+        }
 
         auto client = container.GetPageBlobClient(std::string(realPath));
-        auto res = client.CreateIfNotExists(initialSize);
+        ::Azure::Storage::Blobs::CreatePageBlobOptions createOptions;
+        if (sizeTrailer)
+        {
+            createOptions.Metadata = BlobHelpers::SizeTrailerMetadata();
+        }
 
-        // Creating a writeable file is intended to always provide a "new" file.
-        // If the file previously existed, efficiently truncate it so that for
-        // all intents and purposes, it's a new file.
-        if (!res.Value.Created)
+        // Creating a writeable file is intended to always provide a "new" file. A single Put Blob creates it or
+        // replaces whatever was there with an empty blob of the initial size, so nothing has to be read first.
+        // Data files usually find an empty blob of that size already waiting in the pool.
+        // Pooled blobs are created with the data file initial size, so classes sized differently don't use the pool.
+        const auto pooled = isData && !sizeTrailer && profile.InitialSize == m_dataFileInitialSize && stripe == 0;
+        auto* pool = pooled ? GetBlobPool(prefix, true) : nullptr;
+        if (!pool || !pool->Claim(realPath))
         {
-            BlobHelpers::SetFileSize(client, 0);
-            if (client.GetProperties().Value.BlobSize > initialSize)
-            {
-                client.Resize(initialSize);
-            }
+            client.Create(profile.InitialSize, createOptions);
         }
 
-        auto cache = m_fileCaches.find(prefix);
+        if (pool)
+        {
+            pool->Replenish(realPath);
+        }
+
+        const WriteableFileImpl::BlobState state{ 0, profile.InitialSize };
         auto blobClient = std::make_unique<PageBlob>(std::move(client));
-        if (cache != m_fileCaches.end())
+        return FinishOpen(prefix, realPath, profile, WriteableFileImpl{ realPath, std::move(blobClient), state, GetFileCache(prefix, profile), m_logger, profile.BufferSize, bufferCount, m_options.UploadConcurrency, sizeTrailer, durability });
+    }
+
+    WriteableFileImpl BlobFilesystemImpl::CreateBlockBlobFile(const std::string_view prefix,
+        const std::string_view realPath,
+        const FileProfile& profile,
+        const int64_t bufferCount,
+        const DurabilityMode durability)
+    {
+        auto client = GetContainer(prefix, realPath).GetBlockBlobClient(std::string(realPath));
+
+        // Blocks can't be staged on a blob of another type left behind under the same name.
+        client.DeleteIfExists();
+
+        auto blobClient = std::make_shared<BlockBlob>(std::move(client));
+        return WriteableFileImpl{ realPath, std::move(blobClient), GetFileCache(prefix, profile), m_logger, profile.BufferSize, bufferCount, m_options.UploadConcurrency, false, durability };
+    }
+
+    WriteableFileImpl BlobFilesystemImpl::CreateAppendBlobFile(const std::string_view prefix,
+        const std::string_view realPath,
+        const FileProfile& profile,
+        const DurabilityMode durability,
+        const bool create)
+    {
+        auto client = GetContainer(prefix, realPath).GetAppendBlobClient(std::string(realPath));
+        auto blobClient = std::make_shared<AppendBlob>(client);
+        auto state = create
+            ? WriteableFileImpl::BlobState{ 0, blobClient->GetCapacity() }
+            : WriteableFileImpl::BlobState{ blobClient->GetSize(), blobClient->GetCapacity() };
+        if (create)
         {
-            return WriteableFileImpl{ realPath, std::move(blobClient), cache->second, m_logger, bufferSize };
+            // Replaces a blob of any type left behind under the same name.
+            client.Create();
         }
-        else
+
+        // Appends go out one at a time in order, so there is a single buffer and no size trailer.
+        return WriteableFileImpl{ realPath, std::move(blobClient), state, GetFileCache(prefix, profile), m_logger, profile.BufferSize, 1, m_options.UploadConcurrency, false, durability };
+    }
+
+    std::shared_ptr<Core::BlobClient> BlobFilesystemImpl::OpenSmallFile(const ::Azure::Storage::Blobs::BlobContainerClient& container,
+        const std::string& filePath,
+        const std::string_view realPath)
+    {
+        // A single conditional download replaces the property and download requests of a page blob reader.
+        // It comes back empty when the cached copy is still current, even if another process wrote it.
+        auto client = container.GetBlockBlobClient(std::string(realPath));
+        auto cached = m_smallFiles->Find(filePath);
+        ::Azure::Storage::Blobs::DownloadBlobOptions options;
+        if (cached)
+        {
+            options.AccessConditions.IfNoneMatch = cached->ETag;
+        }
+
+        try
+        {
+            const auto response = client.Download(options);
+            if (response.Value.BlobType != ::Azure::Storage::Blobs::Models::BlobType::BlockBlob)
+            {
+                // Written before small files were enabled, the size is in the page blob's metadata.
+                return nullptr;
+            }
+
+            const auto body = response.Value.BodyStream->ReadToEnd();
+            SmallFileCache::Entry entry{ std::vector<char>(body.begin(), body.end()), response.Value.Details.ETag };
+            m_smallFiles->Put(filePath, entry);
+            return std::make_shared<SmallBlob>(std::move(client), m_smallFiles, filePath, std::move(entry));
+        }
+        catch (const ::Azure::Storage::StorageException& e)
         {
-            return WriteableFileImpl{ realPath, std::move(blobClient), nullptr, m_logger, bufferSize };
+            if (!cached || e.StatusCode != ::Azure::Core::Http::HttpStatusCode::NotModified)
+            {
+                throw;
+            }
         }
+
+        BOOST_LOG_SEV(*m_logger, severity_level::debug) << "Reading small file '" << filePath << "' from the cache";
+        return std::make_shared<SmallBlob>(std::move(client), m_smallFiles, filePath, std::move(*cached));
     }
 
     ReadWriteFileImpl BlobFilesystemImpl::CreateReadWriteFile(const std::string& filePath)
@@ -256,21 +494,27 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         EnsureLiveness();
 
         const auto [prefix, realPath] = StorageAccount::StripPrefix(filePath);
-        const auto& container = GetContainer(prefix);
+        SettleDeletion(prefix, realPath);
+        const auto& container = GetContainer(prefix, realPath);
 
         auto client = std::make_shared<::Azure::Storage::Blobs::PageBlobClient>(container.GetPageBlobClient(std::string(realPath)));
         auto response = client->CreateIfNotExists(Configuration::PageBlob::DefaultSize);
 
         auto blobClient = std::make_shared<PageBlob>(std::move(*client));
+        if (auto index = FindIndex(prefix, realPath))
+        {
+            // Random writes change the size without a sync, so only the file's existence is tracked.
+            index->Put(realPath, std::nullopt, PosixNow());
+        }
 
         auto cache = m_fileCaches.find(prefix);
         if (cache != m_fileCaches.end())
         {
-            return ReadWriteFileImpl{ realPath, std::move(blobClient), cache->second, m_logger };
+            return ReadWriteFileImpl{ realPath, std::move(blobClient), cache->second, m_logger, m_options.ReadWriteCacheSize };
         }
         else
         {
-            return ReadWriteFileImpl{ realPath, std::move(blobClient), nullptr, m_logger };
+            return ReadWriteFileImpl{ realPath, std::move(blobClient), nullptr, m_logger, m_options.ReadWriteCacheSize };
         }
     }
 
@@ -279,52 +523,173 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         EnsureLiveness();
 
         const auto [prefix, realPath] = StorageAccount::StripPrefix(filePath);
-        const auto& container = GetContainer(prefix);
+        SettleDeletion(prefix, realPath);
+        const auto& container = GetContainer(prefix, realPath);
         const auto fileType = Core::RocksDBHelpers::GetFileType(filePath);
+        const auto& profile = GetProfile(fileType);
         const auto isData = fileType == Core::RocksDBHelpers::FileClass::WAL ||
             fileType == Core::RocksDBHelpers::FileClass::SST;
-        const auto bufferSize =
-            isData ? m_dataFileBufferSize : Configuration::PageBlob::DefaultBufferSize;
-
-        auto client = std::make_shared<PageBlob>(container.GetPageBlobClient(std::string(realPath)));
-        auto cache = m_fileCaches.find(prefix);
-        if (cache != m_fileCaches.end())
-        {
-            return WriteableFileImpl{ realPath, std::move(client), cache->second, m_logger, static_cast<int64_t>(bufferSize) };
-        }
-        else
+        const auto bufferCount = isData ? m_options.WriteBufferCount : 1;
+        const auto durability = isData ? m_options.Durability : DurabilityMode::Flush;
+
+        // Files written before append blobs were enabled for their class carry on as page blobs, and so does a
+        // recycled WAL in the blob it was recycled into.
+        const auto blobName = ResolveBlob(prefix, realPath);
+        if (profile.BlobType == BlobKind::Append &&
+            container.GetBlobClient(blobName).GetProperties().Value.BlobType == ::Azure::Storage::Blobs::Models::BlobType::AppendBlob)
         {
-            return WriteableFileImpl{ realPath, std::move(client), nullptr, m_logger, static_cast<int64_t>(bufferSize) };
+            return TrackFile(prefix, realPath, CreateAppendBlobFile(prefix, realPath, profile, durability, false));
         }
+
+        auto client = std::make_shared<PageBlob>(container.GetPageBlobClient(blobName), blobName != realPath ? std::string(realPath) : std::string());
+        return FinishOpen(prefix, realPath, profile, WriteableFileImpl{ realPath, std::move(client), GetFileCache(prefix, profile), m_logger, profile.BufferSize, bufferCount, m_options.UploadConcurrency, false, durability });
     }
 
-    WriteableFileImpl BlobFilesystemImpl::ReuseWritableFile(const std::string& filePath)
+    WriteableFileImpl BlobFilesystemImpl::ReuseWritableFile(const std::string& filePath, const std::string& oldFilePath)
     {
         EnsureLiveness();
 
         const auto [prefix, realPath] = StorageAccount::StripPrefix(filePath);
-        const auto& container = GetContainer(prefix);
+        const auto [oldPrefix, oldRealPath] = StorageAccount::StripPrefix(oldFilePath.empty() ? filePath : oldFilePath);
+        SettleDeletion(prefix, realPath);
+        const auto oldStripe = LocateStripe(oldPrefix, oldRealPath);
+        const auto stripe = PlaceFile(prefix, realPath);
+        const auto& container = GetStripeContainer(prefix, stripe);
         const auto fileType = Core::RocksDBHelpers::GetFileType(filePath);
+        const auto& profile = GetProfile(fileType);
         const auto isData = fileType == Core::RocksDBHelpers::FileClass::WAL ||
             fileType == Core::RocksDBHelpers::FileClass::SST;
-        const auto initialSize = isData ? m_dataFileInitialSize : Configuration::PageBlob::DefaultSize;
-        const auto bufferSize = isData ? m_dataFileBufferSize : Configuration::PageBlob::DefaultBufferSize;
+        const auto sizeTrailer = m_options.WalSizeTrailer && fileType == Core::RocksDBHelpers::FileClass::WAL;
+        const auto bufferCount = isData && !sizeTrailer ? m_options.WriteBufferCount : 1;
+        const auto durability = isData ? m_options.Durability : DurabilityMode::Flush;
+
+        auto cache = m_fileCaches.find(prefix);
+        if (cache != m_fileCaches.end() && oldRealPath != realPath)
+        {
+            cache->second->RemoveFile(oldRealPath);
+        }
+
+        // A pooled blob the pool is still creating under the new name would turn up next to the recycled one.
+        auto* pool = GetBlobPool(prefix, false);
+        const auto recyclable = profile.BlobType == BlobKind::Page && oldPrefix == prefix && oldStripe == stripe &&
+            !(pool && pool->Contains(realPath));
+        if (pool)
+        {
+            pool->Forget(realPath);
+        }
+
+        if (auto index = FindIndex(oldPrefix, oldRealPath); index && oldRealPath != realPath)
+        {
+            index->Remove(oldRealPath);
+        }
+
+        if (auto* stripes = GetStripes(oldPrefix); stripes && oldRealPath != realPath)
+        {
+            stripes->Forget(oldRealPath);
+        }
+
+        if (oldRealPath != realPath)
+        {
+            DropAlias(prefix, realPath);
+        }
+
+        // The old file may itself be held by a blob recycled earlier.
+        const auto oldBlobName = ResolveBlob(oldPrefix, oldRealPath);
+        if (recyclable)
+        {
+            // The blob keeps its name, so taking it over is a metadata update and not a copy, and its capacity
+            // carries over so the new file doesn't grow it again.
+            auto client = container.GetPageBlobClient(oldBlobName);
+            if (const auto capacity = RecycleBlob(client, sizeTrailer, oldBlobName != realPath ? realPath : std::string_view{}))
+            {
+                if (auto* aliases = GetAliases(prefix, oldBlobName != realPath))
+                {
+                    aliases->Record(realPath, oldBlobName);
+                }
+
+                const WriteableFileImpl::BlobState state{ 0, *capacity };
+                auto blobClient = std::make_shared<PageBlob>(std::move(client), oldBlobName != realPath ? std::string(realPath) : std::string());
+                return FinishOpen(prefix, realPath, profile, WriteableFileImpl{ realPath, std::move(blobClient), state, GetFileCache(prefix, profile), m_logger, profile.BufferSize, bufferCount, m_options.UploadConcurrency, sizeTrailer, durability });
+            }
+        }
+
+        // Appended or committed data can't be overwritten in place, and a missing old blob can't be taken over,
+        // so the file starts out as a new blob and the old one goes with a later deletion batch, off this path.
+        if (auto* aliases = GetAliases(oldPrefix, false))
+        {
+            aliases->Forget(oldRealPath);
+        }
+
+        if (oldBlobName != realPath)
+        {
+            GetDeletionQueue(oldPrefix, true, oldStripe)->Enqueue(oldBlobName);
+        }
+
+        if (profile.BlobType == BlobKind::Append || profile.BlobType == BlobKind::Block)
+        {
+            auto file = profile.BlobType == BlobKind::Append
+                ? CreateAppendBlobFile(prefix, realPath, profile, durability, true)
+                : CreateBlockBlobFile(prefix, realPath, profile, bufferCount, durability);
+            return TrackFile(prefix, realPath, std::move(file));
+        }
 
-        // TODO: figure out what the intent here is for now just delete and recreate
         auto client = container.GetPageBlobClient(std::string(realPath));
-        client.DeleteIfExists();
-        client.CreateIfNotExists(initialSize);
+        ::Azure::Storage::Blobs::CreatePageBlobOptions createOptions;
+        if (sizeTrailer)
+        {
+            createOptions.Metadata = BlobHelpers::SizeTrailerMetadata();
+        }
 
-        auto cache = m_fileCaches.find(prefix);
+        // Data files are given a blob from the pool when there is one, as they are by CreateWriteableFile.
+        const auto pooled = isData && !sizeTrailer && profile.InitialSize == m_dataFileInitialSize && stripe == 0;
+        pool = pooled ? GetBlobPool(prefix, true) : nullptr;
+        if (!pool || !pool->Claim(realPath))
+        {
+            client.Create(profile.InitialSize, createOptions);
+        }
+
+        if (pool)
+        {
+            pool->Replenish(realPath);
+        }
+
+        const WriteableFileImpl::BlobState state{ 0, profile.InitialSize };
         auto blobClient = std::make_shared<PageBlob>(std::move(client));
-        if (cache != m_fileCaches.end())
+        return FinishOpen(prefix, realPath, profile, WriteableFileImpl{ realPath, std::move(blobClient), state, GetFileCache(prefix, profile), m_logger, profile.BufferSize, bufferCount, m_options.UploadConcurrency, sizeTrailer, durability });
+    }
+
+    std::optional<int64_t> BlobFilesystemImpl::RecycleBlob(const ::Azure::Storage::Blobs::PageBlobClient& client, const bool sizeTrailer, const std::string_view fileName) const
+    {
+        ::Azure::Storage::Blobs::Models::BlobProperties properties;
+        try
         {
-            return WriteableFileImpl{ realPath, std::move(blobClient), cache->second, m_logger, static_cast<int64_t>(bufferSize) };
+            properties = client.GetProperties().Value;
         }
-        else
+        catch (const ::Azure::Storage::StorageException& ex)
+        {
+            if (ex.StatusCode == ::Azure::Core::Http::HttpStatusCode::NotFound)
+            {
+                return std::nullopt;
+            }
+
+            throw;
+        }
+
+        if (properties.BlobType != ::Azure::Storage::Blobs::Models::BlobType::PageBlob)
         {
-            return WriteableFileImpl{ realPath, std::move(blobClient), nullptr, m_logger, static_cast<int64_t>(bufferSize) };
+            return std::nullopt;
         }
+
+        // The new size hides the stale data, so the pages themselves are kept. The same update names the new file.
+        client.SetMetadata(sizeTrailer ? BlobHelpers::SizeTrailerMetadata(fileName) : BlobHelpers::FileSizeMetadata(0, fileName));
+        if (sizeTrailer && properties.BlobSize > 0)
+        {
+            // A trailer left in the old pages would be mistaken for the end of the new data.
+            client.ClearPages(::Azure::Core::Http::HttpRange{ 0, properties.BlobSize });
+        }
+
+        BOOST_LOG_SEV(*m_logger, severity_level::debug) << "Recycled '" << client.GetUrl() << "' with " << properties.BlobSize << " bytes of capacity";
+        return properties.BlobSize;
     }
 
     LoggerImpl BlobFilesystemImpl::CreateLogger(const std::string& filePath, const int logLevel)
@@ -332,44 +697,73 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         EnsureLiveness();
 
         const auto [prefix, realPath] = StorageAccount::StripPrefix(filePath);
+        SettleDeletion(prefix, realPath);
         const auto& container = GetContainer(prefix);
+        const auto& profile = GetProfile(Core::RocksDBHelpers::FileClass::InfoLog);
+        if (profile.BlobType == BlobKind::Append)
+        {
+            // An existing log is appended to, unless it was written as a page blob.
+            auto client = container.GetAppendBlobClient(std::string(realPath));
+            if (client.CreateIfNotExists().Value.Created ||
+                client.GetProperties().Value.BlobType == ::Azure::Storage::Blobs::Models::BlobType::AppendBlob)
+            {
+                auto blobClient = std::make_shared<AppendBlob>(std::move(client));
+                auto impl = std::make_unique<WriteableFileImpl>(TrackFile(prefix, realPath, WriteableFileImpl{ realPath, std::move(blobClient), GetFileCache(prefix, profile), m_logger, profile.BufferSize }));
+                return LoggerImpl{ std::move(impl), logLevel, m_options.InfoLogOverflow };
+            }
+        }
 
+        // Logs are appended to across restarts, so other blob kinds aren't used for them.
         auto client = container.GetPageBlobClient(std::string(realPath));
-        client.CreateIfNotExists(Configuration::PageBlob::DefaultSize);
+        client.CreateIfNotExists(profile.InitialSize);
 
         auto blobClient = std::make_shared<PageBlob>(std::move(client));
-        auto impl = std::make_unique<WriteableFileImpl>(realPath, std::move(blobClient), nullptr, m_logger, Configuration::PageBlob::DefaultSize);
-        return LoggerImpl{ std::move(impl), logLevel };
+        auto impl = std::make_unique<WriteableFileImpl>(FinishOpen(prefix, realPath, profile, WriteableFileImpl{ realPath, std::move(blobClient), GetFileCache(prefix, profile), m_logger, profile.BufferSize }));
+        return LoggerImpl{ std::move(impl), logLevel, m_options.InfoLogOverflow };
     }
 
     std::shared_ptr<LockFileImpl> BlobFilesystemImpl::LockFile(const std::string& filePath)
     {
         EnsureLiveness();
 
-        std::scoped_lock _(m_lockFilesMutex);
-
         const auto [prefix, realPath] = StorageAccount::StripPrefix(filePath);
-        const auto& container = GetContainer(prefix);
-
-        auto client = std::make_unique<::Azure::Storage::Blobs::PageBlobClient>(container.GetPageBlobClient(std::string(realPath)));
-        client->CreateIfNotExists(Configuration::PageBlob::DefaultSize);
-        auto lockFile = std::make_shared<LockFileImpl>(std::move(client), Configuration::LeaseLength, m_logger, std::string(realPath));
-        if (lockFile->Lock())
+        std::shared_ptr<LockFileImpl> lockFile;
         {
+            std::scoped_lock _(m_lockFilesMutex);
+            SettleDeletion(prefix, realPath);
+            const auto& container = GetContainer(prefix);
+
+            auto client = std::make_unique<::Azure::Storage::Blobs::PageBlobClient>(container.GetPageBlobClient(std::string(realPath)));
+            client->CreateIfNotExists(Configuration::PageBlob::DefaultSize);
+            lockFile = std::make_shared<LockFileImpl>(std::move(client), Configuration::LeaseLength, m_logger, std::string(realPath));
+            if (!lockFile->Lock())
+            {
+                throw std::runtime_error("The targeted storage location is locked");
+            }
+
             m_locks.push_back(*lockFile);
             assert(lockFile->is_linked());
-            return lockFile;
         }
-        else
+
+        // Listed without holding up lease renewals. Nothing else writes to the directory while the lease is held.
+        if (m_options.NamespaceIndexing != NamespaceIndexMode::Off)
         {
-            throw std::runtime_error("The targeted storage location is locked");
+            LoadNamespaceIndex(prefix, realPath, *lockFile);
         }
+
+        return lockFile;
     }
 
     void BlobFilesystemImpl::UnlockFile(LockFileImpl& lock)
     {
         EnsureLiveness();
 
+        {
+            // Once the lease is released another process may change the directory, so its index can't be trusted.
+            std::scoped_lock indexesLock(m_indexesMutex);
+            std::erase_if(m_indexes, [&lock](const auto& indexed) { return indexed.Lock == &lock; });
+        }
+
         std::scoped_lock _(m_lockFilesMutex);
         lock.Unlock();
         lock.unlink();
@@ -388,33 +782,60 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         EnsureLiveness();
 
         const auto [prefix, realPath] = StorageAccount::StripPrefix(name);
-        const auto& container = GetContainer(prefix);
+        if (auto* pool = GetBlobPool(prefix, false); pool && pool->Contains(realPath))
+        {
+            // Unclaimed pooled blobs don't exist as far as RocksDB is concerned.
+            return false;
+        }
 
-        try
+        if (auto* deletions = GetDeletionQueue(prefix, false, LocateStripe(prefix, realPath)); deletions && deletions->Contains(realPath))
         {
-            auto client = container.GetPageBlobClient(std::string(realPath));
-            auto props = client.GetProperties();
-            return true;
+            return false;
         }
-        catch (const ::Azure::Storage::StorageException& ex)
+
+        if (const auto* aliases = GetAliases(prefix, false); aliases && aliases->IsRecycled(realPath))
         {
-            if (ex.StatusCode == ::Azure::Core::Http::HttpStatusCode::NotFound)
+            // The blob of a recycled WAL holds the new log now.
+            return false;
+        }
+
+        const auto index = FindIndex(prefix, realPath);
+        const auto indexed = index && (index->Find(realPath) || index->HasChildren(realPath));
+        if (index && m_options.NamespaceIndexing == NamespaceIndexMode::Authoritative)
+        {
+            return indexed;
+        }
+
+        auto exists = BlobExists(GetContainer(prefix, realPath).GetBlobClient(ResolveBlob(prefix, realPath)));
+
+        if (auto* stripes = GetStripes(prefix); !exists && stripes && !stripes->Find(realPath) && StripeSet::IsStriped(realPath))
+        {
+            // Written before the stripe set changed, so on a stripe other than the one it would be placed on now.
+            const auto placed = stripes->Place(realPath);
+            for (size_t stripe = 0; stripe < stripes->Size() && !exists; ++stripe)
             {
-                // Fallback: check if this is a directory
-                // NOTE: This doesn't map 100% to how a filesystem would work because you can have empty
-                // directories in any respectable fs. This probably won't matter for our use case.
-                if (GetChildren(name, 1).size() > 0)
+                if (stripe != placed && BlobExists(stripes->Get(stripe).Container.GetBlobClient(std::string(realPath))))
                 {
-                    return true;
+                    stripes->Record(realPath, stripe);
+                    exists = true;
                 }
-
-                return false;
-            }
-            else
-            {
-                throw;
             }
         }
+
+        if (!exists)
+        {
+            // Fallback: check if this is a directory
+            // NOTE: This doesn't map 100% to how a filesystem would work because you can have empty
+            // directories in any respectable fs. This probably won't matter for our use case.
+            exists = GetChildren(name, 1).size() > 0;
+        }
+
+        if (index && exists != indexed)
+        {
+            ReportIndexMismatch("FileExists", name);
+        }
+
+        return exists;
     }
 
     std::vector<std::string> BlobFilesystemImpl::GetChildren(const std::string& directoryPath, int32_t sizeHint)
@@ -422,84 +843,201 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         EnsureLiveness();
 
         const auto [prefix, realPath] = StorageAccount::StripPrefix(directoryPath);
-        const auto& container = GetContainer(prefix);
 
         std::vector<std::string> children;
         ::Azure::Storage::Blobs::ListBlobsOptions opts;
         opts.Prefix = realPath;
         opts.PageSizeHint = sizeHint;
-        auto extractChildName = [&realPath](const auto& blob) -> std::string
+
+        // A recycled WAL is listed under the name of the file it holds, which is kept in the metadata.
+        opts.Include = ::Azure::Storage::Blobs::Models::ListBlobsIncludeFlags::Metadata;
+        auto extractChildName = [&realPath](const std::string& blobName) -> std::string
             {
-                size_t startPos = blob.Name.find(realPath);
+                size_t startPos = blobName.find(realPath);
                 if (startPos != std::string::npos)
                 {
                     auto index = startPos + realPath.length();
-                    assert(index < blob.Name.size());
+                    assert(index < blobName.size());
 
-                    if (blob.Name[index] == '/')
+                    if (blobName[index] == '/')
                     {
                         index++;
                     }
 
-                    return blob.Name.substr(index);
+                    return blobName.substr(index);
                 }
                 return {};
             };
 
-        // Process all pages of results
-        auto blobs = container.ListBlobs(opts);
-        do
+        const auto index = FindIndex(prefix, realPath);
+        std::vector<std::string> indexed;
+        if (index)
         {
-            for (const auto& blob : blobs.Blobs)
+            for (const auto& [blobName, _] : index->List(realPath))
             {
-                if (auto childName = extractChildName(blob); !childName.empty())
+                if (auto childName = extractChildName(blobName); !childName.empty())
                 {
-                    children.emplace_back(std::move(childName));
+                    indexed.emplace_back(std::move(childName));
                 }
             }
 
-            if (!blobs.NextPageToken.HasValue())
+            if (m_options.NamespaceIndexing == NamespaceIndexMode::Authoritative)
             {
-                break;
+                return indexed;
             }
-
-            opts.ContinuationToken = blobs.NextPageToken;
-            blobs = container.ListBlobs(opts);
-        } while (true);
-
-        return children;
-    }
-
-    std::vector<BlobAttributes> BlobFilesystemImpl::GetChildrenFileAttributes(const std::string& directoryPath)
-    {
-        EnsureLiveness();
-
-        const auto [prefix, realPath] = StorageAccount::StripPrefix(directoryPath);
-        const auto& container = GetContainer(prefix);
-        std::vector<BlobAttributes> attributes;
-
-        ::Azure::Storage::Blobs::ListBlobsOptions opts;
-        opts.Prefix = realPath;
-        opts.PageSizeHint = 10000;  // hopefully plenty for now
+        }
 
         // Process all pages of results
-        auto blobs = container.ListBlobs(opts);
-        do
+        auto* pool = GetBlobPool(prefix, false);
+        auto* stripes = GetStripes(prefix);
+        bool aliased = false;
+        for (size_t stripe = 0; stripe < StripeCount(prefix); ++stripe)
         {
-            for (const auto& blob : blobs.Blobs)
+            const auto& container = GetStripeContainer(prefix, stripe);
+            auto* deletions = GetDeletionQueue(prefix, false, stripe);
+            opts.ContinuationToken.Reset();
+            auto blobs = container.ListBlobs(opts);
+            do
             {
-                const auto client = container.GetPageBlobClient(blob.Name);
-                attributes.emplace_back(BlobHelpers::GetFileSize(client), blob.Name.substr(realPath.length()));
+                for (const auto& blob : blobs.Blobs)
+                {
+                    if ((pool && pool->Contains(blob.Name)) || (deletions && deletions->Contains(blob.Name)))
+                    {
+                        continue;
+                    }
+
+                    if (stripes)
+                    {
+                        stripes->RecordListed(blob.Name, stripe);
+                        if (stripes->Locate(blob.Name) != stripe)
+                        {
+                            continue;
+                        }
+                    }
+
+                    const auto fileName = ListedFileName(prefix, blob);
+                    aliased = aliased || fileName != blob.Name;
+                    if (auto childName = extractChildName(fileName); !childName.empty())
+                    {
+                        children.emplace_back(std::move(childName));
+                    }
+                }
+
+                if (!blobs.NextPageToken.HasValue())
+                {
+                    break;
+                }
+
+                opts.ContinuationToken = blobs.NextPageToken;
+                blobs = container.ListBlobs(opts);
+            } while (true);
+        }
+
+        if (stripes || aliased)
+        {
+            // Each stripe is listed in name order on its own, and recycled blobs in the order of their own names.
+            std::ranges::sort(children);
+        }
+
+        if (index && children != indexed)
+        {
+            ReportIndexMismatch("GetChildren", directoryPath);
+        }
+
+        return children;
+    }
+
+    std::vector<BlobAttributes> BlobFilesystemImpl::GetChildrenFileAttributes(const std::string& directoryPath)
+    {
+        EnsureLiveness();
+
+        const auto [prefix, realPath] = StorageAccount::StripPrefix(directoryPath);
+        const auto index = FindIndex(prefix, realPath);
+        std::vector<BlobAttributes> indexed;
+        if (index)
+        {
+            for (const auto& [blobName, entry] : index->List(realPath))
+            {
+                const auto size = entry.Size ? *entry.Size : BlobHelpers::GetFileSize(GetContainer(prefix, blobName).GetPageBlobClient(ResolveBlob(prefix, blobName)));
+                indexed.emplace_back(size, blobName.substr(realPath.length()));
             }
 
-            if (!blobs.NextPageToken.HasValue())
+            if (m_options.NamespaceIndexing == NamespaceIndexMode::Authoritative)
             {
-                break;
+                return indexed;
+            }
+        }
+
+        std::vector<BlobAttributes> attributes;
+
+        // Sizes come from the metadata returned with the listing, so there is no request per blob.
+        ::Azure::Storage::Blobs::ListBlobsOptions opts;
+        opts.Prefix = realPath;
+        opts.PageSizeHint = 5000; // the most a single page returns
+        opts.Include = ::Azure::Storage::Blobs::Models::ListBlobsIncludeFlags::Metadata;
+
+        // Process all pages of results, fetching the next page while the current one is processed
+        auto* pool = GetBlobPool(prefix, false);
+        auto* stripes = GetStripes(prefix);
+        bool aliased = false;
+        for (size_t stripe = 0; stripe < StripeCount(prefix); ++stripe)
+        {
+            const auto& container = GetStripeContainer(prefix, stripe);
+            auto* deletions = GetDeletionQueue(prefix, false, stripe);
+            opts.ContinuationToken.Reset();
+            auto blobs = container.ListBlobs(opts);
+            while (true)
+            {
+                std::future<::Azure::Storage::Blobs::ListBlobsPagedResponse> nextPage;
+                if (blobs.NextPageToken.HasValue())
+                {
+                    opts.ContinuationToken = blobs.NextPageToken;
+                    nextPage = std::async(std::launch::async, [&container, opts]() { return container.ListBlobs(opts); });
+                }
+
+                for (const auto& blob : blobs.Blobs)
+                {
+                    if ((pool && pool->Contains(blob.Name)) || (deletions && deletions->Contains(blob.Name)))
+                    {
+                        continue;
+                    }
+
+                    if (stripes)
+                    {
+                        stripes->RecordListed(blob.Name, stripe);
+                        if (stripes->Locate(blob.Name) != stripe)
+                        {
+                            continue;
+                        }
+                    }
+
+                    const auto fileName = ListedFileName(prefix, blob);
+                    aliased = aliased || fileName != blob.Name;
+                    attributes.emplace_back(BlobHelpers::GetFileSize(blob), fileName.substr(realPath.length()));
+                }
+
+                if (!nextPage.valid())
+                {
+                    break;
+                }
+
+                blobs = nextPage.get();
             }
+        }
 
-            opts.ContinuationToken = blobs.NextPageToken;
-            blobs = container.ListBlobs(opts);
-        } while (true);
+        if (stripes || aliased)
+        {
+            // Each stripe is listed in name order on its own, and recycled blobs in the order of their own names.
+            std::ranges::sort(attributes, {}, &BlobAttributes::GetName);
+        }
+
+        if (index && !std::ranges::equal(attributes, indexed, [](const auto& lhs, const auto& rhs)
+            {
+                return lhs.GetSize() == rhs.GetSize() && lhs.GetName() == rhs.GetName();
+            }))
+        {
+            ReportIndexMismatch("GetChildrenFileAttributes", directoryPath);
+        }
 
         return attributes;
     }
@@ -509,9 +1047,10 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         EnsureLiveness();
 
         const auto [prefix, realPath] = StorageAccount::StripPrefix(filePath);
-        const auto& container = GetContainer(prefix);
-        const auto client = container.GetPageBlobClient(std::string(realPath));
-        const auto res = client.DeleteIfExists();
+        if (auto* pool = GetBlobPool(prefix, false))
+        {
+            pool->Forget(realPath);
+        }
 
         auto cache = m_fileCaches.find(prefix);
         if (cache != m_fileCaches.end())
@@ -519,6 +1058,46 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
             cache->second->RemoveFile(realPath);
         }
 
+        m_smallFiles->Remove(filePath);
+        const auto index = FindIndex(prefix, realPath);
+        const auto stripe = LocateStripe(prefix, realPath);
+        if (auto* stripes = GetStripes(prefix))
+        {
+            stripes->Forget(realPath);
+        }
+
+        auto* aliases = GetAliases(prefix, false);
+        if (aliases && aliases->IsRecycled(realPath))
+        {
+            // The blob was recycled for another WAL, which mustn't go with it.
+            return false;
+        }
+
+        const auto blobName = aliases ? aliases->Forget(realPath).value_or(std::string(realPath)) : std::string(realPath);
+
+        if (m_options.AsyncDelete)
+        {
+            // The file is hidden from now on and the blob goes in a later batch. Inside a locked directory the
+            // index knows whether it existed, elsewhere one properties call tells before anything is queued.
+            auto* queue = GetDeletionQueue(prefix, true, stripe);
+            if (index ? !index->Remove(realPath) :
+                queue->Contains(blobName) || !BlobExists(GetStripeContainer(prefix, stripe).GetBlobClient(blobName)))
+            {
+                return false;
+            }
+
+            queue->Enqueue(blobName);
+            return true;
+        }
+
+        const auto& container = GetStripeContainer(prefix, stripe);
+        const auto client = container.GetPageBlobClient(blobName);
+        const auto res = client.DeleteIfExists();
+        if (index)
+        {
+            index->Remove(realPath);
+        }
+
         return res.Value.Deleted;
     }
 
@@ -527,51 +1106,65 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         EnsureLiveness();
 
         const auto [prefix, realPath] = StorageAccount::StripPrefix(directoryPath);
-        const auto& container = GetContainer(prefix);
+        m_smallFiles->RemovePrefix(directoryPath);
 
         ::Azure::Storage::Blobs::ListBlobsOptions options;
         // "" represent the root directory, so we would want to delete everything in the blob container.
         // append "/" in other cases in the event that we have a file with the same name as a directory.
         options.Prefix = realPath == "" ? realPath : std::string(realPath) + "/";
 
-        auto blobsInDirectory = container.ListBlobs(options);
-        std::vector<std::string> blobs;
-        for (const auto& blob : blobsInDirectory.Blobs)
-        {
-            blobs.push_back(blob.Name);
-        }
-
-        // ListBlobs by default returns a maximum of 5000 blobs. Next page of blobs can be obtained with the NextPageToken
-        options.ContinuationToken = blobsInDirectory.NextPageToken;
-        while (blobsInDirectory.NextPageToken.HasValue())
+        size_t failed = 0;
+        for (size_t stripe = 0; stripe < StripeCount(prefix); ++stripe)
         {
-            blobsInDirectory = container.ListBlobs(options);
+            const auto& container = GetStripeContainer(prefix, stripe);
+            options.ContinuationToken.Reset();
+            auto blobsInDirectory = container.ListBlobs(options);
+            std::vector<std::string> blobs;
             for (const auto& blob : blobsInDirectory.Blobs)
             {
                 blobs.push_back(blob.Name);
             }
+
+            // ListBlobs by default returns a maximum of 5000 blobs. Next page of blobs can be obtained with the NextPageToken
             options.ContinuationToken = blobsInDirectory.NextPageToken;
+            while (blobsInDirectory.NextPageToken.HasValue())
+            {
+                blobsInDirectory = container.ListBlobs(options);
+                for (const auto& blob : blobsInDirectory.Blobs)
+                {
+                    blobs.push_back(blob.Name);
+                }
+                options.ContinuationToken = blobsInDirectory.NextPageToken;
+            }
+
+            // Batches are submitted concurrently and every deletion's result is checked, so the blobs that
+            // couldn't be deleted are known without listing the directory again.
+            failed += GetDeletionQueue(prefix, true, stripe)->DeleteNow(blobs);
         }
 
-        // According to Blob Batch API maximum number of subrequests in a batch is 256.
-        // https://learn.microsoft.com/en-us/rest/api/storageservices/blob-batch?tabs=microsoft-entra-id#remarks
-        const int maxBatchSize = 256;
-        for (size_t i = 0; i < blobs.size(); i += maxBatchSize)
+        if (auto* stripes = GetStripes(prefix))
         {
-            auto batch = container.CreateBatch();
-            for (size_t j = i; j < i + maxBatchSize && j < blobs.size(); j++)
+            stripes->ForgetPrefix(options.Prefix.Value());
+        }
+
+        if (auto* aliases = GetAliases(prefix, false))
+        {
+            aliases->ForgetPrefix(options.Prefix.Value());
+        }
+
+        {
+            // The directory may also be a parent of a locked one.
+            std::scoped_lock lock(m_indexesMutex);
+            for (const auto& indexed : m_indexes)
             {
-                batch.DeleteBlob(blobs[j]);
+                if (indexed.Prefix == prefix)
+                {
+                    indexed.Index->RemovePrefix(options.Prefix.Value());
+                }
             }
-            container.SubmitBatch(batch);
         }
 
-        options.ContinuationToken = "";
-
-        // Listing blobs to ensure everything is deleted.
-        // From testing the response from SubmitBatch doesn't appear to give any other status aside from a 202 Accepted.
-        blobsInDirectory = container.ListBlobs(options);
-        return blobsInDirectory.Blobs.size();
+        return failed;
     }
 
     void BlobFilesystemImpl::Truncate(const std::string& filePath, int64_t size) const
@@ -579,14 +1172,20 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         EnsureLiveness();
 
         const auto [prefix, realPath] = StorageAccount::StripPrefix(filePath);
-        const auto& container = GetContainer(prefix);
+        SettleDeletion(prefix, realPath);
+        const auto& container = GetContainer(prefix, realPath);
 
-        const auto client = container.GetPageBlobClient(std::string(realPath));
+        const auto blobName = ResolveBlob(prefix, realPath);
+        const auto client = container.GetPageBlobClient(blobName);
         const auto fileSize = BlobHelpers::GetFileSize(client);
         if (fileSize > size)
         {
-            BlobHelpers::SetFileSize(client, size);
+            BlobHelpers::SetFileSize(client, size, blobName != realPath ? realPath : std::string_view{});
             client.Resize(size);
+            if (auto index = FindIndex(prefix, realPath))
+            {
+                index->Update(realPath, size, PosixNow());
+            }
         }
     }
 
@@ -595,10 +1194,23 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         EnsureLiveness();
 
         const auto [prefix, realPath] = StorageAccount::StripPrefix(filePath);
-        const auto& container = GetContainer(prefix);
+        const auto& container = GetContainer(prefix, realPath);
+
+        const auto index = FindIndex(prefix, realPath);
+        const auto entry = index ? index->Find(realPath) : std::nullopt;
+        if (entry && entry->Size && m_options.NamespaceIndexing == NamespaceIndexMode::Authoritative)
+        {
+            return *entry->Size;
+        }
+
+        const auto client = container.GetPageBlobClient(ResolveBlob(prefix, realPath));
+        const auto size = BlobHelpers::GetFileSize(client);
+        if (entry && entry->Size && *entry->Size != size)
+        {
+            ReportIndexMismatch("GetFileSize", filePath);
+        }
 
-        const auto client = container.GetPageBlobClient(std::string(realPath));
-        return BlobHelpers::GetFileSize(client);
+        return size;
     }
 
     uint64_t BlobFilesystemImpl::GetFileModificationTime(const std::string& filePath) const
@@ -606,12 +1218,28 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         EnsureLiveness();
 
         const auto [prefix, realPath] = StorageAccount::StripPrefix(filePath);
-        const auto& container = GetContainer(prefix);
+        const auto& container = GetContainer(prefix, realPath);
+        const auto index = FindIndex(prefix, realPath);
+        const auto entry = index ? index->Find(realPath) : std::nullopt;
+        if (entry && entry->Size && m_options.NamespaceIndexing == NamespaceIndexMode::Authoritative)
+        {
+            return entry->ModifiedTime;
+        }
 
-        const auto client = container.GetPageBlobClient(std::string(realPath));
+        const auto client = container.GetPageBlobClient(ResolveBlob(prefix, realPath));
         const auto props = client.GetProperties();
         const auto& modifiedTime = props.Value.LastModified;
-        return static_cast<uint64_t>(::Azure::Core::_internal::PosixTimeConverter::DateTimeToPosixTime(modifiedTime));
+        const auto posixTime = static_cast<uint64_t>(::Azure::Core::_internal::PosixTimeConverter::DateTimeToPosixTime(modifiedTime));
+        if (entry && entry->Size)
+        {
+            const auto difference = posixTime > entry->ModifiedTime ? posixTime - entry->ModifiedTime : entry->ModifiedTime - posixTime;
+            if (difference > static_cast<uint64_t>(Configuration::NamespaceIndex::ModifiedTimeTolerance.count()))
+            {
+                ReportIndexMismatch("GetFileModificationTime", filePath);
+            }
+        }
+
+        return posixTime;
     }
 
     size_t BlobFilesystemImpl::GetLeaseClientCount()
@@ -622,101 +1250,282 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         return m_locks.size();
     }
 
-    void BlobFilesystemImpl::RenameFile(const std::string& fromFilePath, const std::string& toFilePath) const
+    Core::FileCacheMetrics::Snapshot BlobFilesystemImpl::GetFileCacheMetrics() const
     {
-        EnsureLiveness();
-
-        const auto [prefixAccountFrom, realPathFrom] = StorageAccount::StripPrefix(fromFilePath);
-        const auto [prefixAccountTo, realPathTo] = StorageAccount::StripPrefix(toFilePath);
-        if (prefixAccountFrom != prefixAccountTo)
+        std::vector<Core::FileCache*> caches;
+        for (const auto& [_, cache] : m_fileCaches)
         {
-            throw std::runtime_error("Attempting to rename file into another storage account");
+            caches.push_back(cache.get());
         }
 
-        if (realPathFrom == realPathTo)
+        return Core::FileCache::CombineMetrics(caches);
+    }
+
+    std::vector<Core::FileCache::EntryInfo> BlobFilesystemImpl::GetFileCacheEntries() const
+    {
+        std::vector<Core::FileCache::EntryInfo> entries;
+        for (const auto& [prefix, cache] : m_fileCaches)
         {
-            // Nothing to do - file is already at the destination
-            return;
+            for (auto& entry : cache->GetEntries())
+            {
+                entry.FilePath = prefix + "/" + entry.FilePath;
+                entries.push_back(std::move(entry));
+            }
         }
 
-        const auto& container = GetContainer(prefixAccountTo);
+        return entries;
+    }
 
-        const auto srcClient = container.GetPageBlobClient(std::string(realPathFrom));
-        const auto destClient = container.GetPageBlobClient(std::string(realPathTo));
+    size_t BlobFilesystemImpl::RebalanceStripes(const std::string& directoryPath)
+    {
+        EnsureLiveness();
 
-        // TODO: Check if there is already a file with this name
-        const auto size = BlobHelpers::GetFileSize(srcClient);
-        const auto cap = BlobHelpers::GetBlobCapacity(srcClient);
-        destClient.CreateIfNotExists(static_cast<int64_t>(cap));
-        ::Azure::Storage::Blobs::DownloadBlobOptions opt;
-        opt.Range.Emplace(0, size);
-        const auto downloadResponse = srcClient.Download(opt);
-        const auto& content = downloadResponse.Value;
+        const auto [prefix, realPath] = StorageAccount::StripPrefix(directoryPath);
+        auto* stripes = GetStripes(prefix);
+        if (!stripes)
+        {
+            return 0;
+        }
 
-        static const constexpr auto maxUploadSize = static_cast<int64_t>(4) * 1024 * 1024;
-        if (size > maxUploadSize)
+        struct Listed
         {
-            int64_t uploadOffset = 0;
-            std::vector<uint8_t> buffer(static_cast<size_t>(maxUploadSize));
+            std::string Name;
+            size_t Stripe;
+            int64_t BlobSize;
+            ::Azure::ETag ETag;
+        };
 
-            while (uploadOffset != size)
+        // Every stripe is listed before anything moves, so a file left on two stripes by an interrupted
+        // rebalance is known to be on both and the complete copy is the one moved.
+        ::Azure::Storage::Blobs::ListBlobsOptions options;
+        options.Prefix = realPath == "" ? realPath : std::string(realPath) + "/";
+        std::vector<Listed> listed;
+        auto* pool = GetBlobPool(prefix, false);
+        for (size_t stripe = 0; stripe < stripes->Size(); ++stripe)
+        {
+            const auto& container = GetStripeContainer(prefix, stripe);
+            auto* deletions = GetDeletionQueue(prefix, false, stripe);
+            options.ContinuationToken.Reset();
+            auto blobs = container.ListBlobs(options);
+            do
             {
-                assert(size > uploadOffset);
-                const auto readSize = std::min(size - uploadOffset, maxUploadSize);
-                const auto bytesRead = content.BodyStream->ReadToCount(buffer.data(), static_cast<size_t>(readSize));
-                const auto bytesRemaining = bytesRead % Configuration::PageBlob::PageSize;
-
-                if (bytesRemaining != 0)
+                for (const auto& blob : blobs.Blobs)
                 {
-                    const auto padding = Configuration::PageBlob::PageSize - bytesRemaining;
-
-                    const auto endOfRealData = bytesRead;
-                    const auto endOfUpload = bytesRead + padding;
-                    std::fill(buffer.data() + endOfRealData, buffer.data() + endOfUpload, static_cast<uint8_t>(0));
+                    if ((stripe == 0 && pool && pool->Contains(blob.Name)) || (deletions && deletions->Contains(blob.Name)))
+                    {
+                        continue;
+                    }
 
-                    ::Azure::Core::IO::MemoryBodyStream sendStream(buffer.data(), endOfUpload);
-                    destClient.UploadPages(uploadOffset, sendStream);
+                    stripes->RecordListed(blob.Name, stripe);
+                    listed.push_back(Listed{ blob.Name, stripe, blob.BlobSize, blob.Details.ETag });
                 }
-                else
+
+                if (!blobs.NextPageToken.HasValue())
                 {
-                    ::Azure::Core::IO::MemoryBodyStream sendStream(buffer.data(), bytesRead);
-                    destClient.UploadPages(uploadOffset, sendStream);
+                    break;
                 }
 
-                uploadOffset += static_cast<int64_t>(bytesRead);
+                options.ContinuationToken = blobs.NextPageToken;
+                blobs = container.ListBlobs(options);
+            } while (true);
+        }
+
+        size_t moved = 0;
+        for (const auto& file : listed)
+        {
+            const auto target = stripes->Place(file.Name);
+            if (target == file.Stripe || stripes->Locate(file.Name) != file.Stripe)
+            {
+                continue;
+            }
+
+            // Blob storage copies the blob with its type and metadata, also between storage accounts. The copy only
+            // succeeds from the blob as it was listed, and until it is verified the file is found on its old stripe.
+            ::Azure::Storage::Blobs::StartBlobCopyFromUriOptions copyOptions;
+            copyOptions.SourceAccessConditions.IfMatch = file.ETag;
+            const auto targetClient = GetStripeContainer(prefix, target).GetBlobClient(file.Name);
+            const auto properties = CopyBlob(targetClient, GetCopySource(prefix, file.Stripe).Url(file.Name), file.Name, file.Name, copyOptions);
+            if (properties.BlobSize != file.BlobSize)
+            {
+                throw std::runtime_error("Copy of '" + file.Name + "' to its stripe has " + std::to_string(properties.BlobSize) +
+                    " bytes instead of " + std::to_string(file.BlobSize));
             }
+
+            // Readers that opened the file on its old stripe may still be reading, so the old blob goes with the
+            // stripe's background deletions instead of right away.
+            stripes->Record(file.Name, target);
+            GetDeletionQueue(prefix, true, file.Stripe)->Enqueue(file.Name);
+            ++moved;
         }
-        else
+
+        BOOST_LOG_SEV(*m_logger, severity_level::info) << "Moved " << moved << " files of '" << directoryPath << "' to their stripes";
+        return moved;
+    }
+
+    void BlobFilesystemImpl::RenameFile(const std::string& fromFilePath, const std::string& toFilePath) const
+    {
+        EnsureLiveness();
+
+        const auto [prefixAccountFrom, realPathFrom] = StorageAccount::StripPrefix(fromFilePath);
+        const auto [prefixAccountTo, realPathTo] = StorageAccount::StripPrefix(toFilePath);
+        if (prefixAccountFrom != prefixAccountTo)
+        {
+            throw std::runtime_error("Attempting to rename file into another storage account");
+        }
+
+        if (realPathFrom == realPathTo)
+        {
+            // Nothing to do - file is already at the destination
+            return;
+        }
+
+        SettleDeletion(prefixAccountTo, realPathTo);
+        DropAlias(prefixAccountTo, realPathTo);
+
+        // The copy stays in the source's container, where it is found by name until a rebalance moves it.
+        const auto stripe = LocateStripe(prefixAccountFrom, realPathFrom);
+        const auto& container = GetStripeContainer(prefixAccountTo, stripe);
+        if (auto* pool = GetBlobPool(prefixAccountTo, false))
         {
-            auto buffer = content.BodyStream->ReadToEnd();
+            pool->Forget(realPathTo);
+        }
 
-            // this must be aligned to page size so in some cases need dummy data
-            const auto remaining = buffer.size() % Configuration::PageBlob::PageSize;
-            if (remaining != 0)
+        if (GetProfile(Core::RocksDBHelpers::GetFileType(realPathTo)).BlobType == BlobKind::OneShot)
+        {
+            if (auto entry = m_smallFiles->Find(fromFilePath))
             {
-                const auto padding = Configuration::PageBlob::PageSize - remaining;
-                buffer.resize(buffer.size() + padding);
+                RenameSmallFile(container, std::move(*entry), fromFilePath, realPathFrom, toFilePath, realPathTo);
+                RenameInIndex(prefixAccountTo, realPathFrom, realPathTo);
+                return;
+            }
+        }
 
-                const auto endOfRealData = buffer.size() - padding;
-                std::fill(buffer.data() + endOfRealData, buffer.data() + buffer.size(), static_cast<uint8_t>(0));
+        // The data, blob type and metadata, including the file size, are copied by blob storage without passing
+        // through this host, so the time taken doesn't depend on the size of the file. Blob storage reads the
+        // source with a SAS, the credential of this host doesn't authorize it to.
+        const auto srcBlobName = ResolveBlob(prefixAccountFrom, realPathFrom);
+        const auto srcClient = container.GetBlobClient(srcBlobName);
+        const auto destClient = container.GetBlobClient(std::string(realPathTo));
+        auto& source = GetCopySource(prefixAccountTo, stripe);
+        try
+        {
+            CopyBlob(destClient, source.Url(srcBlobName), srcBlobName, realPathTo);
+        }
+        catch (const ::Azure::Storage::StorageException& ex)
+        {
+            if (ex.ErrorCode != "InvalidBlobType")
+            {
+                throw;
             }
 
-            ::Azure::Core::IO::MemoryBodyStream sendStream(buffer);
-            destClient.UploadPages(0, sendStream);
+            ReplaceWithOtherType(container, source, srcClient, srcBlobName, realPathTo);
+        }
+
+        if (srcBlobName != realPathFrom)
+        {
+            // The copy of a recycled WAL is held by a blob of its own name, so the name copied with the metadata goes.
+            const auto destPageClient = destClient.AsPageBlobClient();
+            BlobHelpers::SetFileSize(destPageClient, BlobHelpers::GetFileSize(destPageClient));
+            GetAliases(prefixAccountFrom, false)->Forget(realPathFrom);
         }
 
-        BlobHelpers::SetFileSize(destClient, size);
         srcClient.DeleteIfExists();
+        m_smallFiles->Remove(fromFilePath);
+        m_smallFiles->Remove(toFilePath);
+        if (auto* stripes = GetStripes(prefixAccountTo))
+        {
+            stripes->Forget(realPathFrom);
+            stripes->Record(realPathTo, stripe);
+        }
+
+        RenameInIndex(prefixAccountTo, realPathFrom, realPathTo);
     }
 
-    BlobFilesystemImpl::BlobFilesystemImpl(std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>>&& logger, int64_t dataFileInitialSize, int64_t dataFileBufferSize)
+    void BlobFilesystemImpl::ReplaceWithOtherType(const ::Azure::Storage::Blobs::BlobContainerClient& container,
+        CopySource& source,
+        const ::Azure::Storage::Blobs::BlobClient& srcClient,
+        const std::string_view realPathFrom,
+        const std::string_view realPathTo) const
+    {
+        // A copy can't change the type of an existing blob, and the destination, such as CURRENT, must not go
+        // missing while it is replaced.
+        const auto destClient = container.GetBlobClient(std::string(realPathTo));
+        if (srcClient.GetProperties().Value.BlobType == ::Azure::Storage::Blobs::Models::BlobType::BlockBlob)
+        {
+            // Put Blob From URL replaces a blob of any type in one request, and a block blob's length is its size.
+            destClient.AsBlockBlobClient().UploadFromUri(source.Url(std::string(realPathFrom)));
+            return;
+        }
+
+        // Page and append blobs keep their type and size metadata only through a copy, which needs the old blob
+        // deleted first. The data is copied under a temporary name before that, so only a copy within the
+        // container runs while the destination is missing, and the file is still there to retry with if it fails.
+        const auto tempPath = std::string(realPathTo).append(g_renameSuffix);
+        const auto tempClient = container.GetBlobClient(tempPath);
+        tempClient.DeleteIfExists();
+        CopyBlob(tempClient, source.Url(std::string(realPathFrom)), realPathFrom, tempPath);
+        BOOST_LOG_SEV(*m_logger, severity_level::debug) << "Replacing '" << realPathTo << "' with a blob of another type";
+        destClient.DeleteIfExists();
+        CopyBlob(destClient, source.Url(tempPath), tempPath, realPathTo);
+        tempClient.DeleteIfExists();
+    }
+
+    void BlobFilesystemImpl::RenameSmallFile(const ::Azure::Storage::Blobs::BlobContainerClient& container,
+        SmallFileCache::Entry entry,
+        const std::string& fromFilePath,
+        const std::string_view realPathFrom,
+        const std::string& toFilePath,
+        const std::string_view realPathTo) const
+    {
+        // Temporary files are written by the process holding the database lock, so the copy this process
+        // wrote is current and is uploaded under the new name instead of being copied by blob storage.
+        // Put Blob replaces the destination whatever its type, and its length is the file size.
+        const auto destClient = container.GetBlockBlobClient(std::string(realPathTo));
+        ::Azure::Core::IO::MemoryBodyStream dataStream(reinterpret_cast<const uint8_t*>(entry.Contents.data()), entry.Contents.size());
+        entry.ETag = destClient.Upload(dataStream).Value.ETag;
+        container.GetBlobClient(std::string(realPathFrom)).DeleteIfExists();
+
+        m_smallFiles->Remove(fromFilePath);
+        m_smallFiles->Put(toFilePath, std::move(entry));
+    }
+
+    BlobFilesystemImpl::BlobFilesystemImpl(std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>>&& logger, int64_t dataFileInitialSize, int64_t dataFileBufferSize, FilesystemOptions options)
         : m_logger(std::move(logger)),
         m_dataFileInitialSize(dataFileInitialSize),
         m_dataFileBufferSize(dataFileBufferSize),
+        m_options(std::move(options)),
+        m_profiles(ResolveProfiles(dataFileInitialSize, dataFileBufferSize, m_options)),
+        m_smallFiles(std::make_shared<SmallFileCache>()),
         m_lockRenewalThread{ [this](std::stop_token stopToken) { RenewLease(stopToken); } }
     {
     }
 
+    void BlobFilesystemImpl::AddFileCache(const std::string& uniquePrefix,
+        const ::Azure::Storage::Blobs::BlobContainerClient& containerClient,
+        std::string_view cachePath,
+        size_t maxCacheSize)
+    {
+        auto filesystem = std::make_shared<Core::LocalFilesystem>(m_logger);
+        std::shared_ptr<Core::SharedFileCacheIndex> sharedIndex;
+        std::string keyPrefix;
+        if (m_options.SharedFileCache)
+        {
+            sharedIndex = Core::SharedFileCacheIndex::Open(cachePath, static_cast<int64_t>(maxCacheSize), filesystem, m_logger);
+            keyPrefix = uniquePrefix;
+        }
+
+        m_fileCaches.emplace(uniquePrefix,
+            std::make_shared<Core::FileCache>(cachePath,
+                static_cast<int64_t>(maxCacheSize),
+                m_stripeSets.contains(uniquePrefix)
+                    ? std::shared_ptr<Core::ContainerClient>(std::make_shared<StripedContainerClient>(m_stripeSets.at(uniquePrefix)))
+                    : std::make_shared<AzureContainerClient>(containerClient),
+                std::move(filesystem),
+                m_logger,
+                std::move(sharedIndex),
+                std::move(keyPrefix)));
+    }
+
     const::Azure::Storage::Blobs::BlobContainerClient& BlobFilesystemImpl::GetContainer(const std::string_view prefix) const
     {
         // TODO: Future work to determine health of this client. Seeing that repeated 503s/403s caused successive calls to fail with the same error.
@@ -733,6 +1542,355 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         }
     }
 
+    const ::Azure::Storage::Blobs::BlobContainerClient& BlobFilesystemImpl::GetContainer(const std::string_view prefix, const std::string_view realPath) const
+    {
+        return GetStripeContainer(prefix, LocateStripe(prefix, realPath));
+    }
+
+    void BlobFilesystemImpl::AddStripes(const std::string& uniquePrefix,
+        ::Azure::Storage::Blobs::BlobServiceClient& serviceClient,
+        const ::Azure::Storage::Blobs::BlobContainerClient& containerClient,
+        const std::string& storageAccountUrl,
+        const std::function<::Azure::Storage::Blobs::BlobServiceClient(const std::string&)>& connect)
+    {
+        if (m_options.Stripes.empty())
+        {
+            return;
+        }
+
+        std::vector<StripeSet::Stripe> stripes;
+        std::vector<std::shared_ptr<CopySource>> sources;
+        stripes.push_back(StripeSet::Stripe{ uniquePrefix, containerClient, true });
+        sources.push_back(nullptr); // The primary's is kept with its clients.
+        for (const auto& target : m_options.Stripes)
+        {
+            // Stripes are named like database prefixes, so the name stays the same whichever container is the primary.
+            if (target.StorageAccountUrl.empty())
+            {
+                stripes.push_back(StripeSet::Stripe{ StorageAccount::UniquePrefix(storageAccountUrl, target.ContainerName),
+                    BlobHelpers::GetContainerClient(serviceClient, target.ContainerName),
+                    target.AcceptsNewFiles });
+                sources.push_back(std::make_shared<CopySource>(serviceClient, stripes.back().Container));
+            }
+            else
+            {
+                auto stripeServiceClient = connect(target.StorageAccountUrl);
+                stripes.push_back(StripeSet::Stripe{ StorageAccount::UniquePrefix(target.StorageAccountUrl, target.ContainerName),
+                    BlobHelpers::GetContainerClient(stripeServiceClient, target.ContainerName),
+                    target.AcceptsNewFiles });
+                sources.push_back(std::make_shared<CopySource>(std::move(stripeServiceClient), stripes.back().Container));
+            }
+
+            if (stripes.back().Name == uniquePrefix)
+            {
+                throw std::invalid_argument("The database's own container can't be added as a stripe");
+            }
+        }
+
+        BOOST_LOG_SEV(*m_logger, severity_level::info) << "Striping SST and blob files of '" << uniquePrefix << "' over " << stripes.size() << " containers";
+        m_stripeSets.emplace(uniquePrefix, std::make_shared<StripeSet>(std::move(stripes)));
+        m_stripeSources.emplace(uniquePrefix, std::move(sources));
+    }
+
+    StripeSet* BlobFilesystemImpl::GetStripes(const std::string_view prefix) const
+    {
+        const auto stripes = m_stripeSets.find(prefix);
+        return stripes != m_stripeSets.end() ? stripes->second.get() : nullptr;
+    }
+
+    size_t BlobFilesystemImpl::StripeCount(const std::string_view prefix) const
+    {
+        const auto* stripes = GetStripes(prefix);
+        return stripes ? stripes->Size() : 1;
+    }
+
+    const ::Azure::Storage::Blobs::BlobContainerClient& BlobFilesystemImpl::GetStripeContainer(const std::string_view prefix, const size_t stripe) const
+    {
+        // The primary stripe is the database's own container.
+        return stripe == 0 ? GetContainer(prefix) : GetStripes(prefix)->Get(stripe).Container;
+    }
+
+    CopySource& BlobFilesystemImpl::GetCopySource(const std::string_view prefix, const size_t stripe) const
+    {
+        if (stripe != 0)
+        {
+            return *m_stripeSources.find(prefix)->second.at(stripe);
+        }
+
+        const auto client = m_clients.find(prefix);
+        if (client == m_clients.end())
+        {
+            throw std::runtime_error("Client not found for '" + std::string(prefix) + "'");
+        }
+
+        return *client->second.Source;
+    }
+
+    size_t BlobFilesystemImpl::LocateStripe(const std::string_view prefix, const std::string_view realPath) const
+    {
+        const auto* stripes = GetStripes(prefix);
+        return stripes ? stripes->Locate(realPath) : 0;
+    }
+
+    size_t BlobFilesystemImpl::PlaceFile(const std::string_view prefix, const std::string_view realPath) const
+    {
+        auto* stripes = GetStripes(prefix);
+        if (!stripes)
+        {
+            return 0;
+        }
+
+        const auto stripe = stripes->Place(realPath);
+        stripes->Record(realPath, stripe);
+        return stripe;
+    }
+
+    const FileProfile& BlobFilesystemImpl::GetProfile(const Core::RocksDBHelpers::FileClass fileType) const
+    {
+        return m_profiles.at(fileType);
+    }
+
+    std::shared_ptr<Core::FileCache> BlobFilesystemImpl::GetFileCache(const std::string_view prefix, const FileProfile& profile) const
+    {
+        if (!profile.Cacheable)
+        {
+            return nullptr;
+        }
+
+        const auto cache = m_fileCaches.find(prefix);
+        return cache != m_fileCaches.end() ? cache->second : nullptr;
+    }
+
+    BlobPool* BlobFilesystemImpl::GetBlobPool(const std::string_view prefix, const bool create) const
+    {
+        if (m_options.BlobPoolDepth <= 0)
+        {
+            return nullptr;
+        }
+
+        // Pools start with the first file created, so processes that only read never run one.
+        std::scoped_lock lock(m_blobPoolsMutex);
+        auto pool = m_blobPools.find(prefix);
+        if (pool == m_blobPools.end())
+        {
+            if (!create)
+            {
+                return nullptr;
+            }
+
+            pool = m_blobPools.emplace(std::string(prefix),
+                std::make_unique<BlobPool>(GetContainer(prefix), m_options.BlobPoolDepth, m_dataFileInitialSize, m_logger)).first;
+        }
+
+        return pool->second.get();
+    }
+
+    DeletionQueue* BlobFilesystemImpl::GetDeletionQueue(const std::string_view prefix, const bool create, const size_t stripe) const
+    {
+        // Each stripe has its own queue, since a batch only deletes from one container.
+        const auto key = stripe == 0 ? prefix : std::string_view(GetStripes(prefix)->Get(stripe).Name);
+        std::scoped_lock lock(m_deletionQueuesMutex);
+        auto deletions = m_deletionQueues.find(key);
+        if (deletions == m_deletionQueues.end())
+        {
+            if (!create)
+            {
+                return nullptr;
+            }
+
+            deletions = m_deletionQueues.emplace(std::string(key),
+                std::make_unique<DeletionQueue>(GetStripeContainer(prefix, stripe), Configuration::Deletion::Concurrency, m_logger)).first;
+        }
+
+        return deletions->second.get();
+    }
+
+    void BlobFilesystemImpl::SettleDeletion(const std::string_view prefix, const std::string_view realPath) const
+    {
+        if (auto* deletions = GetDeletionQueue(prefix, false, LocateStripe(prefix, realPath)))
+        {
+            deletions->Settle(realPath);
+        }
+    }
+
+    BlobAliases* BlobFilesystemImpl::GetAliases(const std::string_view prefix, const bool create) const
+    {
+        std::scoped_lock lock(m_aliasesMutex);
+        auto aliases = m_aliases.find(prefix);
+        if (aliases == m_aliases.end())
+        {
+            if (!create)
+            {
+                return nullptr;
+            }
+
+            aliases = m_aliases.emplace(std::string(prefix), std::make_unique<BlobAliases>()).first;
+        }
+
+        return aliases->second.get();
+    }
+
+    std::string BlobFilesystemImpl::ResolveBlob(const std::string_view prefix, const std::string_view realPath) const
+    {
+        const auto* aliases = GetAliases(prefix, false);
+        return aliases ? aliases->Resolve(realPath) : std::string(realPath);
+    }
+
+    std::string BlobFilesystemImpl::ListedFileName(const std::string_view prefix, const ::Azure::Storage::Blobs::Models::BlobItem& blob) const
+    {
+        auto fileName = BlobHelpers::GetFileName(blob);
+        if (fileName != blob.Name)
+        {
+            GetAliases(prefix, true)->Record(fileName, blob.Name);
+        }
+
+        return fileName;
+    }
+
+    void BlobFilesystemImpl::DropAlias(const std::string_view prefix, const std::string_view realPath) const
+    {
+        auto* aliases = GetAliases(prefix, false);
+        if (auto blobName = aliases ? aliases->Forget(realPath) : std::nullopt)
+        {
+            // Recycled blobs are WALs, which always stay in the primary container.
+            GetDeletionQueue(prefix, true)->Enqueue(*blobName);
+        }
+    }
+
+    void BlobFilesystemImpl::LoadNamespaceIndex(const std::string_view prefix, const std::string_view lockPath, const LockFileImpl& lockFile)
+    {
+        const auto separator = lockPath.rfind('/');
+        auto index = std::make_shared<NamespaceIndex>(std::string(separator == std::string_view::npos ? std::string_view{} : lockPath.substr(0, separator)));
+
+        // One listing with metadata gives every file's size, the same way GetChildrenFileAttributes reads them.
+        ::Azure::Storage::Blobs::ListBlobsOptions opts;
+        opts.Prefix = index->ListingPrefix();
+        opts.PageSizeHint = 5000; // the most a single page returns
+        opts.Include = ::Azure::Storage::Blobs::Models::ListBlobsIncludeFlags::Metadata;
+
+        auto* pool = GetBlobPool(prefix, false);
+        auto* stripes = GetStripes(prefix);
+        size_t files = 0;
+        for (size_t stripe = 0; stripe < StripeCount(prefix); ++stripe)
+        {
+            const auto& container = GetStripeContainer(prefix, stripe);
+            auto* deletions = GetDeletionQueue(prefix, false, stripe);
+            opts.ContinuationToken.Reset();
+            auto blobs = container.ListBlobs(opts);
+            do
+            {
+                for (const auto& blob : blobs.Blobs)
+                {
+                    if ((pool && pool->Contains(blob.Name)) || (deletions && deletions->Contains(blob.Name)))
+                    {
+                        continue;
+                    }
+
+                    if (stripes)
+                    {
+                        stripes->RecordListed(blob.Name, stripe);
+                        if (stripes->Locate(blob.Name) != stripe)
+                        {
+                            continue;
+                        }
+                    }
+
+                    const auto modifiedTime = ::Azure::Core::_internal::PosixTimeConverter::DateTimeToPosixTime(blob.Details.LastModified);
+                    // An open WAL with a size trailer is indexed without a size, so asking for it reads the trailer.
+                    const auto size = BlobHelpers::HasSizeTrailer(blob) ? std::nullopt : std::optional<int64_t>(BlobHelpers::GetFileSize(blob));
+                    index->Put(ListedFileName(prefix, blob), size, static_cast<uint64_t>(modifiedTime));
+                    ++files;
+                }
+
+                if (!blobs.NextPageToken.HasValue())
+                {
+                    break;
+                }
+
+                opts.ContinuationToken = blobs.NextPageToken;
+                blobs = container.ListBlobs(opts);
+            } while (true);
+        }
+
+        BOOST_LOG_SEV(*m_logger, severity_level::info) << "Indexed " << files << " files under '" << opts.Prefix.Value() << "'";
+        std::scoped_lock lock(m_indexesMutex);
+        m_indexes.push_back(IndexedDirectory{ std::string(prefix), &lockFile, std::move(index) });
+    }
+
+    std::shared_ptr<NamespaceIndex> BlobFilesystemImpl::FindIndex(const std::string_view prefix, const std::string_view realPath) const
+    {
+        if (m_options.NamespaceIndexing == NamespaceIndexMode::Off)
+        {
+            return nullptr;
+        }
+
+        std::scoped_lock lock(m_indexesMutex);
+        for (const auto& indexed : m_indexes)
+        {
+            if (indexed.Prefix == prefix && indexed.Index->Covers(realPath))
+            {
+                return indexed.Index;
+            }
+        }
+
+        return nullptr;
+    }
+
+    WriteableFileImpl BlobFilesystemImpl::TrackFile(const std::string_view prefix, const std::string_view realPath, WriteableFileImpl file) const
+    {
+        if (auto index = FindIndex(prefix, realPath))
+        {
+            index->Put(realPath, file.GetFileSize(), PosixNow());
+
+            // Files left open after the directory is unlocked have no index left to update.
+            file.SetSizeListener([weakIndex = std::weak_ptr<NamespaceIndex>(index), name = std::string(realPath)](const int64_t size)
+                {
+                    if (auto current = weakIndex.lock())
+                    {
+                        current->Update(name, size, PosixNow());
+                    }
+                });
+        }
+
+        return file;
+    }
+
+    WriteableFileImpl BlobFilesystemImpl::FinishOpen(const std::string_view prefix, const std::string_view realPath, const FileProfile& profile, WriteableFileImpl file) const
+    {
+        if (profile.GrowthBlockSize > 0)
+        {
+            file.SetPreallocationBlockSize(profile.GrowthBlockSize);
+        }
+
+        return TrackFile(prefix, realPath, std::move(file));
+    }
+
+    void BlobFilesystemImpl::RenameInIndex(const std::string_view prefix, const std::string_view from, const std::string_view to) const
+    {
+        const auto fromIndex = FindIndex(prefix, from);
+        const auto toIndex = FindIndex(prefix, to);
+        if (fromIndex && fromIndex == toIndex)
+        {
+            fromIndex->Rename(from, to, PosixNow());
+            return;
+        }
+
+        if (fromIndex)
+        {
+            fromIndex->Remove(from);
+        }
+
+        if (toIndex)
+        {
+            toIndex->Put(to, std::nullopt, PosixNow());
+        }
+    }
+
+    void BlobFilesystemImpl::ReportIndexMismatch(const std::string_view operation, const std::string& path) const
+    {
+        BOOST_LOG_SEV(*m_logger, severity_level::warning) << "Namespace index disagrees with blob storage on " << operation << " for '" << path << "'";
+    }
+
     void BlobFilesystemImpl::RenewLease(std::stop_token stopToken)
     {
         BOOST_LOG_SEV(*m_logger, severity_level::info) << "Starting blob lease renewal thread";
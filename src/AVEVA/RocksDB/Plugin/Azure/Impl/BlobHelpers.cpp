@@ -9,10 +9,19 @@
 #include <azure/identity/environment_credential.hpp>
 #include <azure/identity/workload_identity_credential.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <exception>
+#include <future>
+#include <vector>
 namespace AVEVA::RocksDB::Plugin::Azure::Impl
 {
     static const std::string g_sizeMetadata = "filesize";
+    static const std::string g_sizeTrailerMetadata = "sizetrailer";
+    static const std::string g_fileNameMetadata = "filename";
+    static const constexpr std::string_view g_sizeTrailerMagic = "PBSIZE01";
     static void CreateIfNotExistsWithRetry(::Azure::Storage::Blobs::BlobContainerClient& client, int maxRetries = 5)
     {
         int retries = 1;
@@ -36,20 +45,155 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         }
     }
 
-    void BlobHelpers::SetFileSize(const ::Azure::Storage::Blobs::PageBlobClient& client, int64_t size)
+    void BlobHelpers::SetFileSize(const ::Azure::Storage::Blobs::PageBlobClient& client, int64_t size, const std::string_view fileName)
+    {
+        client.SetMetadata(FileSizeMetadata(size, fileName));
+    }
+
+    // Setting metadata replaces all of it, so the name of the file a recycled blob holds goes with every update.
+    static void AddFileName(::Azure::Storage::Metadata& metadata, const std::string_view fileName)
+    {
+        if (!fileName.empty())
+        {
+            metadata.emplace(g_fileNameMetadata, std::string(fileName));
+        }
+    }
+
+    ::Azure::Storage::Metadata BlobHelpers::FileSizeMetadata(const int64_t size, const std::string_view fileName)
     {
         ::Azure::Storage::Metadata metadata;
         metadata.emplace(g_sizeMetadata, std::to_string(size));
-        client.SetMetadata(std::move(metadata));
+        AddFileName(metadata, fileName);
+        return metadata;
+    }
+
+    static std::optional<int64_t> FindSizeTrailer(const ::Azure::Storage::Blobs::PageBlobClient& client)
+    {
+        // The trailer is the last page written, so the end of the last page range locates it. Its offset moves
+        // with every sync, which is why this costs a page range listing on top of the read.
+        int64_t end = 0;
+        for (auto pageRanges = client.GetPageRanges(); pageRanges.HasPage(); pageRanges.MoveToNextPage())
+        {
+            for (const auto& range : pageRanges.PageRanges)
+            {
+                end = std::max(end, range.Offset + range.Length.ValueOr(0));
+            }
+        }
+
+        if (end == 0)
+        {
+            return 0;
+        }
+
+        std::array<char, Configuration::PageBlob::PageSize> trailer{};
+        ::Azure::Storage::Blobs::DownloadBlobToOptions options;
+        options.Range = ::Azure::Core::Http::HttpRange{ end - Configuration::PageBlob::PageSize, Configuration::PageBlob::PageSize };
+        client.DownloadTo(reinterpret_cast<uint8_t*>(trailer.data()), trailer.size(), options);
+        return BlobHelpers::ReadSizeTrailer(trailer, end - Configuration::PageBlob::PageSize);
+    }
+
+    static int64_t GetFileSize(const ::Azure::Storage::Metadata& metadata,
+        const ::Azure::Storage::Blobs::Models::BlobType& blobType,
+        const int64_t blobSize,
+        const ::Azure::Storage::Blobs::PageBlobClient* client)
+    {
+        if (client && metadata.contains(g_sizeTrailerMetadata))
+        {
+            if (const auto size = FindSizeTrailer(*client))
+            {
+                return *size;
+            }
+        }
+
+        auto metaIter = metadata.find(g_sizeMetadata);
+        if (metaIter != metadata.end())
+        {
+            return static_cast<int64_t>(std::stoll(metaIter->second));
+        }
+
+        // Block and append blobs are exactly as long as the data committed to them.
+        return blobType == ::Azure::Storage::Blobs::Models::BlobType::BlockBlob ||
+            blobType == ::Azure::Storage::Blobs::Models::BlobType::AppendBlob
+            ? blobSize
+            : 0;
     }
 
     int64_t BlobHelpers::GetFileSize(const ::Azure::Storage::Blobs::PageBlobClient& client)
     {
         const auto props = client.GetProperties();
-        auto metaIter = props.Value.Metadata.find(g_sizeMetadata);
-        return metaIter != props.Value.Metadata.end()
-            ? static_cast<int64_t>(std::stoll(metaIter->second))
-            : 0;
+        return Impl::GetFileSize(props.Value.Metadata, props.Value.BlobType, props.Value.BlobSize, &client);
+    }
+
+    int64_t BlobHelpers::GetFileSize(const ::Azure::Storage::Blobs::Models::BlobItem& blob)
+    {
+        // A WAL still being written with a size trailer has no size in its metadata yet. Finding the trailer would
+        // cost two requests per blob, so the listing reports it as empty.
+        return Impl::GetFileSize(blob.Details.Metadata, blob.BlobType, blob.BlobSize, nullptr);
+    }
+
+    bool BlobHelpers::HasSizeTrailer(const ::Azure::Storage::Blobs::Models::BlobItem& blob)
+    {
+        return blob.Details.Metadata.contains(g_sizeTrailerMetadata);
+    }
+
+    int64_t BlobHelpers::GetFileSize(const ::Azure::Storage::Blobs::Models::DownloadBlobResult& download,
+        const ::Azure::Storage::Blobs::PageBlobClient& client)
+    {
+        return Impl::GetFileSize(download.Details.Metadata, download.BlobType, download.BlobSize, &client);
+    }
+
+    ::Azure::Storage::Metadata BlobHelpers::SizeTrailerMetadata(const std::string_view fileName)
+    {
+        ::Azure::Storage::Metadata metadata;
+        metadata.emplace(g_sizeTrailerMetadata, "1");
+        AddFileName(metadata, fileName);
+        return metadata;
+    }
+
+    std::string BlobHelpers::GetFileName(const ::Azure::Storage::Blobs::Models::BlobItem& blob)
+    {
+        const auto fileName = blob.Details.Metadata.find(g_fileNameMetadata);
+        return fileName != blob.Details.Metadata.end() ? fileName->second : blob.Name;
+    }
+
+    void BlobHelpers::WriteSizeTrailer(const std::span<char> page, const int64_t size)
+    {
+        assert(static_cast<int64_t>(page.size()) == Configuration::PageBlob::PageSize);
+        std::fill(page.begin(), page.end(), '\0');
+        std::copy(g_sizeTrailerMagic.begin(), g_sizeTrailerMagic.end(), page.begin());
+
+        // The size is followed by its complement so a torn or foreign page isn't mistaken for a trailer.
+        const auto value = static_cast<uint64_t>(size);
+        for (size_t i = 0; i < sizeof(uint64_t); ++i)
+        {
+            page[g_sizeTrailerMagic.size() + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+            page[g_sizeTrailerMagic.size() + sizeof(uint64_t) + i] = static_cast<char>((~value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    std::optional<int64_t> BlobHelpers::ReadSizeTrailer(const std::span<const char> page, const int64_t pageOffset)
+    {
+        if (page.size() < g_sizeTrailerMagic.size() + 2 * sizeof(uint64_t) ||
+            !std::equal(g_sizeTrailerMagic.begin(), g_sizeTrailerMagic.end(), page.begin()))
+        {
+            return std::nullopt;
+        }
+
+        uint64_t value = 0;
+        uint64_t complement = 0;
+        for (size_t i = 0; i < sizeof(uint64_t); ++i)
+        {
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(page[g_sizeTrailerMagic.size() + i])) << (8 * i);
+            complement |= static_cast<uint64_t>(static_cast<unsigned char>(page[g_sizeTrailerMagic.size() + sizeof(uint64_t) + i])) << (8 * i);
+        }
+
+        const auto size = static_cast<int64_t>(value);
+        if (complement != ~value || size < 0 || RoundToEndOfNearestPage(size).second != pageOffset)
+        {
+            return std::nullopt;
+        }
+
+        return size;
     }
 
     int64_t BlobHelpers::GetBlobCapacity(const ::Azure::Storage::Blobs::PageBlobClient& client)
@@ -78,6 +222,92 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         return std::make_pair(partialPageSize, roundedSize);
     }
 
+    void BlobHelpers::UploadPages(Core::BlobClient& client, const std::span<char> pages, const int64_t blobOffset, const int64_t maxConcurrency)
+    {
+        const auto size = static_cast<int64_t>(pages.size());
+        assert(size % Configuration::PageBlob::PageSize == 0);
+        assert(blobOffset % Configuration::PageBlob::PageSize == 0);
+
+        const auto chunkCount = (size + Configuration::PageBlob::MaxUploadSize - 1) / Configuration::PageBlob::MaxUploadSize;
+        RunConcurrently(chunkCount, maxConcurrency, [&client, pages, blobOffset, size](const int64_t chunk)
+            {
+                const auto offset = chunk * Configuration::PageBlob::MaxUploadSize;
+                const auto length = std::min(Configuration::PageBlob::MaxUploadSize, size - offset);
+                client.UploadPages(pages.subspan(static_cast<size_t>(offset), static_cast<size_t>(length)), blobOffset + offset);
+            });
+    }
+
+    void BlobHelpers::RunConcurrently(const int64_t taskCount, const int64_t maxConcurrency, const std::function<void(int64_t)>& task)
+    {
+        const auto workerCount = std::min(taskCount, maxConcurrency);
+        if (workerCount <= 1)
+        {
+            for (int64_t i = 0; i < taskCount; ++i)
+            {
+                task(i);
+            }
+
+            return;
+        }
+
+        // Workers pull the next task until none are left or one of them has failed.
+        std::atomic<int64_t> nextTask{ 0 };
+        std::atomic<bool> failed{ false };
+        const auto worker = [&]()
+            {
+                try
+                {
+                    for (auto i = nextTask++; i < taskCount && !failed; i = nextTask++)
+                    {
+                        task(i);
+                    }
+                }
+                catch (...)
+                {
+                    failed = true;
+                    throw;
+                }
+            };
+
+        std::vector<std::future<void>> workers;
+        workers.reserve(static_cast<size_t>(workerCount - 1));
+        for (int64_t i = 1; i < workerCount; ++i)
+        {
+            workers.push_back(std::async(std::launch::async, worker));
+        }
+
+        std::exception_ptr error;
+        try
+        {
+            worker();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        // Every worker references this frame, so all of them must finish before returning or throwing.
+        for (auto& result : workers)
+        {
+            try
+            {
+                result.get();
+            }
+            catch (...)
+            {
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
     ::Azure::Storage::Blobs::BlobClientOptions BlobHelpers::CreateBlobClientOptions()
     {
         auto opts = ::Azure::Storage::Blobs::BlobClientOptions();
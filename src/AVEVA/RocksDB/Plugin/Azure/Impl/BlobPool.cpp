@@ -0,0 +1,357 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/BlobPool.hpp"
+
+#include <azure/storage/blobs.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+
+using namespace boost::log::trivial;
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    static const std::string g_pooledMetadata = "pooled";
+
+    BlobPool::BlobPool(::Azure::Storage::Blobs::BlobContainerClient container,
+        const int64_t depth,
+        const int64_t initialSize,
+        std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger)
+        : m_container(std::move(container)),
+        m_depth(depth),
+        m_initialSize(initialSize),
+        m_logger(std::move(logger))
+    {
+        if (m_depth < 1)
+        {
+            throw std::invalid_argument("Blob pool depth must be at least one");
+        }
+
+        // Start the background thread after all members are initialized
+        m_worker = std::jthread(&BlobPool::Work, this, m_stopSource.get_token());
+    }
+
+    BlobPool::~BlobPool()
+    {
+        {
+            std::scoped_lock lock(m_mutex);
+            m_stopSource.request_stop();
+        }
+
+        m_cv.notify_all();
+        m_worker.join();
+    }
+
+    bool BlobPool::Claim(const std::string_view realPath)
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_blobs.find(realPath);
+        if (it == m_blobs.end())
+        {
+            return false;
+        }
+
+        const auto ready = it->second == State::Ready;
+        if (it->second == State::Queued)
+        {
+            m_createQueue.erase(std::find(m_createQueue.begin(), m_createQueue.end(), realPath));
+        }
+
+        // A blob still being created is created only if nothing exists yet, so it can't replace the caller's.
+        m_blobs.erase(it);
+        return ready;
+    }
+
+    void BlobPool::Replenish(const std::string_view realPath)
+    {
+        const auto name = ParseName(realPath);
+        if (!name)
+        {
+            return;
+        }
+
+        {
+            std::scoped_lock lock(m_mutex);
+            if (m_collectedPrefixes.emplace(name->Directory).second)
+            {
+                m_garbagePrefixes.emplace_back(name->Directory);
+            }
+
+            // File numbers only go up, so blobs for the numbers up to this one will never be claimed.
+            for (auto it = m_blobs.begin(); it != m_blobs.end();)
+            {
+                const auto pooled = ParseName(it->first);
+                const auto passed = pooled && pooled->Directory == name->Directory &&
+                    pooled->Extension == name->Extension && pooled->Number <= name->Number;
+                if (!passed || it->second == State::Creating)
+                {
+                    ++it;
+                    continue;
+                }
+
+                if (it->second == State::Queued)
+                {
+                    m_createQueue.erase(std::find(m_createQueue.begin(), m_createQueue.end(), it->first));
+                }
+                else
+                {
+                    m_deleteQueue.push_back(it->first);
+                }
+
+                it = m_blobs.erase(it);
+            }
+
+            for (auto& next : PredictNames(realPath, m_depth))
+            {
+                if (!m_blobs.contains(next))
+                {
+                    m_blobs.emplace(next, State::Queued);
+                    m_createQueue.push_back(std::move(next));
+                }
+            }
+        }
+
+        m_cv.notify_all();
+    }
+
+    bool BlobPool::Contains(const std::string_view realPath)
+    {
+        std::scoped_lock lock(m_mutex);
+        return m_blobs.contains(realPath);
+    }
+
+    void BlobPool::Forget(const std::string_view realPath)
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_blobs.find(realPath);
+        if (it == m_blobs.end())
+        {
+            return;
+        }
+
+        if (it->second == State::Queued)
+        {
+            m_createQueue.erase(std::find(m_createQueue.begin(), m_createQueue.end(), realPath));
+        }
+
+        m_blobs.erase(it);
+    }
+
+    std::vector<std::string> BlobPool::PredictNames(const std::string_view realPath, const int64_t count)
+    {
+        std::vector<std::string> names;
+        const auto name = ParseName(realPath);
+        if (!name)
+        {
+            return names;
+        }
+
+        for (int64_t i = 1; i <= count; ++i)
+        {
+            auto number = std::to_string(name->Number + static_cast<uint64_t>(i));
+            if (number.size() < name->Width)
+            {
+                number.insert(0, name->Width - number.size(), '0');
+            }
+
+            names.push_back(std::string(name->Directory) + number + std::string(name->Extension));
+        }
+
+        return names;
+    }
+
+    std::optional<BlobPool::FileName> BlobPool::ParseName(const std::string_view realPath)
+    {
+        const auto slash = realPath.rfind('/');
+        const auto fileStart = slash == std::string_view::npos ? 0 : slash + 1;
+        const auto dot = realPath.find('.', fileStart);
+        if (dot == std::string_view::npos || dot == fileStart)
+        {
+            return std::nullopt;
+        }
+
+        const auto stem = realPath.substr(fileStart, dot - fileStart);
+        if (!std::all_of(stem.begin(), stem.end(), [](const char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; }))
+        {
+            return std::nullopt;
+        }
+
+        uint64_t number = 0;
+        const auto [end, error] = std::from_chars(stem.data(), stem.data() + stem.size(), number);
+        if (error != std::errc{} || end != stem.data() + stem.size())
+        {
+            return std::nullopt;
+        }
+
+        return FileName{ realPath.substr(0, fileStart), number, stem.size(), realPath.substr(dot) };
+    }
+
+    void BlobPool::Work(std::stop_token stopToken)
+    {
+        while (true)
+        {
+            std::optional<std::string> garbagePrefix;
+            std::string toDelete;
+            std::string toCreate;
+            {
+                std::unique_lock lock(m_mutex);
+                m_cv.wait(lock, [this, &stopToken]()
+                    {
+                        return stopToken.stop_requested() || !m_garbagePrefixes.empty() || !m_deleteQueue.empty() || !m_createQueue.empty();
+                    });
+                if (stopToken.stop_requested())
+                {
+                    break;
+                }
+
+                // Leftovers go first, they may hold the names about to be created.
+                if (!m_garbagePrefixes.empty())
+                {
+                    garbagePrefix = std::move(m_garbagePrefixes.front());
+                    m_garbagePrefixes.pop_front();
+                }
+                else if (!m_deleteQueue.empty())
+                {
+                    toDelete = std::move(m_deleteQueue.front());
+                    m_deleteQueue.pop_front();
+                }
+                else
+                {
+                    toCreate = std::move(m_createQueue.front());
+                    m_createQueue.pop_front();
+                    m_blobs[toCreate] = State::Creating;
+                }
+            }
+
+            try
+            {
+                if (garbagePrefix)
+                {
+                    CollectGarbage(*garbagePrefix);
+                }
+                else if (!toDelete.empty())
+                {
+                    m_container.GetPageBlobClient(toDelete).DeleteIfExists();
+                }
+                else
+                {
+                    Create(toCreate);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                BOOST_LOG_SEV(*m_logger, warning) << "Blob pool failed to prepare blobs: " << e.what();
+                if (!toCreate.empty())
+                {
+                    std::scoped_lock lock(m_mutex);
+                    m_blobs.erase(toCreate);
+                }
+            }
+        }
+
+        DeleteUnclaimed();
+    }
+
+    void BlobPool::Create(const std::string& realPath)
+    {
+        ::Azure::Storage::Blobs::CreatePageBlobOptions options;
+        options.Metadata.emplace(g_pooledMetadata, "1");
+
+        // Only created if nothing is there, so neither a file created meanwhile nor an existing one is replaced.
+        const auto created = m_container.GetPageBlobClient(realPath).CreateIfNotExists(m_initialSize, options).Value.Created;
+
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_blobs.find(realPath);
+        if (it == m_blobs.end())
+        {
+            // Claimed or forgotten while it was being created.
+            return;
+        }
+
+        if (created)
+        {
+            it->second = State::Ready;
+            BOOST_LOG_SEV(*m_logger, debug) << "Pooled blob '" << realPath << "'";
+        }
+        else
+        {
+            m_blobs.erase(it);
+        }
+    }
+
+    void BlobPool::CollectGarbage(const std::string& prefix)
+    {
+        ::Azure::Storage::Blobs::ListBlobsOptions options;
+        options.Prefix = prefix;
+        options.Include = ::Azure::Storage::Blobs::Models::ListBlobsIncludeFlags::Metadata;
+        for (auto blobs = m_container.ListBlobs(options); blobs.HasPage(); blobs.MoveToNextPage())
+        {
+            for (const auto& blob : blobs.Blobs)
+            {
+                if (!blob.Details.Metadata.contains(g_pooledMetadata))
+                {
+                    continue;
+                }
+
+                {
+                    std::scoped_lock lock(m_mutex);
+                    const auto it = m_blobs.find(blob.Name);
+                    if (it != m_blobs.end() && it->second != State::Queued)
+                    {
+                        continue;
+                    }
+                }
+
+                // A file created under the name since the listing is a new blob with another ETag, and must survive.
+                ::Azure::Storage::Blobs::DeleteBlobOptions deleteOptions;
+                deleteOptions.AccessConditions.IfMatch = blob.Details.ETag;
+                try
+                {
+                    m_container.GetPageBlobClient(blob.Name).DeleteIfExists(deleteOptions);
+                    BOOST_LOG_SEV(*m_logger, debug) << "Deleted pooled blob '" << blob.Name << "' left by an earlier process";
+                }
+                catch (const ::Azure::Storage::StorageException& ex)
+                {
+                    if (ex.StatusCode != ::Azure::Core::Http::HttpStatusCode::PreconditionFailed)
+                    {
+                        throw;
+                    }
+
+                    BOOST_LOG_SEV(*m_logger, debug) << "Pooled blob '" << blob.Name << "' left by an earlier process was claimed meanwhile";
+                }
+            }
+        }
+    }
+
+    void BlobPool::DeleteUnclaimed()
+    {
+        std::vector<std::string> unclaimed;
+        {
+            std::scoped_lock lock(m_mutex);
+            for (const auto& [name, state] : m_blobs)
+            {
+                if (state == State::Ready)
+                {
+                    unclaimed.push_back(name);
+                }
+            }
+
+            m_blobs.clear();
+            m_createQueue.clear();
+        }
+
+        // Best effort, whatever is missed is collected by the next process to use the pool.
+        for (const auto& name : unclaimed)
+        {
+            try
+            {
+                m_container.GetPageBlobClient(name).DeleteIfExists();
+            }
+            catch (const std::exception& e)
+            {
+                BOOST_LOG_SEV(*m_logger, warning) << "Failed to delete pooled blob '" << name << "': " << e.what();
+            }
+        }
+    }
+}
@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/BlockBlob.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/Configuration.hpp"
+#include <azure/core/base64.hpp>
+#include <azure/core/etag.hpp>
+#include <azure/core/context.hpp>
+
+#include <cassert>
+#include <cstdio>
+#include <limits>
+#include <stdexcept>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    BlockBlob::BlockBlob(::Azure::Storage::Blobs::BlockBlobClient client)
+        : m_client(std::move(client)),
+        m_lastPageOffset(-1),
+        m_size(0),
+        m_committed(false)
+    {
+    }
+
+    int64_t BlockBlob::GetSize()
+    {
+        std::scoped_lock lock(m_mutex);
+        return m_size;
+    }
+
+    void BlockBlob::SetSize(const int64_t size)
+    {
+        std::scoped_lock lock(m_mutex);
+        if (m_committed && size == m_size)
+        {
+            return;
+        }
+
+        // Blocks past the new size are left out of the list and discarded by the commit.
+        m_blocks.erase(m_blocks.lower_bound(size), m_blocks.end());
+        if (!m_blocks.empty())
+        {
+            auto& [offset, length] = *m_blocks.rbegin();
+            if (offset + length != size)
+            {
+                // Only the last page is kept around, a larger block can't be shortened without its data.
+                if (offset != m_lastPageOffset || size > offset + length)
+                {
+                    throw std::invalid_argument("Block blob can only be cut inside the last page written");
+                }
+
+                length = size - offset;
+                StageBlock(std::span(m_lastPage).first(static_cast<size_t>(length)), offset);
+            }
+        }
+
+        std::vector<std::string> blockIds;
+        blockIds.reserve(m_blocks.size());
+        for (const auto& [offset, length] : m_blocks)
+        {
+            blockIds.push_back(BlockId(offset));
+        }
+
+        m_client.CommitBlockList(blockIds);
+        m_size = size;
+        m_committed = true;
+    }
+
+    int64_t BlockBlob::GetCapacity()
+    {
+        // Block blobs grow with every commit, there is nothing to reserve.
+        return std::numeric_limits<int64_t>::max();
+    }
+
+    void BlockBlob::SetCapacity(int64_t)
+    {
+    }
+
+    void BlockBlob::DownloadTo(const std::string& path, int64_t offset, int64_t length)
+    {
+        ::Azure::Storage::Blobs::DownloadBlobToOptions options;
+        options.Range = ::Azure::Core::Http::HttpRange(offset, length);
+        m_client.DownloadTo(path, options);
+    }
+
+    int64_t BlockBlob::DownloadTo(std::span<char> buffer, int64_t offset, int64_t length)
+    {
+        ::Azure::Storage::Blobs::DownloadBlobToOptions options
+        {
+          .Range = ::Azure::Core::Http::HttpRange { offset, length }
+        };
+
+        const auto result = m_client.DownloadTo(reinterpret_cast<uint8_t*>(buffer.data()), buffer.size(), options);
+        const auto& downloadedLength = result.Value.ContentRange.Length;
+        return downloadedLength.ValueOr(-1);
+    }
+
+    void BlockBlob::UploadPages(const std::span<char> buffer, const int64_t blobOffset)
+    {
+        const auto size = static_cast<int64_t>(buffer.size());
+        assert(size % Configuration::PageBlob::PageSize == 0);
+        assert(blobOffset % Configuration::PageBlob::PageSize == 0);
+        if (size == 0)
+        {
+            return;
+        }
+
+        // The last page goes in a block of its own. Writers re-upload the partial last page as it fills, and
+        // only that block has to be replaced then. It is also the block shortened to the file size on commit.
+        const auto bodySize = size - Configuration::PageBlob::PageSize;
+        const auto lastPageOffset = blobOffset + bodySize;
+        if (bodySize > 0)
+        {
+            StageBlock(buffer.first(static_cast<size_t>(bodySize)), blobOffset);
+        }
+
+        StageBlock(buffer.last(static_cast<size_t>(Configuration::PageBlob::PageSize)), lastPageOffset);
+
+        std::scoped_lock lock(m_mutex);
+        m_blocks.erase(m_blocks.lower_bound(blobOffset), m_blocks.lower_bound(blobOffset + size));
+        if (bodySize > 0)
+        {
+            m_blocks.emplace(blobOffset, bodySize);
+        }
+
+        m_blocks.emplace(lastPageOffset, Configuration::PageBlob::PageSize);
+        if (lastPageOffset >= m_lastPageOffset)
+        {
+            m_lastPage.assign(buffer.end() - Configuration::PageBlob::PageSize, buffer.end());
+            m_lastPageOffset = lastPageOffset;
+        }
+
+        m_committed = false;
+    }
+
+    ::Azure::ETag BlockBlob::GetEtag()
+    {
+        const auto properties = m_client.GetProperties();
+        return properties.Value.ETag;
+    }
+
+    int64_t BlockBlob::Download(std::span<char> buffer, int64_t offset, int64_t length, const ::Azure::ETag& ifMatch)
+    {
+        ::Azure::Storage::Blobs::DownloadBlobOptions options
+        {
+          .Range = ::Azure::Core::Http::HttpRange { offset, length }
+        };
+        options.AccessConditions.IfMatch = ifMatch;
+        const auto result = m_client.Download(options, ::Azure::Core::Context{});
+        const auto& content = result.Value;
+
+        return static_cast<int64_t>(content.BodyStream->ReadToCount(reinterpret_cast<uint8_t*>(buffer.data()), buffer.size()));
+    }
+
+    void BlockBlob::StageBlock(const std::span<char> data, const int64_t blobOffset)
+    {
+        ::Azure::Core::IO::MemoryBodyStream dataStream(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        m_client.StageBlock(BlockId(blobOffset), dataStream);
+    }
+
+    std::string BlockBlob::BlockId(const int64_t blobOffset)
+    {
+        // Every block id of a blob must have the same length, so the offset is zero padded.
+        char id[21];
+        std::snprintf(id, sizeof(id), "%020lld", static_cast<long long>(blobOffset));
+        return ::Azure::Core::Convert::Base64Encode(std::vector<uint8_t>(id, id + 20));
+    }
+}
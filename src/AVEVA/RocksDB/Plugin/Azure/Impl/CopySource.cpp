@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/CopySource.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/Configuration.hpp"
+
+#include <azure/storage/blobs/blob_sas_builder.hpp>
+
+#include <stdexcept>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    CopySource::CopySource(::Azure::Storage::Blobs::BlobServiceClient service, ::Azure::Storage::Blobs::BlobContainerClient container)
+        : m_service(std::move(service)),
+        m_container(std::move(container))
+    {
+        // Container URLs look like https://<account>.blob.core.windows.net/<container>.
+        const auto url = m_container.GetUrl();
+        const auto hostBegin = url.find("://");
+        const auto hostStart = hostBegin == std::string::npos ? 0 : hostBegin + 3;
+        const auto pathStart = url.find('/', hostStart);
+        if (pathStart == std::string::npos)
+        {
+            throw std::invalid_argument("Container URL '" + url + "' has no container name");
+        }
+
+        m_accountName = url.substr(hostStart, url.find('.', hostStart) - hostStart);
+        m_containerName = url.substr(pathStart + 1, url.find_first_of("/?", pathStart + 1) - pathStart - 1);
+    }
+
+    std::string CopySource::Url(const std::string& blobName)
+    {
+        const auto now = std::chrono::system_clock::now();
+        ::Azure::Storage::Sas::BlobSasBuilder sasBuilder;
+        sasBuilder.StartsOn = ::Azure::DateTime(now - Configuration::Copy::ClockSkew);
+        sasBuilder.ExpiresOn = ::Azure::DateTime(now + Configuration::Copy::SasLifetime);
+        sasBuilder.BlobContainerName = m_containerName;
+        sasBuilder.BlobName = blobName;
+        sasBuilder.Resource = ::Azure::Storage::Sas::BlobSasResource::Blob;
+        sasBuilder.SetPermissions(::Azure::Storage::Sas::BlobSasPermissions::Read);
+
+        std::scoped_lock lock(m_mutex);
+        if (!m_key || m_keyExpiresOn < now + Configuration::Copy::SasLifetime)
+        {
+            // The key must outlive every SAS signed with it.
+            const auto expiresOn = now + Configuration::Copy::KeyLifetime;
+            ::Azure::Storage::Blobs::GetUserDelegationKeyOptions options;
+            options.StartsOn = ::Azure::DateTime(now - Configuration::Copy::ClockSkew);
+            m_key = m_service.GetUserDelegationKey(::Azure::DateTime(expiresOn), options).Value;
+            m_keyExpiresOn = expiresOn;
+        }
+
+        return m_container.GetBlobClient(blobName).GetUrl() + sasBuilder.GenerateSasToken(*m_key, m_accountName);
+    }
+}
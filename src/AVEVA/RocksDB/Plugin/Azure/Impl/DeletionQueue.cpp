@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/DeletionQueue.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/BlobHelpers.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/Configuration.hpp"
+
+#include <azure/storage/blobs.hpp>
+
+#include <algorithm>
+using namespace boost::log::trivial;
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    DeletionQueue::DeletionQueue(::Azure::Storage::Blobs::BlobContainerClient container,
+        const int64_t concurrency,
+        std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger)
+        : m_container(std::move(container)),
+        m_concurrency(std::max<int64_t>(concurrency, 1)),
+        m_logger(std::move(logger))
+    {
+        // Start the background thread after all members are initialized
+        m_worker = std::jthread(&DeletionQueue::Work, this, m_stopSource.get_token());
+    }
+
+    DeletionQueue::~DeletionQueue()
+    {
+        {
+            std::scoped_lock lock(m_mutex);
+            m_stopSource.request_stop();
+        }
+
+        m_cv.notify_all();
+        m_worker.join();
+    }
+
+    void DeletionQueue::Enqueue(const std::string_view realPath)
+    {
+        {
+            std::scoped_lock lock(m_mutex);
+            const auto [it, inserted] = m_pending.emplace(realPath, PendingState::Queued);
+            if (!inserted)
+            {
+                // A batch being submitted may delete the blob before it was recreated, so it's deleted again after.
+                if (it->second == PendingState::Submitting)
+                {
+                    it->second = PendingState::SubmittingRequeue;
+                }
+
+                return;
+            }
+
+            m_queue.emplace_back(realPath);
+        }
+
+        m_cv.notify_all();
+    }
+
+    bool DeletionQueue::Contains(const std::string_view realPath)
+    {
+        std::scoped_lock lock(m_mutex);
+        return m_pending.contains(realPath);
+    }
+
+    void DeletionQueue::Settle(const std::string_view realPath)
+    {
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [this, realPath]()
+            {
+                const auto it = m_pending.find(realPath);
+                return it == m_pending.end() || it->second == PendingState::Queued;
+            });
+
+        const auto it = m_pending.find(realPath);
+        if (it == m_pending.end())
+        {
+            return;
+        }
+
+        m_queue.erase(std::find(m_queue.begin(), m_queue.end(), realPath));
+        m_pending.erase(it);
+        lock.unlock();
+        m_container.GetBlobClient(std::string(realPath)).DeleteIfExists();
+    }
+
+    size_t DeletionQueue::DeleteNow(const std::span<const std::string> realPaths)
+    {
+        return DeleteWithRetry(std::vector<std::string>(realPaths.begin(), realPaths.end())).size();
+    }
+
+    void DeletionQueue::Work(std::stop_token stopToken)
+    {
+        while (true)
+        {
+            std::vector<std::string> batch;
+            {
+                std::unique_lock lock(m_mutex);
+                m_cv.wait(lock, [this, &stopToken]() { return stopToken.stop_requested() || !m_queue.empty(); });
+                if (m_queue.empty())
+                {
+                    break;
+                }
+
+                // Deletions queued while the previous round was submitted go out together.
+                const auto limit = Configuration::Deletion::MaxBatchSize * static_cast<size_t>(m_concurrency);
+                while (!m_queue.empty() && batch.size() < limit)
+                {
+                    m_pending[m_queue.front()] = PendingState::Submitting;
+                    batch.push_back(std::move(m_queue.front()));
+                    m_queue.pop_front();
+                }
+            }
+
+            for (const auto& name : DeleteWithRetry(batch))
+            {
+                BOOST_LOG_SEV(*m_logger, warning) << "Gave up deleting blob '" << name << "'";
+            }
+
+            {
+                std::scoped_lock lock(m_mutex);
+                for (auto& name : batch)
+                {
+                    const auto it = m_pending.find(name);
+                    if (it->second == PendingState::SubmittingRequeue)
+                    {
+                        it->second = PendingState::Queued;
+                        m_queue.push_back(std::move(name));
+                    }
+                    else
+                    {
+                        m_pending.erase(it);
+                    }
+                }
+            }
+
+            m_cv.notify_all();
+        }
+    }
+
+    std::vector<std::string> DeletionQueue::DeleteWithRetry(std::vector<std::string> realPaths)
+    {
+        auto backoff = Configuration::Deletion::InitialBackoff;
+        for (int attempt = 1; !realPaths.empty(); ++attempt)
+        {
+            realPaths = SubmitBatches(realPaths);
+            if (realPaths.empty() || attempt == Configuration::Deletion::MaxAttempts)
+            {
+                break;
+            }
+
+            BOOST_LOG_SEV(*m_logger, debug) << "Retrying " << realPaths.size() << " blob deletions in " << backoff.count() << "ms";
+            std::this_thread::sleep_for(backoff);
+            backoff *= 2;
+        }
+
+        return realPaths;
+    }
+
+    std::vector<std::string> DeletionQueue::SubmitBatches(const std::span<const std::string> realPaths)
+    {
+        static const constexpr auto maxBatchSize = Configuration::Deletion::MaxBatchSize;
+        const auto batchCount = (realPaths.size() + maxBatchSize - 1) / maxBatchSize;
+        std::vector<std::vector<std::string>> failures(batchCount);
+        BlobHelpers::RunConcurrently(static_cast<int64_t>(batchCount), m_concurrency, [this, realPaths, &failures](const int64_t index)
+            {
+                const auto offset = static_cast<size_t>(index) * maxBatchSize;
+                const auto names = realPaths.subspan(offset, std::min(maxBatchSize, realPaths.size() - offset));
+                auto& failed = failures[static_cast<size_t>(index)];
+                try
+                {
+                    auto batch = m_container.CreateBatch();
+                    std::vector<decltype(batch.DeleteBlob(std::string{}))> responses;
+                    responses.reserve(names.size());
+                    for (const auto& name : names)
+                    {
+                        responses.push_back(batch.DeleteBlob(name));
+                    }
+
+                    m_container.SubmitBatch(batch);
+                    for (size_t i = 0; i < responses.size(); ++i)
+                    {
+                        try
+                        {
+                            responses[i].GetResponse();
+                        }
+                        catch (const ::Azure::Storage::StorageException& e)
+                        {
+                            if (e.StatusCode != ::Azure::Core::Http::HttpStatusCode::NotFound)
+                            {
+                                failed.push_back(names[i]);
+                            }
+                        }
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    BOOST_LOG_SEV(*m_logger, warning) << "Failed to submit a batch of " << names.size() << " blob deletions: " << e.what();
+                    failed.assign(names.begin(), names.end());
+                }
+            });
+
+        std::vector<std::string> remaining;
+        for (auto& failed : failures)
+        {
+            std::move(failed.begin(), failed.end(), std::back_inserter(remaining));
+        }
+
+        return remaining;
+    }
+}
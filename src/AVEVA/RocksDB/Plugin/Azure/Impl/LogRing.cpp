@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/LogRing.hpp"
+
+#include <algorithm>
+#include <bit>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    LogRing::LogRing(const size_t capacity)
+        : m_slots(std::make_unique<Slot[]>(std::bit_ceil(std::max<size_t>(capacity, 2)))),
+        m_mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1),
+        m_enqueuePosition(0),
+        m_dequeuePosition(0)
+    {
+        for (size_t i = 0; i <= m_mask; ++i)
+        {
+            m_slots[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool LogRing::TryPush(std::string& record)
+    {
+        auto position = m_enqueuePosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            auto& slot = m_slots[position & m_mask];
+            const auto sequence = slot.Sequence.load(std::memory_order_acquire);
+            const auto lag = static_cast<int64_t>(sequence - position);
+            if (lag == 0)
+            {
+                // The slot is free for this position, claim the position before filling it.
+                if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    slot.Record = std::move(record);
+                    slot.Sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (lag < 0)
+            {
+                // The consumer hasn't emptied the slot from the previous lap yet.
+                return false;
+            }
+            else
+            {
+                position = m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool LogRing::TryPop(std::string& record)
+    {
+        const auto position = m_dequeuePosition.load(std::memory_order_relaxed);
+        auto& slot = m_slots[position & m_mask];
+        if (slot.Sequence.load(std::memory_order_acquire) != position + 1)
+        {
+            return false;
+        }
+
+        record = std::move(slot.Record);
+        slot.Record.clear();
+        slot.Sequence.store(position + m_mask + 1, std::memory_order_release);
+        m_dequeuePosition.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    size_t LogRing::Capacity() const
+    {
+        return m_mask + 1;
+    }
+
+    size_t LogRing::SizeApprox() const
+    {
+        const auto enqueued = m_enqueuePosition.load(std::memory_order_relaxed);
+        const auto dequeued = m_dequeuePosition.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+}
@@ -2,15 +2,229 @@
 // SPDX-FileCopyrightText: Copyright 2025 AVEVA
 
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/LoggerImpl.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/LogRing.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
 namespace AVEVA::RocksDB::Plugin::Azure::Impl
 {
-    LoggerImpl::LoggerImpl(std::unique_ptr<WriteableFileImpl> file, int logLevel)
-        : m_file(std::move(file)),
-        m_logLevel(logLevel),
-        m_buffer(4096)
+    static size_t FormatTimestamp(char* buffer, const size_t size)
+    {
+        // RFC 3339 format UTC time
+        // See: https://en.cppreference.com/w/cpp/chrono/c/strftime
+        const auto now = std::time(nullptr);
+        std::tm tm = {};
+#ifdef _WIN32
+        gmtime_s(&tm, &now);
+#else
+        gmtime_r(&now, &tm);
+#endif
+
+        return strftime(buffer, size, "%Y-%m-%dT%H:%M:%SZ ", &tm);
+    }
+
+    struct LoggerImpl::Writer
+    {
+        Writer(std::unique_ptr<WriteableFileImpl> file, const LogOverflowPolicy overflow)
+            : File(std::move(file)),
+            Overflow(overflow),
+            Ring(Configuration::InfoLog::RingCapacity),
+            Spilling(false),
+            SpillSize(0),
+            Dropped(0),
+            FlushRequested(0),
+            FlushCompleted(0)
+        {
+            // Start the background thread after all members are initialized
+            Thread = std::jthread([this](std::stop_token stopToken) { Run(stopToken); });
+        }
+
+        void Push(std::string record)
+        {
+            // Once a record spilled, the following ones spill behind it so each thread's records stay in order.
+            if (!Spilling.load(std::memory_order_acquire) && Ring.TryPush(record))
+            {
+                if (Ring.SizeApprox() >= Ring.Capacity() / 2)
+                {
+                    Wake.notify_one();
+                }
+
+                return;
+            }
+
+            if (Overflow == LogOverflowPolicy::Spill)
+            {
+                std::scoped_lock lock(SpillMutex);
+                if (SpillSize + record.size() <= Configuration::InfoLog::MaxSpillSize)
+                {
+                    SpillSize += record.size();
+                    Spilled.push_back(std::move(record));
+                    Spilling.store(true, std::memory_order_release);
+                }
+                else
+                {
+                    Dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            else
+            {
+                Dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            Wake.notify_one();
+        }
+
+        void Flush()
+        {
+            std::unique_lock lock(WakeMutex);
+            const auto generation = ++FlushRequested;
+            Wake.notify_one();
+
+            // Records pushed before this call are in the ring or the spill queue, so the batch that takes this
+            // generation uploads them.
+            Flushed.wait_for(lock, Configuration::InfoLog::FlushTimeout, [this, generation]()
+                {
+                    return FlushCompleted >= generation;
+                });
+        }
+
+        void CompleteFlush(const uint64_t generation)
+        {
+            {
+                std::scoped_lock lock(WakeMutex);
+                FlushCompleted = generation;
+            }
+
+            Flushed.notify_all();
+        }
+
+        void Run(const std::stop_token stopToken)
+        {
+            while (!stopToken.stop_requested())
+            {
+                uint64_t generation = 0;
+                {
+                    // Records logged without a wake-up are picked up when the interval runs out.
+                    std::unique_lock lock(WakeMutex);
+                    Wake.wait_for(lock, stopToken, Configuration::InfoLog::WriteInterval, [this]()
+                        {
+                            return FlushRequested != FlushCompleted || Spilling.load(std::memory_order_acquire) || Ring.SizeApprox() >= Ring.Capacity() / 2;
+                        });
+                    generation = FlushRequested;
+                }
+
+                WriteBatch();
+                CompleteFlush(generation);
+            }
+
+            uint64_t generation = 0;
+            {
+                std::scoped_lock lock(WakeMutex);
+                generation = FlushRequested;
+            }
+
+            WriteBatch();
+            CompleteFlush(generation);
+            try
+            {
+                File->Close();
+            }
+            catch (const std::exception&)
+            {
+                // The log is best effort, and there's nowhere left to report to.
+            }
+        }
+
+        void WriteBatch()
+        {
+            std::string batch;
+            uint64_t records = 0;
+            for (std::string record; Ring.TryPop(record); ++records)
+            {
+                batch += record;
+            }
+
+            std::deque<std::string> spilled;
+            {
+                std::scoped_lock lock(SpillMutex);
+                spilled.swap(Spilled);
+                SpillSize = 0;
+                Spilling.store(false, std::memory_order_release);
+            }
+
+            for (const auto& record : spilled)
+            {
+                batch += record;
+                ++records;
+            }
+
+            const auto dropped = Dropped.exchange(0, std::memory_order_relaxed);
+            if (dropped > 0)
+            {
+                char timestamp[32];
+                const auto length = FormatTimestamp(timestamp, sizeof(timestamp));
+                batch.append(timestamp, length).append(std::to_string(dropped)).append(" info log records dropped\n");
+            }
+
+            if (batch.empty())
+            {
+                return;
+            }
+
+            try
+            {
+                // One append and one sync per batch, the file only uploads when it is synced.
+                File->Append(batch);
+            }
+            catch (const std::exception&)
+            {
+                // Nothing of the batch made it into the file, the drop notice included.
+                Dropped.fetch_add(records + dropped, std::memory_order_relaxed);
+                return;
+            }
+
+            try
+            {
+                File->Sync();
+            }
+            catch (const std::exception&)
+            {
+                // The batch stays buffered in the file and goes out with the next sync, so nothing was dropped.
+            }
+        }
+
+        std::unique_ptr<WriteableFileImpl> File;
+        LogOverflowPolicy Overflow;
+        LogRing Ring;
+        std::atomic<bool> Spilling;
+        std::mutex SpillMutex;
+        std::deque<std::string> Spilled;
+        size_t SpillSize;
+        std::atomic<uint64_t> Dropped;
+        std::mutex WakeMutex;
+        std::condition_variable_any Wake;
+        std::condition_variable Flushed;
+        uint64_t FlushRequested;
+        uint64_t FlushCompleted;
+        std::jthread Thread;
+    };
+
+    LoggerImpl::LoggerImpl(std::unique_ptr<WriteableFileImpl> file, int logLevel, const LogOverflowPolicy overflow)
+        : m_writer(std::make_unique<Writer>(std::move(file), overflow)),
+        m_logLevel(logLevel)
     {
     }
 
+    LoggerImpl::~LoggerImpl() = default;
+    LoggerImpl::LoggerImpl(LoggerImpl&& other) noexcept = default;
+    LoggerImpl& LoggerImpl::operator=(LoggerImpl&& other) noexcept = default;
+
     void LoggerImpl::Logv(const int logLevel, const char* format, ...)
     {
         va_list va;
@@ -26,46 +240,44 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
             return;
         }
 
-        // RFC 3339 format UTC time
-        // See: https://en.cppreference.com/w/cpp/chrono/c/strftime
-        const auto now = std::time(nullptr);
-        std::tm tm = {};
-#ifdef _WIN32
-        gmtime_s(&tm, &now);
-#else
-        gmtime_r(&now, &tm);
-#endif
-
-        const auto offset = strftime(m_buffer.data(), m_buffer.size(), "%Y-%m-%dT%H:%M:%SZ", &tm);
+        // Every call formats into its own record, so threads logging at once don't share a buffer.
+        std::string record(256, '\0');
+        const auto offset = FormatTimestamp(record.data(), record.size());
 
         // Copy va_list because vsnprintf may consume it
         va_list apCopy;
         va_copy(apCopy, ap);
 
-        const int result = vsnprintf(m_buffer.data() + offset, m_buffer.size() - offset, format, apCopy);
+        const int result = vsnprintf(record.data() + offset, record.size() - offset, format, apCopy);
         va_end(apCopy);
         if (result < 0)
         {
             throw std::runtime_error("Unable to format log message");
         }
 
-        const auto totalBufferOffset = static_cast<size_t>(result) + offset;
-        if (totalBufferOffset > m_buffer.size())
+        const auto length = static_cast<size_t>(result) + offset;
+        if (length >= record.size())
         {
-            m_buffer.resize(totalBufferOffset);
-            const int newResult = vsnprintf(m_buffer.data() + offset, m_buffer.size() - offset, format, ap);
+            // Leave room for the terminator vsnprintf always writes.
+            record.resize(length + 1);
+            const int newResult = vsnprintf(record.data() + offset, record.size() - offset, format, ap);
             if (newResult < 0)
             {
                 throw std::runtime_error("Unable to format log message");
             }
         }
 
-        m_file->Append(std::span(m_buffer.data(), m_buffer.data() + totalBufferOffset));
-        va_end(ap);
+        record.resize(length);
+        if (record.back() != '\n')
+        {
+            record.push_back('\n');
+        }
+
+        m_writer->Push(std::move(record));
     }
 
     void LoggerImpl::Flush()
     {
-        m_file->Sync();
+        m_writer->Flush();
     }
 }
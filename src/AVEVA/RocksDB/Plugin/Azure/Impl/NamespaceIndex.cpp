@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/NamespaceIndex.hpp"
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    NamespaceIndex::NamespaceIndex(std::string directory)
+        : m_directory(std::move(directory))
+    {
+    }
+
+    bool NamespaceIndex::Covers(const std::string_view realPath) const noexcept
+    {
+        if (m_directory.empty() || realPath == m_directory)
+        {
+            return true;
+        }
+
+        return realPath.size() > m_directory.size() &&
+            realPath.starts_with(m_directory) &&
+            realPath[m_directory.size()] == '/';
+    }
+
+    std::string NamespaceIndex::ListingPrefix() const
+    {
+        return m_directory.empty() ? m_directory : m_directory + "/";
+    }
+
+    void NamespaceIndex::Put(const std::string_view realPath, const std::optional<int64_t> size, const uint64_t modifiedTime)
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_entries.find(realPath);
+        if (it != m_entries.end())
+        {
+            it->second = Entry{ size, modifiedTime };
+        }
+        else
+        {
+            m_entries.emplace(realPath, Entry{ size, modifiedTime });
+        }
+    }
+
+    void NamespaceIndex::Update(const std::string_view realPath, const int64_t size, const uint64_t modifiedTime)
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_entries.find(realPath);
+        if (it != m_entries.end())
+        {
+            it->second = Entry{ size, modifiedTime };
+        }
+    }
+
+    bool NamespaceIndex::Remove(const std::string_view realPath)
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_entries.find(realPath);
+        if (it == m_entries.end())
+        {
+            return false;
+        }
+
+        m_entries.erase(it);
+        return true;
+    }
+
+    void NamespaceIndex::RemovePrefix(const std::string_view prefix)
+    {
+        std::scoped_lock lock(m_mutex);
+        auto it = m_entries.lower_bound(prefix);
+        while (it != m_entries.end() && it->first.starts_with(prefix))
+        {
+            it = m_entries.erase(it);
+        }
+    }
+
+    void NamespaceIndex::Rename(const std::string_view from, const std::string_view to, const uint64_t modifiedTime)
+    {
+        std::scoped_lock lock(m_mutex);
+        std::optional<int64_t> size;
+        if (const auto it = m_entries.find(from); it != m_entries.end())
+        {
+            size = it->second.Size;
+            m_entries.erase(it);
+        }
+
+        // A source missing from the index still leaves a file behind, only its size isn't known.
+        m_entries.insert_or_assign(std::string(to), Entry{ size, modifiedTime });
+    }
+
+    std::optional<NamespaceIndex::Entry> NamespaceIndex::Find(const std::string_view realPath) const
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_entries.find(realPath);
+        if (it == m_entries.end())
+        {
+            return std::nullopt;
+        }
+
+        return it->second;
+    }
+
+    bool NamespaceIndex::HasChildren(const std::string_view realPath) const
+    {
+        const auto prefix = std::string(realPath) + "/";
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_entries.lower_bound(prefix);
+        return it != m_entries.end() && it->first.starts_with(prefix);
+    }
+
+    std::vector<std::pair<std::string, NamespaceIndex::Entry>> NamespaceIndex::List(const std::string_view prefix) const
+    {
+        std::vector<std::pair<std::string, Entry>> entries;
+        std::scoped_lock lock(m_mutex);
+        for (auto it = m_entries.lower_bound(prefix); it != m_entries.end() && it->first.starts_with(prefix); ++it)
+        {
+            entries.emplace_back(it->first, it->second);
+        }
+
+        return entries;
+    }
+}
@@ -5,11 +5,14 @@
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/BlobHelpers.hpp"
 #include <azure/core/etag.hpp>
 #include <azure/core/context.hpp>
+#include <azure/core/exception.hpp>
+#include <algorithm>
 #include <cassert>
 namespace AVEVA::RocksDB::Plugin::Azure::Impl
 {
-    PageBlob::PageBlob(::Azure::Storage::Blobs::PageBlobClient client)
-        : m_client(std::move(client))
+    PageBlob::PageBlob(::Azure::Storage::Blobs::PageBlobClient client, std::string fileName)
+        : m_client(std::move(client)),
+        m_fileName(std::move(fileName))
     {
     }
 
@@ -20,7 +23,7 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
 
     void PageBlob::SetSize(int64_t size)
     {
-        BlobHelpers::SetFileSize(m_client, size);
+        BlobHelpers::SetFileSize(m_client, size, m_fileName);
     }
 
     int64_t PageBlob::GetCapacity()
@@ -79,4 +82,34 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         assert(static_cast<int>(content.ContentRange.Length.ValueOr(-1)) == bytesRead && "Bytes read differ from server ContentRange");
         return bytesRead;
     }
+
+    int64_t PageBlob::DownloadLatest(std::span<char> buffer, int64_t offset, int64_t length, BlobInfo& info)
+    {
+        // The size metadata and ETag come back with the data, so the read needs no properties request first.
+        ::Azure::Storage::Blobs::DownloadBlobOptions options
+        {
+          .Range = ::Azure::Core::Http::HttpRange { offset, length }
+        };
+
+        try
+        {
+            const auto result = m_client.Download(options, ::Azure::Core::Context{});
+            const auto& content = result.Value;
+            info = BlobInfo{ BlobHelpers::GetFileSize(content, m_client), content.Details.ETag };
+
+            const auto bytesRead = static_cast<int64_t>(content.BodyStream->ReadToCount(reinterpret_cast<uint8_t*>(buffer.data()), buffer.size()));
+            return std::clamp<int64_t>(info.Size - offset, 0, bytesRead);
+        }
+        catch (const ::Azure::Core::RequestFailedException& ex)
+        {
+            if (ex.StatusCode != ::Azure::Core::Http::HttpStatusCode::RangeNotSatisfiable)
+            {
+                throw;
+            }
+        }
+
+        // The read starts past the blob's capacity, so there is nothing to return, only the properties to fetch.
+        info = BlobInfo{ GetSize(), GetEtag() };
+        return 0;
+    }
 }
@@ -7,23 +7,31 @@
 #include <boost/log/trivial.hpp>
 
 #include <algorithm>
+#include <span>
+#include <stdexcept>
 using namespace boost::log::trivial;
 namespace AVEVA::RocksDB::Plugin::Azure::Impl
 {
     ReadWriteFileImpl::ReadWriteFileImpl(std::string_view name,
         std::shared_ptr<Core::BlobClient> blobClient,
         std::shared_ptr<Core::FileCache> fileCache,
-        std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger)
+        std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
+        const int64_t cacheSize)
         : m_name(name),
         m_blobClient(std::move(blobClient)),
         m_fileCache(std::move(fileCache)),
         m_logger(std::move(logger)),
         m_size(m_blobClient->GetSize()),
         m_syncSize(m_size),
+        m_flushedSize(m_size),
         m_capacity(m_blobClient->GetCapacity()),
-        m_closed(false),
-        m_buffer(Configuration::PageBlob::DefaultBufferSize)
+        m_cacheSize(cacheSize),
+        m_closed(false)
     {
+        if (m_cacheSize < Configuration::PageBlob::PageSize)
+        {
+            throw std::invalid_argument("Cache size cannot be smaller than a page");
+        }
     }
 
     ReadWriteFileImpl::~ReadWriteFileImpl()
@@ -54,10 +62,11 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         m_logger(std::move(other.m_logger)),
         m_size(other.m_size),
         m_syncSize(other.m_syncSize),
+        m_flushedSize(other.m_flushedSize),
         m_capacity(other.m_capacity),
+        m_cacheSize(other.m_cacheSize),
         m_closed(std::exchange(other.m_closed, true)),
-        m_buffer(std::move(other.m_buffer)),
-        m_bufferStats(std::move(other.m_bufferStats))
+        m_pages(std::move(other.m_pages))
     {
     }
 
@@ -69,10 +78,11 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         m_logger = std::move(other.m_logger);
         m_size = other.m_size;
         m_syncSize = other.m_syncSize;
+        m_flushedSize = other.m_flushedSize;
         m_capacity = other.m_capacity;
+        m_cacheSize = other.m_cacheSize;
         m_closed = std::exchange(other.m_closed, true);
-        m_buffer = std::move(other.m_buffer);
-        m_bufferStats = std::move(other.m_bufferStats);
+        m_pages = std::move(other.m_pages);
         return *this;
     }
 
@@ -101,160 +111,226 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
 
     void ReadWriteFileImpl::Flush()
     {
-		m_capacity = m_blobClient->GetCapacity();
-
-        // Pre-calculate the maximum size we'll need and expand if necessary
-        auto maxSizeNeeded = m_size;
-        for (const auto& chunk : m_bufferStats)
+        // Dirty pages only partly written locally get the rest of their bytes from the blob first.
+        std::vector<std::pair<int64_t, CachedPage*>> partialPages;
+        std::vector<std::pair<int64_t, std::vector<const CachedPage*>>> runs;
+        for (auto& [index, page] : m_pages)
         {
-            const auto chunkEnd = chunk.targetOffset + chunk.dataLength;
-            if (chunkEnd > maxSizeNeeded)
+            if (!page.Dirty)
+            {
+                continue;
+            }
+
+            if (!page.Loaded)
             {
-                maxSizeNeeded = chunkEnd;
+                partialPages.emplace_back(index, &page);
             }
+
+            // Consecutive dirty pages are uploaded together.
+            if (runs.empty() || runs.back().first + static_cast<int64_t>(runs.back().second.size()) != index)
+            {
+                runs.emplace_back(index, std::vector<const CachedPage*>{});
+            }
+
+            runs.back().second.push_back(&page);
         }
 
-        // Expand capacity if needed BEFORE processing chunks
-        while ((maxSizeNeeded + Configuration::PageBlob::PageSize) > m_capacity)
+        if (runs.empty())
         {
-            Expand();
+            return;
         }
 
-        // Flush has to happen per chunk in the buffer and fetch any partial pages
-        // to merge in existing data from the underlying page blob improvements could include
-        // checking for all partial pages and looking more globally through the buffer
-        // Also could reduce the allocation necessary through some initial padding
-        for (const auto& chunk : m_bufferStats)
-        {
-            assert(chunk.targetOffset >= chunk.prePadding && "Target Offset is smaller than Pre-padding");
+        BlobHelpers::RunConcurrently(static_cast<int64_t>(partialPages.size()), Configuration::PageBlob::DefaultUploadConcurrency,
+            [this, &partialPages](const int64_t i)
+            {
+                auto& [index, page] = partialPages[static_cast<size_t>(i)];
+                std::array<char, Configuration::PageBlob::PageSize> existing{};
+                m_blobClient->DownloadTo(existing, index * Configuration::PageBlob::PageSize, Configuration::PageBlob::PageSize);
+                for (size_t b = 0; b < existing.size(); ++b)
+                {
+                    if (!page->Written[b])
+                    {
+                        page->Data[b] = existing[b];
+                    }
+                }
 
-            const auto targetStart = chunk.targetOffset - chunk.prePadding;
-            assert(targetStart % Configuration::PageBlob::PageSize == 0 && "TargetStart should be page aligned");
+                page->Loaded = true;
+            });
 
-            if (chunk.prePadding > 0)
-            {
-                assert(chunk.prePadding < Configuration::PageBlob::PageSize && "Pre-padding should not exceed page size");
+        const auto& [lastIndex, lastPages] = runs.back();
+        const auto requiredCapacity = (lastIndex + static_cast<int64_t>(lastPages.size())) * Configuration::PageBlob::PageSize;
+        while (requiredCapacity > m_capacity)
+        {
+            Expand();
+        }
 
-                // read in the padding bits from first page
-                std::span<char> prePaddingBuffer(m_buffer.data() + chunk.bufferOffset, static_cast<size_t>(chunk.prePadding));
-                m_blobClient->DownloadTo(prePaddingBuffer, targetStart, chunk.prePadding);
-            }
-            if (chunk.postPadding > 0)
+        BlobHelpers::RunConcurrently(static_cast<int64_t>(runs.size()), Configuration::PageBlob::DefaultUploadConcurrency,
+            [this, &runs](const int64_t i)
             {
-                auto targetEnd = chunk.targetOffset + chunk.dataLength;
-                assert((targetEnd + chunk.postPadding) % Configuration::PageBlob::PageSize == 0 && "TargetEnd should be page aligned");
-                assert((targetEnd + chunk.postPadding) <= m_capacity && "We shouldn't try to read data that isn't at least reserved");
-
-                // NOTE: If the data we're writing is APPENDED at the end, this post padding may be trash data and can be skipped.
-                if (!(targetEnd > m_size))
+                const auto& [index, pages] = runs[static_cast<size_t>(i)];
+                std::vector<char> buffer;
+                buffer.reserve(pages.size() * static_cast<size_t>(Configuration::PageBlob::PageSize));
+                for (const auto* page : pages)
                 {
-                    assert(chunk.postPadding < Configuration::PageBlob::PageSize && "PostPadding shouldn't be greater than a page's size");
-
-                    // read in the padding bits from last page
-                    std::span<char> postPaddingBuffer(&m_buffer[static_cast<size_t>(chunk.bufferOffset + chunk.prePadding + chunk.dataLength)], static_cast<size_t>(chunk.postPadding));
-                    m_blobClient->DownloadTo(postPaddingBuffer, targetEnd, chunk.postPadding);
+                    buffer.insert(buffer.end(), page->Data.begin(), page->Data.end());
                 }
-            }
 
-            if ((chunk.targetOffset + chunk.dataLength) > m_size)
-            {
-                m_size = chunk.targetOffset + chunk.dataLength;
-            }
-
-            std::span<char> uploadBuffer(&m_buffer[static_cast<size_t>(chunk.bufferOffset)], static_cast<size_t>(chunk.ChunkSize()));
-            m_blobClient->UploadPages(uploadBuffer, targetStart);
+                BlobHelpers::UploadPages(*m_blobClient, buffer, index * Configuration::PageBlob::PageSize);
+            });
 
-            BOOST_LOG_SEV(*m_logger, debug) << "Flushed " << chunk.ChunkSize() << " bytes to read/writeable file '" << m_name << "'";
+        int64_t pagesWritten = 0;
+        for (const auto& [index, pages] : runs)
+        {
+            pagesWritten += static_cast<int64_t>(pages.size());
         }
 
-        m_bufferStats.clear();
+        for (auto& [index, page] : m_pages)
+        {
+            page.Dirty = false;
+        }
 
-#if _DEBUG
-        // NOTE: This is to ensure predictable output in tests.
-        std::fill(m_buffer.begin(), m_buffer.end(), '\0');
-#endif // _DEBUG
+        m_flushedSize = std::max(m_flushedSize, m_size);
+        BOOST_LOG_SEV(*m_logger, debug) << "Flushed " << pagesWritten << " dirty pages as " << runs.size() << " uploads to read/writeable file '" << m_name << "'";
     }
 
     void ReadWriteFileImpl::Write(int64_t offset, const char* data, int64_t size)
     {
-        // This one is TRICKY. Incomplete pages must track the location within a page
-        // along with length information and then fetch the relevant page before committing
-        // likely to be lots of room for optimization maybe around allocation
         auto* dataPos = data;
-        auto targetOffset = offset;
-        auto bufferOffset = m_bufferStats.empty()
-            ? 0LL
-            : m_bufferStats.back().bufferOffset + m_bufferStats.back().ChunkSize();
         while (size > 0)
         {
-            const int64_t space = static_cast<int64_t>(m_buffer.size()) - bufferOffset;
-            auto numBytes = std::min(size, space);
+            const auto pageIndex = offset / Configuration::PageBlob::PageSize;
+            const auto pageOffset = offset % Configuration::PageBlob::PageSize;
+            const auto numBytes = std::min(size, Configuration::PageBlob::PageSize - pageOffset);
+
+            auto& page = GetPageForWrite(pageIndex);
+            std::copy(dataPos, dataPos + numBytes, page.Data.begin() + pageOffset);
+            if (!page.Loaded)
+            {
+                for (auto b = pageOffset; b < pageOffset + numBytes; ++b)
+                {
+                    page.Written.set(static_cast<size_t>(b));
+                }
+
+                page.Loaded = page.Written.all();
+            }
+
+            page.Dirty = true;
+            size -= numBytes;
+            offset += numBytes;
+            dataPos += numBytes;
+            m_size = std::max(m_size, offset);
+        }
+    }
+
+    int64_t ReadWriteFileImpl::Read(int64_t offset, int64_t bytesRequested, char* buffer) const
+    {
+        if (offset >= m_size)
+        {
+            return 0;
+        }
 
-            // calculate the relevant padding to leave space to merge
-            // existing page data when flushing
-            const auto startPaddingFirstPage = targetOffset % Configuration::PageBlob::PageSize;
+        bytesRequested = std::min(bytesRequested, m_size - offset);
+        const auto end = offset + bytesRequested;
 
-            int64_t endPaddingLastPage;
-            const auto dataEndPos = (targetOffset + numBytes) % Configuration::PageBlob::PageSize;
-            if (dataEndPos == 0)
+        // Cached pages are copied out, the gaps between them are read from the file cache or the blob.
+        auto position = offset;
+        for (auto it = m_pages.lower_bound(offset / Configuration::PageBlob::PageSize);
+            it != m_pages.end() && it->first * Configuration::PageBlob::PageSize < end; ++it)
+        {
+            const auto pageStart = it->first * Configuration::PageBlob::PageSize;
+            if (position < pageStart)
             {
-                endPaddingLastPage = 0;
+                ReadFromBlob(position, pageStart - position, buffer + (position - offset));
+                position = pageStart;
+            }
+
+            const auto& page = it->second;
+            const auto from = position - pageStart;
+            const auto to = std::min(end - pageStart, Configuration::PageBlob::PageSize);
+            if (!page.Loaded)
+            {
+                // Only the locally written bytes are cached, the rest come from the blob.
+                ReadFromBlob(position, to - from, buffer + (position - offset));
+                for (auto b = from; b < to; ++b)
+                {
+                    if (page.Written[static_cast<size_t>(b)])
+                    {
+                        buffer[position - offset + (b - from)] = page.Data[static_cast<size_t>(b)];
+                    }
+                }
             }
             else
             {
-                endPaddingLastPage = Configuration::PageBlob::PageSize - dataEndPos;
+                std::copy(page.Data.begin() + from, page.Data.begin() + to, buffer + (position - offset));
             }
 
+            position = pageStart + to;
+        }
 
-            const auto totalBytesNeeded = startPaddingFirstPage + numBytes + endPaddingLastPage;
-            assert(totalBytesNeeded % Configuration::PageBlob::PageSize == 0 && "totalBytesNeeded should be page aligned");
-
-            if (totalBytesNeeded > space)
-            {
-                numBytes -= (Configuration::PageBlob::PageSize - endPaddingLastPage);
-                endPaddingLastPage = 0;
-            }
+        if (position < end)
+        {
+            ReadFromBlob(position, end - position, buffer + (position - offset));
+        }
 
-            assert((bufferOffset + startPaddingFirstPage + numBytes) <= static_cast<int64_t>(m_buffer.size()) && "calculated total offset must be less than buffer size");
-            auto* bufPos = m_buffer.data() + bufferOffset + startPaddingFirstPage;
-            std::copy(dataPos, dataPos + numBytes, bufPos);
+        return bytesRequested;
+    }
 
-            size -= numBytes;
-            BufferChunkInfo info(bufferOffset, targetOffset, numBytes, startPaddingFirstPage, endPaddingLastPage);
-            m_bufferStats.push_back(info);
-            targetOffset += numBytes;
-            dataPos += numBytes;
-            bufferOffset += info.ChunkSize();
+    ReadWriteFileImpl::CachedPage& ReadWriteFileImpl::GetPageForWrite(const int64_t pageIndex)
+    {
+        const auto existing = m_pages.find(pageIndex);
+        if (existing != m_pages.end())
+        {
+            return existing->second;
+        }
 
-            if (bufferOffset >= (Configuration::PageBlob::DefaultBufferSize - Configuration::PageBlob::PageSize))
+        // Make room for the new page, writing everything back if only dirty pages are left.
+        const auto newSize = static_cast<int64_t>(m_pages.size() + 1) * Configuration::PageBlob::PageSize;
+        if (newSize > m_cacheSize)
+        {
+            EvictCleanPages(m_cacheSize - Configuration::PageBlob::PageSize);
+            if (static_cast<int64_t>(m_pages.size() + 1) * Configuration::PageBlob::PageSize > m_cacheSize)
             {
                 Flush();
-                bufferOffset = 0;
+                EvictCleanPages(m_cacheSize - Configuration::PageBlob::PageSize);
             }
         }
+
+        auto& page = m_pages[pageIndex];
+
+        // Pages past the data in the blob have nothing to merge.
+        page.Loaded = pageIndex * Configuration::PageBlob::PageSize >= m_flushedSize;
+        return page;
     }
 
-    int64_t ReadWriteFileImpl::Read(int64_t offset, int64_t bytesRequested, char* buffer) const
+    void ReadWriteFileImpl::EvictCleanPages(const int64_t targetSize)
     {
-        if (offset >= m_syncSize)
+        for (auto it = m_pages.begin(); it != m_pages.end() && static_cast<int64_t>(m_pages.size()) * Configuration::PageBlob::PageSize > targetSize;)
         {
-            return 0;
+            it = it->second.Dirty ? std::next(it) : m_pages.erase(it);
         }
+    }
 
-        if (m_fileCache)
+    int64_t ReadWriteFileImpl::ReadFromBlob(const int64_t offset, const int64_t length, char* buffer) const
+    {
+        if (m_fileCache && offset + length <= m_syncSize)
         {
-            const auto bytesRead = m_fileCache->ReadFile(m_name, offset, bytesRequested, buffer);
-            if (bytesRead)
+            const auto bytesRead = m_fileCache->ReadFile(m_name, offset, length, buffer);
+            if (bytesRead && static_cast<int64_t>(*bytesRead) == length)
             {
-                return static_cast<int64_t>(*bytesRead);
+                return length;
             }
         }
 
-        const auto bytesCanRead = m_syncSize - offset;
-        if (bytesCanRead < bytesRequested) bytesRequested = bytesCanRead;
+        // Holes past the flushed data that haven't been written yet read as zeros.
+        const auto available = std::clamp(std::min(m_flushedSize, m_capacity) - offset, int64_t{ 0 }, length);
+        std::fill(buffer + available, buffer + length, '\0');
+        if (available > 0)
+        {
+            std::span<char> readBuffer(buffer, static_cast<size_t>(available));
+            m_blobClient->DownloadTo(readBuffer, offset, available);
+        }
 
-        std::span<char> readBuffer(buffer, static_cast<size_t>(bytesRequested));
-        return m_blobClient->DownloadTo(readBuffer, offset, bytesRequested);
+        return length;
     }
 
     void ReadWriteFileImpl::Expand()
@@ -5,7 +5,10 @@
 
 #include <boost/log/trivial.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <optional>
+#include <system_error>
 #include <azure/core/exception.hpp>
 
 using namespace boost::log::trivial;
@@ -14,15 +17,18 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
     ReadableFileImpl::ReadableFileImpl(std::string_view name,
         std::shared_ptr<Core::BlobClient> blobClient,
         std::shared_ptr<Core::FileCache> fileCache,
-        std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger)
+        std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
+        const int64_t readahead)
         : m_name(name),
         m_blobClient(std::move(blobClient)),
         m_fileCache(std::move(fileCache)),
         m_offset(0),
-        m_size(m_blobClient ? m_blobClient->GetSize() : 0LL),
+        m_size(0),
+        m_firstRead(std::make_unique<std::once_flag>()),
+        m_readahead(std::max<int64_t>(readahead, 0)),
+        m_readaheadOffset(0),
         m_logger(std::move(logger))
     {
-        m_etag = m_blobClient->GetEtag();
     }
 
     int64_t ReadableFileImpl::SequentialRead(const int64_t bytesToRead, char* buffer)
@@ -40,13 +46,35 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
                 m_offset += static_cast<int64_t>(*bytesRead);
                 return static_cast<int64_t>(*bytesRead);
             }
-        }       
+        }
 
-        assert(m_size >= m_offset && "m_size needs to be bigger than m_offset or else we will overflow");
+        const auto bufferedEnd = m_readaheadOffset + static_cast<int64_t>(m_readaheadBuffer.size());
+        if (m_offset >= m_readaheadOffset && m_offset < bufferedEnd)
+        {
+            const auto bytesRead = std::min(bytesToRead, bufferedEnd - m_offset);
+            std::copy_n(m_readaheadBuffer.begin() + (m_offset - m_readaheadOffset), bytesRead, buffer);
+            m_offset += bytesRead;
+            return bytesRead;
+        }
 
-        auto bytesRead = DownloadWithRetry(m_offset, bytesToRead, buffer);
-        bytesRead = std::max<int64_t>(bytesRead, 0);
+        if (bytesToRead >= m_readahead)
+        {
+            auto bytesRead = DownloadWithRetry(m_offset, bytesToRead, buffer);
+            bytesRead = std::max<int64_t>(bytesRead, 0);
 
+            m_offset += bytesRead;
+            return bytesRead;
+        }
+
+        // A short read near the end of the file leaves less in the buffer, and reads past it go to blob storage again
+        // in case the file has grown.
+        m_readaheadBuffer.resize(static_cast<size_t>(m_readahead));
+        const auto buffered = std::max<int64_t>(DownloadWithRetry(m_offset, m_readahead, m_readaheadBuffer.data()), 0);
+        m_readaheadBuffer.resize(static_cast<size_t>(buffered));
+        m_readaheadOffset = m_offset;
+
+        const auto bytesRead = std::min(bytesToRead, buffered);
+        std::copy_n(m_readaheadBuffer.begin(), bytesRead, buffer);
         m_offset += bytesRead;
         return bytesRead;
     }
@@ -92,6 +120,36 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
 
     int64_t ReadableFileImpl::DownloadWithRetry(const int64_t offset, const int64_t bytesToRead, char* buffer) const
     {
+        std::optional<int64_t> firstBytesRead;
+        std::call_once(*m_firstRead, [this, offset, bytesToRead, buffer, &firstBytesRead]()
+            {
+                // Concurrent first reads wait here, and go on to read against the ETag this one learns.
+                Core::BlobClient::BlobInfo info{};
+                try
+                {
+                    firstBytesRead = m_blobClient->DownloadLatest(std::span<char>(buffer, static_cast<size_t>(bytesToRead)), offset, bytesToRead, info);
+                }
+                catch (const ::Azure::Core::RequestFailedException& ex)
+                {
+                    // Opening didn't check the blob, so this is where a missing file shows.
+                    if (ex.StatusCode == ::Azure::Core::Http::HttpStatusCode::NotFound)
+                    {
+                        throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory), m_name);
+                    }
+
+                    throw;
+                }
+
+                m_size = info.Size;
+                m_etag = info.ETag;
+                BOOST_LOG_SEV(*m_logger, debug) << "Blob metadata read with the first read of file '" << m_name << "' :size = " << m_size << " bytes";
+            });
+
+        if (firstBytesRead)
+        {
+            return *firstBytesRead;
+        }
+
         int64_t bytesRead = 0;
 
         bool success = false;
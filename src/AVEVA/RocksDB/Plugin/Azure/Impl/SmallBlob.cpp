@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/SmallBlob.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    SmallBlob::SmallBlob(::Azure::Storage::Blobs::BlockBlobClient client, std::shared_ptr<SmallFileCache> cache, std::string cacheKey)
+        : m_client(std::move(client)),
+        m_cache(std::move(cache)),
+        m_cacheKey(std::move(cacheKey)),
+        m_dirty(true)
+    {
+    }
+
+    SmallBlob::SmallBlob(::Azure::Storage::Blobs::BlockBlobClient client,
+        std::shared_ptr<SmallFileCache> cache,
+        std::string cacheKey,
+        SmallFileCache::Entry contents)
+        : m_client(std::move(client)),
+        m_cache(std::move(cache)),
+        m_cacheKey(std::move(cacheKey)),
+        m_data(std::move(contents.Contents)),
+        m_etag(std::move(contents.ETag)),
+        m_dirty(false)
+    {
+    }
+
+    int64_t SmallBlob::GetSize()
+    {
+        std::scoped_lock lock(m_mutex);
+        return static_cast<int64_t>(m_data.size());
+    }
+
+    void SmallBlob::SetSize(const int64_t size)
+    {
+        std::scoped_lock lock(m_mutex);
+        if (!m_dirty && size == static_cast<int64_t>(m_data.size()))
+        {
+            return;
+        }
+
+        // Uploaded pages are padded to the page size, the padding is cut off here.
+        m_data.resize(static_cast<size_t>(size));
+        ::Azure::Core::IO::MemoryBodyStream dataStream(reinterpret_cast<const uint8_t*>(m_data.data()), m_data.size());
+        m_etag = m_client.Upload(dataStream).Value.ETag;
+        m_dirty = false;
+
+        if (m_cache)
+        {
+            m_cache->Put(m_cacheKey, SmallFileCache::Entry{ m_data, m_etag });
+        }
+    }
+
+    int64_t SmallBlob::GetCapacity()
+    {
+        // The file is held in memory until it is written in one piece, there is nothing to reserve.
+        return std::numeric_limits<int64_t>::max();
+    }
+
+    void SmallBlob::SetCapacity(int64_t)
+    {
+    }
+
+    void SmallBlob::DownloadTo(const std::string& path, const int64_t offset, const int64_t length)
+    {
+        std::vector<char> buffer(static_cast<size_t>(std::max<int64_t>(length, 0)));
+        const auto copied = Copy(buffer, offset, length);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(buffer.data(), copied);
+        if (!file)
+        {
+            throw std::runtime_error("Failed to write small file to '" + path + "'");
+        }
+    }
+
+    int64_t SmallBlob::DownloadTo(const std::span<char> buffer, const int64_t blobOffset, const int64_t readLength)
+    {
+        return Copy(buffer, blobOffset, readLength);
+    }
+
+    int64_t SmallBlob::Download(const std::span<char> buffer, const int64_t blobOffset, const int64_t readLength, const ::Azure::ETag&)
+    {
+        // The buffer is the version the reader opened, so it always matches the ETag handed out with it.
+        return Copy(buffer, blobOffset, readLength);
+    }
+
+    void SmallBlob::UploadPages(const std::span<char> buffer, const int64_t blobOffset)
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto end = static_cast<size_t>(blobOffset) + buffer.size();
+        if (m_data.size() < end)
+        {
+            m_data.resize(end);
+        }
+
+        std::copy(buffer.begin(), buffer.end(), m_data.begin() + blobOffset);
+        m_dirty = true;
+    }
+
+    ::Azure::ETag SmallBlob::GetEtag()
+    {
+        std::scoped_lock lock(m_mutex);
+        return m_etag;
+    }
+
+    int64_t SmallBlob::Copy(const std::span<char> buffer, const int64_t offset, const int64_t length)
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto size = static_cast<int64_t>(m_data.size());
+        if (offset < 0 || offset >= size)
+        {
+            return 0;
+        }
+
+        const auto count = std::min({ length, size - offset, static_cast<int64_t>(buffer.size()) });
+        std::copy_n(m_data.begin() + offset, count, buffer.begin());
+        return count;
+    }
+}
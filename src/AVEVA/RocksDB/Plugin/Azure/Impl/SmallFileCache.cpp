@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/SmallFileCache.hpp"
+
+#include <algorithm>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    SmallFileCache::SmallFileCache(const size_t maxFiles)
+        : m_maxFiles(std::max<size_t>(maxFiles, 1)),
+        m_clock(0)
+    {
+    }
+
+    std::optional<SmallFileCache::Entry> SmallFileCache::Find(const std::string_view name)
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_files.find(name);
+        if (it == m_files.end())
+        {
+            return std::nullopt;
+        }
+
+        it->second.LastUsed = ++m_clock;
+        return it->second.Value;
+    }
+
+    void SmallFileCache::Put(const std::string_view name, Entry entry)
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_files.find(name);
+        if (it != m_files.end())
+        {
+            it->second = Slot{ std::move(entry), ++m_clock };
+            return;
+        }
+
+        if (m_files.size() >= m_maxFiles)
+        {
+            // Only a handful of files are kept, a scan is cheaper than maintaining a recency list.
+            m_files.erase(std::min_element(m_files.begin(), m_files.end(), [](const auto& lhs, const auto& rhs)
+                {
+                    return lhs.second.LastUsed < rhs.second.LastUsed;
+                }));
+        }
+
+        m_files.emplace(name, Slot{ std::move(entry), ++m_clock });
+    }
+
+    void SmallFileCache::Remove(const std::string_view name)
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_files.find(name);
+        if (it != m_files.end())
+        {
+            m_files.erase(it);
+        }
+    }
+
+    void SmallFileCache::RemovePrefix(const std::string_view prefix)
+    {
+        std::scoped_lock lock(m_mutex);
+        std::erase_if(m_files, [prefix](const auto& file) { return file.first.starts_with(prefix); });
+    }
+}
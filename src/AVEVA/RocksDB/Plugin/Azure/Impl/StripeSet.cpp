@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/StripeSet.hpp"
+#include "AVEVA/RocksDB/Plugin/Core/RocksDBHelpers.hpp"
+
+#include <cctype>
+#include <stdexcept>
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    // Both hashes have to give the same answer on every platform and release, so std::hash can't be used.
+    static uint64_t HashName(const std::string_view name)
+    {
+        // 64-bit FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        for (const auto c : name)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    static uint64_t Mix(uint64_t value)
+    {
+        // splitmix64 finalizer
+        value += 0x9e3779b97f4a7c15ull;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+
+    static uint64_t FileKey(const std::string_view realPath)
+    {
+        const auto separator = realPath.find_last_of('/');
+        const auto name = separator == std::string_view::npos ? realPath : realPath.substr(separator + 1);
+
+        // RocksDB names these files after their number, which is what they are placed by. Other names are hashed whole.
+        uint64_t number = 0;
+        size_t digits = 0;
+        while (digits < name.size() && std::isdigit(static_cast<unsigned char>(name[digits])) != 0)
+        {
+            number = number * 10 + static_cast<uint64_t>(name[digits] - '0');
+            ++digits;
+        }
+
+        return digits > 0 && digits < name.size() && name[digits] == '.' ? number : HashName(name);
+    }
+
+    StripeSet::StripeSet(std::vector<Stripe> stripes)
+        : m_stripes(std::move(stripes))
+    {
+        if (m_stripes.empty())
+        {
+            throw std::invalid_argument("A stripe set needs at least the primary container");
+        }
+
+        m_stripes.front().AcceptsNewFiles = true;
+        for (const auto& stripe : m_stripes)
+        {
+            m_seeds.push_back(HashName(stripe.Name));
+        }
+    }
+
+    bool StripeSet::IsStriped(const std::string_view realPath)
+    {
+        const auto fileType = Core::RocksDBHelpers::GetFileType(realPath);
+        return fileType == Core::RocksDBHelpers::FileClass::SST || fileType == Core::RocksDBHelpers::FileClass::Blob;
+    }
+
+    size_t StripeSet::Place(const std::string_view realPath) const
+    {
+        if (!IsStriped(realPath))
+        {
+            return 0;
+        }
+
+        const auto key = FileKey(realPath);
+        size_t best = 0;
+        uint64_t bestScore = 0;
+        for (size_t i = 0; i < m_stripes.size(); ++i)
+        {
+            if (!m_stripes[i].AcceptsNewFiles)
+            {
+                continue;
+            }
+
+            const auto score = Mix(m_seeds[i] ^ Mix(key));
+            if (score > bestScore || i == 0)
+            {
+                best = i;
+                bestScore = score;
+            }
+        }
+
+        return best;
+    }
+
+    size_t StripeSet::Locate(const std::string_view realPath) const
+    {
+        if (const auto stripe = Find(realPath))
+        {
+            return *stripe;
+        }
+
+        return Place(realPath);
+    }
+
+    std::optional<size_t> StripeSet::Find(const std::string_view realPath) const
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_locations.find(realPath);
+        if (it == m_locations.end())
+        {
+            return std::nullopt;
+        }
+
+        return it->second;
+    }
+
+    void StripeSet::Record(const std::string_view realPath, const size_t stripe)
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_locations.find(realPath);
+        if (it != m_locations.end())
+        {
+            it->second = stripe;
+        }
+        else
+        {
+            m_locations.emplace(realPath, stripe);
+        }
+    }
+
+    void StripeSet::RecordListed(const std::string_view realPath, const size_t stripe)
+    {
+        if (stripe == 0 && !IsStriped(realPath))
+        {
+            // Found where it would be looked for anyway.
+            return;
+        }
+
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_locations.find(realPath);
+        if (it == m_locations.end())
+        {
+            m_locations.emplace(realPath, stripe);
+        }
+        else if (it->second != stripe && stripe != Place(realPath))
+        {
+            it->second = stripe;
+        }
+    }
+
+    void StripeSet::Forget(const std::string_view realPath)
+    {
+        std::scoped_lock lock(m_mutex);
+        const auto it = m_locations.find(realPath);
+        if (it != m_locations.end())
+        {
+            m_locations.erase(it);
+        }
+    }
+
+    void StripeSet::ForgetPrefix(const std::string_view prefix)
+    {
+        std::scoped_lock lock(m_mutex);
+        auto it = m_locations.lower_bound(prefix);
+        while (it != m_locations.end() && it->first.starts_with(prefix))
+        {
+            it = m_locations.erase(it);
+        }
+    }
+
+    const StripeSet::Stripe& StripeSet::Get(const size_t stripe) const
+    {
+        return m_stripes.at(stripe);
+    }
+
+    size_t StripeSet::Size() const noexcept
+    {
+        return m_stripes.size();
+    }
+}
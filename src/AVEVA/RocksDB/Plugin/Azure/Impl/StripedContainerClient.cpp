@@ -0,0 +1,18 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/StripedContainerClient.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/PageBlob.hpp"
+namespace AVEVA::RocksDB::Plugin::Azure::Impl
+{
+    StripedContainerClient::StripedContainerClient(std::shared_ptr<StripeSet> stripes)
+        : m_stripes(std::move(stripes))
+    {
+    }
+
+    std::unique_ptr<Core::BlobClient> StripedContainerClient::GetBlobClient(const std::string& path)
+    {
+        const auto& stripe = m_stripes->Get(m_stripes->Locate(path));
+        return std::make_unique<PageBlob>(stripe.Container.GetPageBlobClient(path));
+    }
+}
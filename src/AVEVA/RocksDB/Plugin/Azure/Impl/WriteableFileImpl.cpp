@@ -9,37 +9,99 @@
 #include <boost/log/trivial.hpp>
 
 #include <algorithm>
+#include <array>
 using namespace ::Azure::Storage;
 using namespace ::Azure::Storage::Blobs;
 using namespace ::Azure::Core::IO;
 using namespace boost::log::trivial;
 namespace AVEVA::RocksDB::Plugin::Azure::Impl
 {
-    AVEVA::RocksDB::Plugin::Azure::Impl::WriteableFileImpl::WriteableFileImpl(const std::string_view name,
+    WriteableFileImpl::WriteableFileImpl(const std::string_view name,
         std::shared_ptr<Core::BlobClient> blobClient,
         std::shared_ptr<Core::FileCache> fileCache,
         std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
-        const int64_t bufferSize)
+        const int64_t bufferSize,
+        const int64_t bufferCount,
+        const int64_t uploadConcurrency,
+        const bool sizeTrailer,
+        const DurabilityMode durability)
+        : WriteableFileImpl(name,
+            blobClient,
+            BlobState{ blobClient->GetSize(), blobClient->GetCapacity() },
+            std::move(fileCache),
+            std::move(logger),
+            bufferSize,
+            bufferCount,
+            uploadConcurrency,
+            sizeTrailer,
+            durability)
+    {
+    }
+
+    WriteableFileImpl::WriteableFileImpl(const std::string_view name,
+        std::shared_ptr<Core::BlobClient> blobClient,
+        const BlobState state,
+        std::shared_ptr<Core::FileCache> fileCache,
+        std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
+        const int64_t bufferSize,
+        const int64_t bufferCount,
+        const int64_t uploadConcurrency,
+        const bool sizeTrailer,
+        const DurabilityMode durability)
         : m_name(name),
         m_bufferSize(bufferSize),
+        m_bufferCount(bufferCount),
+        m_uploadConcurrency(uploadConcurrency),
+        m_preallocationBlockSize(0),
+        m_durability(durability),
         m_blobClient(std::move(blobClient)),
         m_fileCache(std::move(fileCache)),
         m_logger(std::move(logger)),
         m_lastPageOffset(0),
-        m_size(m_blobClient->GetSize()),
-        m_capacity(m_blobClient->GetCapacity()),
+        m_size(state.Size),
+        m_capacity(state.Capacity),
         m_bufferOffset(0),
         m_closed(false),
-        m_flushed(true)
+        m_flushed(true),
+        m_sizeTrailer(sizeTrailer),
+        m_appendOnly(m_blobClient->IsAppendOnly()),
+        m_sync(std::make_unique<Synchronization>())
     {
         if (m_bufferSize < Configuration::PageBlob::PageSize)
         {
             throw std::invalid_argument("Buffer size cannot be smaller than a page");
         }
 
+        if (m_bufferCount < 1)
+        {
+            throw std::invalid_argument("Buffer count must be at least one");
+        }
+
+        if (m_uploadConcurrency < 1)
+        {
+            throw std::invalid_argument("Upload concurrency must be at least one");
+        }
+
+        if (m_sizeTrailer && m_bufferCount > 1)
+        {
+            throw std::invalid_argument("A size trailer can't be combined with multiple write buffers");
+        }
+
+        if (m_appendOnly && (m_bufferCount > 1 || m_sizeTrailer))
+        {
+            throw std::invalid_argument("Append only blobs are written from a single buffer without a size trailer");
+        }
+
         assert(m_bufferSize > 0);
-        m_buffer.resize(static_cast<size_t>(m_bufferSize));
-        if (m_size > 0) // Existing file with data
+
+        // The trailer page is uploaded straight after the data, so it gets a page of its own past the end of the buffer.
+        m_buffer.resize(static_cast<size_t>(m_sizeTrailer ? m_bufferSize + Configuration::PageBlob::PageSize : m_bufferSize));
+        if (m_appendOnly)
+        {
+            // Appends carry exactly the new bytes, so the buffer always starts where the blob ends.
+            m_lastPageOffset = m_size;
+        }
+        else if (m_size > 0) // Existing file with data
         {
             int64_t lastPageBytes;
             int64_t lastPageOffset;
@@ -83,6 +145,10 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
     WriteableFileImpl::WriteableFileImpl(WriteableFileImpl&& other) noexcept
         : m_name(std::move(other.m_name)),
         m_bufferSize(other.m_bufferSize),
+        m_bufferCount(other.m_bufferCount),
+        m_uploadConcurrency(other.m_uploadConcurrency),
+        m_preallocationBlockSize(other.m_preallocationBlockSize),
+        m_durability(other.m_durability),
         m_blobClient(std::move(other.m_blobClient)),
         m_fileCache(std::move(other.m_fileCache)),
         m_logger(std::move(other.m_logger)),
@@ -92,7 +158,14 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         m_bufferOffset(other.m_bufferOffset),
         m_closed(std::exchange(other.m_closed, true)),
         m_flushed(other.m_flushed),
-        m_buffer(std::move(other.m_buffer))
+        m_sizeTrailer(other.m_sizeTrailer),
+        m_appendOnly(other.m_appendOnly),
+        m_buffer(std::move(other.m_buffer)),
+        m_freeBuffers(std::move(other.m_freeBuffers)),
+        m_pendingUploads(std::move(other.m_pendingUploads)),
+        m_uploadError(std::move(other.m_uploadError)),
+        m_sync(std::move(other.m_sync)),
+        m_sizeListener(std::move(other.m_sizeListener))
     {
     }
 
@@ -100,6 +173,10 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
     {
         m_name = std::move(other.m_name);
         m_bufferSize = other.m_bufferSize;
+        m_bufferCount = other.m_bufferCount;
+        m_uploadConcurrency = other.m_uploadConcurrency;
+        m_preallocationBlockSize = other.m_preallocationBlockSize;
+        m_durability = other.m_durability;
         m_blobClient = std::move(other.m_blobClient);
         m_fileCache = std::move(other.m_fileCache);
         m_logger = std::move(other.m_logger);
@@ -109,7 +186,14 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         m_bufferOffset = other.m_bufferOffset;
         m_closed = std::exchange(other.m_closed, true);
         m_flushed = other.m_flushed;
+        m_sizeTrailer = other.m_sizeTrailer;
+        m_appendOnly = other.m_appendOnly;
         m_buffer = std::move(other.m_buffer);
+        m_freeBuffers = std::move(other.m_freeBuffers);
+        m_pendingUploads = std::move(other.m_pendingUploads);
+        m_uploadError = std::move(other.m_uploadError);
+        m_sync = std::move(other.m_sync);
+        m_sizeListener = std::move(other.m_sizeListener);
         return *this;
     }
 
@@ -117,13 +201,24 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
     {
         if (!m_closed)
         {
-            Sync();
+            SyncToBlob();
+            if (m_sizeTrailer)
+            {
+                // Readers of a closed file get the size from the metadata without looking for the trailer.
+                std::scoped_lock syncLock(m_sync->Syncs);
+                m_blobClient->SetSize(GetFileSize());
+                m_sizeTrailer = false;
+            }
+
             m_closed = true;
         }
     }
 
     void WriteableFileImpl::Append(const std::span<const char> data)
     {
+        std::scoped_lock lock(m_sync->State);
+        ThrowIfUploadFailed();
+
         const char* dataPos = data.data();
         auto dataSize = static_cast<int64_t>(data.size());
         while (dataSize > 0)
@@ -131,7 +226,45 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
             const auto spaceLeft = m_bufferSize - m_bufferOffset;
             if (spaceLeft < Configuration::PageBlob::PageSize)
             {
-                Flush();
+                if (m_bufferCount > 1)
+                {
+                    // Hand the full buffer to the background and keep filling the next one.
+                    UploadFullPagesAsync();
+                }
+                else
+                {
+                    FlushBuffer();
+                }
+
+                continue;
+            }
+
+            // Appends of at least a buffer skip it. Only the bytes completing the last buffered page are copied,
+            // then the whole pages are uploaded straight from the caller's memory.
+            const auto head = (Configuration::PageBlob::PageSize - m_bufferOffset % Configuration::PageBlob::PageSize) % Configuration::PageBlob::PageSize;
+            if (!m_sizeTrailer && !m_appendOnly && dataSize - head >= m_bufferSize)
+            {
+                std::copy(dataPos, dataPos + head, m_buffer.data() + m_bufferOffset);
+                dataSize -= head;
+                m_bufferOffset += head;
+                dataPos += head;
+                m_size += head;
+                if (m_bufferOffset > 0)
+                {
+                    m_flushed = false;
+                    if (m_bufferCount > 1)
+                    {
+                        UploadFullPagesAsync();
+                    }
+                    else
+                    {
+                        FlushBuffer();
+                    }
+                }
+
+                const auto bytesUploaded = UploadDirect(std::span(dataPos, static_cast<size_t>(dataSize)));
+                dataSize -= bytesUploaded;
+                dataPos += bytesUploaded;
                 continue;
             }
 
@@ -148,6 +281,31 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
     }
 
     void WriteableFileImpl::Flush()
+    {
+        std::scoped_lock lock(m_sync->State);
+        ThrowIfUploadFailed();
+        if (m_durability != DurabilityMode::Flush)
+        {
+            // The data stays buffered until Sync or Close, full buffers are still uploaded by Append.
+            return;
+        }
+
+        if (m_bufferCount > 1)
+        {
+            // Only whole pages are uploaded in the background. The partial last page stays
+            // buffered until the next sync so it isn't rewritten on every flush.
+            if (!m_flushed && m_bufferOffset >= Configuration::PageBlob::PageSize)
+            {
+                UploadFullPagesAsync();
+            }
+
+            return;
+        }
+
+        FlushBuffer();
+    }
+
+    void WriteableFileImpl::FlushBuffer()
     {
         if (m_bufferOffset == 0)
         {
@@ -160,13 +318,13 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
             return;
         }
 
-        const auto [remaining, bytesToWrite] = BlobHelpers::RoundToEndOfNearestPage(m_bufferOffset);
-        if ((m_lastPageOffset + bytesToWrite) > m_capacity)
+        const auto bytesToWrite = ReserveFlush();
+        const auto remaining = m_appendOnly ? 0 : m_bufferOffset % Configuration::PageBlob::PageSize;
         {
-            Expand();
+            std::scoped_lock uploadLock(m_sync->Uploads);
+            UploadBuffer(m_buffer, bytesToWrite, m_lastPageOffset, m_size);
         }
 
-        m_blobClient->UploadPages(std::span(m_buffer.begin(), m_buffer.begin() + bytesToWrite), m_lastPageOffset);
         if (remaining != 0)
         {
             const auto residualOffsetBegin = m_bufferOffset - remaining;
@@ -180,33 +338,216 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
 
         BOOST_LOG_SEV(*m_logger, debug) << "Flushed " << bytesToWrite << " bytes to writeable file '" << m_name << "'.";
         m_bufferOffset = remaining;
-        m_lastPageOffset = (m_size / Configuration::PageBlob::PageSize) * Configuration::PageBlob::PageSize;
+        m_lastPageOffset = m_appendOnly ? m_size : (m_size / Configuration::PageBlob::PageSize) * Configuration::PageBlob::PageSize;
+        m_flushed = true;
+    }
+
+    int64_t WriteableFileImpl::UploadDirect(const std::span<const char> data)
+    {
+        assert(m_bufferOffset == 0);
+        const auto [_, bytesToWrite] = BlobHelpers::RoundToBeginningOfNearestPage(static_cast<int64_t>(data.size()));
+        if ((m_lastPageOffset + bytesToWrite) > m_capacity)
+        {
+            Expand(m_lastPageOffset + bytesToWrite);
+        }
+
+        {
+            // Uploading only reads the pages, the span is non-const to fit the client interface.
+            std::scoped_lock uploadLock(m_sync->Uploads);
+            const auto pages = std::span(const_cast<char*>(data.data()), static_cast<size_t>(bytesToWrite));
+            BlobHelpers::UploadPages(*m_blobClient, pages, m_lastPageOffset, m_uploadConcurrency);
+        }
+
+        BOOST_LOG_SEV(*m_logger, debug) << "Uploaded " << bytesToWrite << " bytes directly to writeable file '" << m_name << "'.";
+        m_lastPageOffset += bytesToWrite;
+        m_size += bytesToWrite;
         m_flushed = true;
+        return bytesToWrite;
+    }
+
+    int64_t WriteableFileImpl::ReserveFlush()
+    {
+        if (m_appendOnly)
+        {
+            // Nothing to reserve or pad, the append carries just the buffered bytes.
+            return m_bufferOffset;
+        }
+
+        const auto [_, bytesToWrite] = BlobHelpers::RoundToEndOfNearestPage(m_bufferOffset);
+        const auto uploadEnd = m_lastPageOffset + bytesToWrite + (m_sizeTrailer ? Configuration::PageBlob::PageSize : 0);
+        if (uploadEnd > m_capacity)
+        {
+            Expand(uploadEnd);
+        }
+
+        return bytesToWrite;
+    }
+
+    void WriteableFileImpl::UploadBuffer(const std::span<char> buffer, const int64_t bytesToWrite, const int64_t blobOffset, const int64_t size)
+    {
+        if (m_appendOnly)
+        {
+            m_blobClient->AppendBlock(buffer.first(static_cast<size_t>(bytesToWrite)), blobOffset);
+            return;
+        }
+
+        if (!m_sizeTrailer)
+        {
+            BlobHelpers::UploadPages(*m_blobClient, buffer.first(static_cast<size_t>(bytesToWrite)), blobOffset, m_uploadConcurrency);
+            return;
+        }
+
+        assert(BlobHelpers::RoundToEndOfNearestPage(size).second == blobOffset + bytesToWrite);
+
+        // Readers take the last written page as the trailer. Every Put Page therefore ends with a trailer for
+        // the bytes written up to it, and the chunks go one after another, so a failure or crash at any point
+        // leaves a trailer that only counts uploaded data.
+        static const constexpr auto pageSize = Configuration::PageBlob::PageSize;
+        static const constexpr auto maxChunkData = Configuration::PageBlob::MaxUploadSize - pageSize;
+        int64_t offset = 0;
+        do
+        {
+            const auto end = std::min(bytesToWrite, offset + maxChunkData);
+            const auto trailer = buffer.subspan(static_cast<size_t>(end), static_cast<size_t>(pageSize));
+
+            // Inside the data the trailer borrows the first page of the next chunk, which is put back afterwards.
+            std::array<char, pageSize> next{};
+            std::copy(trailer.begin(), trailer.end(), next.begin());
+            BlobHelpers::WriteSizeTrailer(trailer, end == bytesToWrite ? size : blobOffset + end);
+            try
+            {
+                m_blobClient->UploadPages(buffer.subspan(static_cast<size_t>(offset), static_cast<size_t>(end - offset + pageSize)), blobOffset + offset);
+            }
+            catch (...)
+            {
+                std::copy(next.begin(), next.end(), trailer.begin());
+                throw;
+            }
+
+            std::copy(next.begin(), next.end(), trailer.begin());
+            offset = end;
+        } while (offset < bytesToWrite);
     }
 
     void WriteableFileImpl::Sync()
+    {
+        if (m_durability == DurabilityMode::Close)
+        {
+            std::scoped_lock lock(m_sync->State);
+            ThrowIfUploadFailed();
+            return;
+        }
+
+        SyncToBlob();
+    }
+
+    void WriteableFileImpl::SyncToBlob()
+    {
+        uint64_t ticket;
+        {
+            std::scoped_lock lock(m_sync->State);
+            ticket = ++m_sync->SyncRequests;
+        }
+
+        // Syncs arriving while another one uploads queue here. The next one through uploads everything
+        // appended so far, which also covers every sync that was waiting with it.
+        std::scoped_lock syncLock(m_sync->Syncs);
+        if (m_sync->SyncsCompleted >= ticket)
+        {
+            return;
+        }
+
+        SyncGroup();
+    }
+
+    void WriteableFileImpl::SyncGroup()
     {
         if (m_fileCache)
         {
             m_fileCache->MarkFileAsStaleIfExists(m_name);
         }
 
-        Flush();
-        m_blobClient->SetSize(m_size);
-        BOOST_LOG_SEV(*m_logger, debug) << "Synced writeable file '" << m_name << "' to " << m_size << " bytes";
+        std::unique_lock lock(m_sync->State);
+        ThrowIfUploadFailed();
+        const auto covered = m_sync->SyncRequests;
+        const auto size = m_size;
+        if (m_bufferCount > 1)
+        {
+            // Background uploads are tracked under the state lock, so it's held for the whole sync.
+            FlushBuffer();
+            WaitForUploads();
+        }
+        else if (!m_flushed && m_bufferOffset > 0)
+        {
+            // Upload a copy of the buffered pages so appends can carry on while the upload is in flight.
+            const auto blobOffset = m_lastPageOffset;
+            const auto bufferOffset = m_bufferOffset;
+            const auto bytesToWrite = ReserveFlush();
+            auto& pages = m_sync->Pages;
+            pages.resize(m_buffer.size());
+            std::copy(m_buffer.begin(), m_buffer.begin() + bytesToWrite, pages.begin());
+
+            std::unique_lock uploadLock(m_sync->Uploads);
+            lock.unlock();
+            UploadBuffer(pages, bytesToWrite, blobOffset, size);
+            uploadLock.unlock();
+            lock.lock();
+
+            // A full buffer may have been flushed by an append in the meantime, which already moved past these pages.
+            if (m_lastPageOffset == blobOffset)
+            {
+                const auto fullPages = m_appendOnly ? bufferOffset : (bufferOffset / Configuration::PageBlob::PageSize) * Configuration::PageBlob::PageSize;
+                std::copy(m_buffer.begin() + fullPages, m_buffer.begin() + m_bufferOffset, m_buffer.begin());
+                m_bufferOffset -= fullPages;
+                m_lastPageOffset += fullPages;
+                m_flushed = m_size == size;
+            }
+        }
+
+        lock.unlock();
+        if (!m_sizeTrailer && !m_appendOnly)
+        {
+            m_blobClient->SetSize(size);
+        }
+
+        m_sync->SyncsCompleted = covered;
+        if (m_sizeListener)
+        {
+            m_sizeListener(size);
+        }
+
+        BOOST_LOG_SEV(*m_logger, debug) << "Synced writeable file '" << m_name << "' to " << size << " bytes";
     }
 
     void WriteableFileImpl::Truncate(int64_t size)
     {
+        std::scoped_lock syncLock(m_sync->Syncs);
+
         // Truncate only allows shrinking, not expanding
-        if (size > m_size)
+        const auto currentSize = GetFileSize();
+        if (size > currentSize)
         {
             throw std::invalid_argument("Truncate can only shrink the file. Cannot expand from " +
-                std::to_string(m_size) + " to " + std::to_string(size) + " bytes.");
+                std::to_string(currentSize) + " to " + std::to_string(size) + " bytes.");
+        }
+
+        if (m_appendOnly)
+        {
+            // Appended data can't be taken back, only truncating to the current size is possible.
+            if (size != currentSize)
+            {
+                throw std::invalid_argument("Append only blobs can't be truncated. Cannot shrink from " +
+                    std::to_string(currentSize) + " to " + std::to_string(size) + " bytes.");
+            }
+
+            SyncGroup();
+            return;
         }
 
         // Ensure all data is written to blob before modifications are made
-        Sync();
+        SyncGroup();
+
+        std::scoped_lock lock(m_sync->State);
 
         const auto [partialPageSize, totalPageOffset] = BlobHelpers::RoundToBeginningOfNearestPage(size);
         m_bufferOffset = 0;
@@ -224,15 +565,48 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
 
         m_size = size;
         m_blobClient->SetSize(m_size);
+        m_sizeTrailer = false; // The metadata now holds the size and no longer points readers at a trailer.
 
         // Calculate new capacity rounded up to page size
         const auto [_, newCapacity] = BlobHelpers::RoundToEndOfNearestPage(size);
         m_capacity = newCapacity;
         m_blobClient->SetCapacity(newCapacity);
+        if (m_sizeListener)
+        {
+            m_sizeListener(size);
+        }
+    }
+
+    void WriteableFileImpl::Reserve(const int64_t capacity)
+    {
+        std::scoped_lock lock(m_sync->State);
+        if (capacity <= m_capacity)
+        {
+            return;
+        }
+
+        const auto [_, desiredSize] = BlobHelpers::RoundToEndOfNearestPage(capacity);
+        BOOST_LOG_SEV(*m_logger, debug) << "Reserving " << desiredSize << " bytes for writeable file '" << m_name << "'";
+
+        m_blobClient->SetCapacity(desiredSize);
+        m_capacity = desiredSize;
+    }
+
+    void WriteableFileImpl::SetPreallocationBlockSize(const int64_t blockSize)
+    {
+        std::scoped_lock lock(m_sync->State);
+        m_preallocationBlockSize = BlobHelpers::RoundToEndOfNearestPage(std::max<int64_t>(blockSize, 0)).second;
+    }
+
+    void WriteableFileImpl::SetSizeListener(std::function<void(int64_t)> listener)
+    {
+        std::scoped_lock syncLock(m_sync->Syncs);
+        m_sizeListener = std::move(listener);
     }
 
     int64_t WriteableFileImpl::GetFileSize() const noexcept
     {
+        std::scoped_lock lock(m_sync->State);
         return m_size;
     }
 
@@ -243,15 +617,121 @@ namespace AVEVA::RocksDB::Plugin::Azure::Impl
         return length;
     }
 
-    void WriteableFileImpl::Expand()
+    void WriteableFileImpl::Expand(const int64_t requiredCapacity)
     {
-        // TODO: Consider expanding by less for large files.
-        const auto [_, rounded] = BlobHelpers::RoundToEndOfNearestPage(m_capacity * 2);
-        const auto desiredSize = rounded;
+        int64_t desiredSize;
+        if (m_preallocationBlockSize > 0)
+        {
+            // Grow to the end of the block the flush lands in, the same steps RocksDB reserves in.
+            desiredSize = ((requiredCapacity + m_preallocationBlockSize - 1) / m_preallocationBlockSize) * m_preallocationBlockSize;
+        }
+        else
+        {
+            // TODO: Consider expanding by less for large files.
+            // Doubling once isn't enough when a large buffer is flushed into a small blob.
+            desiredSize = std::max(m_capacity, Configuration::PageBlob::PageSize);
+            while (desiredSize < requiredCapacity)
+            {
+                desiredSize *= 2;
+            }
+        }
+
+        desiredSize = BlobHelpers::RoundToEndOfNearestPage(desiredSize).second;
 
         BOOST_LOG_SEV(*m_logger, debug) << "Expanding writeable file '" << m_name << "' to " << desiredSize << " bytes";
 
         m_blobClient->SetCapacity(desiredSize);
         m_capacity = desiredSize;
     }
+
+    void WriteableFileImpl::UploadFullPagesAsync()
+    {
+        const auto [remaining, bytesToWrite] = BlobHelpers::RoundToBeginningOfNearestPage(m_bufferOffset);
+        if (bytesToWrite == 0)
+        {
+            // Less than a page is buffered, which only happens with buffers that aren't a multiple of the page size.
+            FlushBuffer();
+            return;
+        }
+
+        if ((m_lastPageOffset + bytesToWrite) > m_capacity)
+        {
+            Expand(m_lastPageOffset + bytesToWrite);
+        }
+
+        auto next = AcquireBuffer();
+        std::copy(m_buffer.data() + bytesToWrite, m_buffer.data() + m_bufferOffset, next.begin());
+
+        PendingUpload upload{ std::exchange(m_buffer, std::move(next)), {} };
+        const auto pages = std::span(upload.Buffer.data(), static_cast<size_t>(bytesToWrite));
+        const auto blobOffset = m_lastPageOffset;
+        upload.Result = std::async(std::launch::async, [blobClient = m_blobClient, pages, blobOffset, concurrency = m_uploadConcurrency]()
+            {
+                BlobHelpers::UploadPages(*blobClient, pages, blobOffset, concurrency);
+            });
+        m_pendingUploads.push_back(std::move(upload));
+
+        BOOST_LOG_SEV(*m_logger, debug) << "Queued upload of " << bytesToWrite << " bytes for writeable file '" << m_name << "'.";
+        m_bufferOffset = remaining;
+        m_lastPageOffset += bytesToWrite;
+        m_flushed = remaining == 0;
+    }
+
+    std::vector<char> WriteableFileImpl::AcquireBuffer()
+    {
+        // One buffer is always being filled, the rest can be uploading.
+        while (static_cast<int64_t>(m_pendingUploads.size()) >= m_bufferCount - 1)
+        {
+            WaitForOldestUpload();
+            ThrowIfUploadFailed();
+        }
+
+        if (m_freeBuffers.empty())
+        {
+            return std::vector<char>(static_cast<size_t>(m_bufferSize));
+        }
+
+        auto buffer = std::move(m_freeBuffers.back());
+        m_freeBuffers.pop_back();
+        return buffer;
+    }
+
+    void WriteableFileImpl::WaitForOldestUpload()
+    {
+        auto upload = std::move(m_pendingUploads.front());
+        m_pendingUploads.erase(m_pendingUploads.begin());
+        try
+        {
+            upload.Result.get();
+        }
+        catch (...)
+        {
+            // Remember the first failure. Later pages can't be trusted once an earlier one is missing.
+            BOOST_LOG_SEV(*m_logger, error) << "Background upload failed for writeable file '" << m_name << "'.";
+            if (!m_uploadError)
+            {
+                m_uploadError = std::current_exception();
+            }
+        }
+
+        m_freeBuffers.push_back(std::move(upload.Buffer));
+    }
+
+    void WriteableFileImpl::WaitForUploads()
+    {
+        while (!m_pendingUploads.empty())
+        {
+            WaitForOldestUpload();
+        }
+
+        ThrowIfUploadFailed();
+    }
+
+    void WriteableFileImpl::ThrowIfUploadFailed() const
+    {
+        if (m_uploadError)
+        {
+            std::rethrow_exception(m_uploadError);
+        }
+    }
 }
@@ -36,6 +36,10 @@ namespace AVEVA::RocksDB::Plugin::Azure
         {
             return AzureErrorTranslator::IOStatusFromError(e.Message, e.StatusCode);
         }
+        catch (const std::system_error& e)
+        {
+            return AzureErrorTranslator::IOStatusFromError(e);
+        }
         catch (const std::exception& e)
         {
             return rocksdb::IOStatus::IOError(e.what());
@@ -70,6 +74,10 @@ namespace AVEVA::RocksDB::Plugin::Azure
         {
             return AzureErrorTranslator::IOStatusFromError(e.Message, e.StatusCode);
         }
+        catch (const std::system_error& e)
+        {
+            return AzureErrorTranslator::IOStatusFromError(e);
+        }
         catch (const std::exception& e)
         {
             return rocksdb::IOStatus::IOError(e.what());
@@ -93,6 +101,10 @@ namespace AVEVA::RocksDB::Plugin::Azure
         {
             return AzureErrorTranslator::IOStatusFromError(e.Message, e.StatusCode);
         }
+        catch (const std::system_error& e)
+        {
+            return AzureErrorTranslator::IOStatusFromError(e);
+        }
         catch (const std::exception& e)
         {
             return rocksdb::IOStatus::IOError(e.what());
@@ -140,4 +140,36 @@ namespace AVEVA::RocksDB::Plugin::Azure
             return 0;
         }
     }
+
+    rocksdb::IOStatus WriteableFile::Allocate(uint64_t offset, uint64_t len, const rocksdb::IOOptions&, rocksdb::IODebugContext*)
+    {
+        // The default PrepareWrite calls this once per preallocation block, so the blob is resized
+        // ahead of the appends instead of when a flush runs out of room.
+        try
+        {
+            m_file.Reserve(static_cast<int64_t>(offset + len));
+        }
+        catch (const ::Azure::Core::RequestFailedException& ex)
+        {
+            BOOST_LOG_SEV(*m_logger, error) << "[" << ex.ErrorCode << "]" << " (Status Code: " << static_cast<int>(ex.StatusCode) << ") " << ex.Message;
+            return AzureErrorTranslator::IOStatusFromError(ex.Message, ex.StatusCode);
+        }
+        catch (const std::exception& ex)
+        {
+            BOOST_LOG_SEV(*m_logger, error) << ex.what();
+            return rocksdb::IOStatus::IOError(ex.what());
+        }
+        catch (...)
+        {
+            return rocksdb::IOStatus::IOError("Unknown error when allocating file");
+        }
+
+        return rocksdb::IOStatus::OK();
+    }
+
+    void WriteableFile::SetPreallocationBlockSize(size_t size)
+    {
+        rocksdb::FSWritableFile::SetPreallocationBlockSize(size);
+        m_file.SetPreallocationBlockSize(static_cast<int64_t>(size));
+    }
 }
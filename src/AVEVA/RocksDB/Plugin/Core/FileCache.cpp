@@ -4,6 +4,9 @@
 #include "AVEVA/RocksDB/Plugin/Core/FileCache.hpp"
 #include "AVEVA/RocksDB/Plugin/Core/RocksDBHelpers.hpp"
 #include <boost/log/trivial.hpp>
+
+#include <algorithm>
+#include <chrono>
 using namespace boost::log::trivial;
 namespace AVEVA::RocksDB::Plugin::Core
 {
@@ -11,13 +14,23 @@ namespace AVEVA::RocksDB::Plugin::Core
         int64_t maxCacheSize,
         std::shared_ptr<ContainerClient> containerClient,
         std::shared_ptr<Filesystem> filesystem,
-        std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger)
+        std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger,
+        std::shared_ptr<SharedFileCacheIndex> sharedIndex,
+        std::string keyPrefix)
         : m_cachePath(std::move(cachePath)),
         m_maxSize(maxCacheSize),
         m_containerClient(std::move(containerClient)),
         m_filesystem(std::move(filesystem)),
-        m_logger(std::move(logger))
+        m_logger(std::move(logger)),
+        m_sharedIndex(std::move(sharedIndex)),
+        m_keyPrefix(std::move(keyPrefix))
     {
+        if (m_sharedIndex && !m_keyPrefix.empty())
+        {
+            // Every database gets its own folder in a shared cache so identically named files don't collide.
+            m_filesystem->CreateDir(m_sharedIndex->DataPath() / m_keyPrefix);
+        }
+
         // Start the background thread after all members are initialized
         m_backgroundDownloader = std::jthread(&FileCache::BackgroundDownload, this, m_stopSource.get_token());
     }
@@ -66,21 +79,46 @@ namespace AVEVA::RocksDB::Plugin::Core
                 // This is because when the file is downloaded, it will get the most current state from
                 // azure.
                 it->second.SetState(FileCacheEntry::State::Stale);
+                m_metrics.Record(FileCacheMetrics::Ticker::Invalidations);
             }
         }
+
+        // Other processes sharing the cache may hold a copy of the old contents.
+        if (m_sharedIndex && RocksDBHelpers::IsImmutableFile(RocksDBHelpers::GetFileType(filePath)))
+        {
+            m_sharedIndex->Invalidate(SharedKey(filePath));
+        }
     }
 
     std::optional<int64_t> FileCache::ReadFile(const std::string_view filePath, int64_t offset, int64_t bytesToRead, char* buffer)
     {
         // If there are extensions that should be filtered on then we need to process that first.
         const auto fileType = RocksDBHelpers::GetFileType(filePath);
-        if (fileType != RocksDBHelpers::FileClass::SST)
+        if (!RocksDBHelpers::IsImmutableFile(fileType))
         {
             return std::nullopt;
         }
 
         std::unique_lock lock(m_mutex);
         auto it = m_cache.find(filePath);
+        if (it == m_cache.end() && m_sharedIndex)
+        {
+            // Another process may have already downloaded the file.
+            if (const auto cached = m_sharedIndex->Find(SharedKey(filePath)))
+            {
+                BOOST_LOG_SEV(*m_logger, debug) << "Found file '" << filePath << "' in shared cache";
+
+                auto [inserted, _] = m_cache.emplace(
+                    std::piecewise_construct,
+                    std::forward_as_tuple(std::string(filePath)),
+                    std::forward_as_tuple(filePath, cached->Size));
+                inserted->second.SetGeneration(cached->Generation);
+                inserted->second.SetState(FileCacheEntry::State::Active);
+                m_entryList.push_front(inserted->second);
+                it = inserted;
+            }
+        }
+
         if (it == m_cache.end())
         {
             // File not found, create a new entry
@@ -94,6 +132,7 @@ namespace AVEVA::RocksDB::Plugin::Core
 
             BOOST_LOG_SEV(*m_logger, debug) << "Queueing for download: '" << filePath << "'";
             m_fileDownloadQueue.emplace(filePath);
+            RecordMiss(bytesToRead, true);
 
             lock.unlock();
             m_cv.notify_one();
@@ -113,26 +152,45 @@ namespace AVEVA::RocksDB::Plugin::Core
 
                     // Mark as downloading now so we don't queue it again.
                     fileEntry.SetState(FileCacheEntry::State::QueuedForDownload);
+                    RecordMiss(bytesToRead, true);
 
                     lock.unlock();
                     m_cv.notify_one();
                 }
+                else
+                {
+                    RecordMiss(bytesToRead, false);
+                }
 
                 return std::nullopt;
             }
 
             EntryAccessedUnsafe(fileEntry);
+            if (!m_sharedIndex)
+            {
+                return ReadCachedFile(filePath, offset, bytesToRead, buffer);
+            }
 
-            auto cachedFilePath = m_cachePath / fileEntry.GetFilePath();
-            auto file = m_filesystem->Open(cachedFilePath);
-            if (buffer != nullptr)
+            // Hold a reference for the duration of the read so no other process evicts the file from under us.
+            const auto sharedKey = SharedKey(filePath);
+            if (!m_sharedIndex->Pin(sharedKey, fileEntry.GetGeneration()))
             {
-                const auto bytesRead = file->Read(buffer, offset, bytesToRead);
+                BOOST_LOG_SEV(*m_logger, debug) << "File '" << filePath << "' is no longer in the shared cache";
+                ForgetFileUnsafe(filePath);
+                RecordMiss(bytesToRead, false);
+                return std::nullopt;
+            }
+
+            try
+            {
+                const auto bytesRead = ReadCachedFile(filePath, offset, bytesToRead, buffer);
+                m_sharedIndex->Unpin(sharedKey);
                 return bytesRead;
             }
-            else
+            catch (...)
             {
-                return 0;
+                m_sharedIndex->Unpin(sharedKey);
+                throw;
             }
         }
     }
@@ -145,6 +203,11 @@ namespace AVEVA::RocksDB::Plugin::Core
 
     int64_t FileCache::CacheSize()
     {
+        if (m_sharedIndex)
+        {
+            return m_sharedIndex->UsedBytes();
+        }
+
         std::scoped_lock lock(m_mutex);
         const auto size = GetCurrentSizeUnsafe();
 #if _DEBUG
@@ -168,6 +231,13 @@ namespace AVEVA::RocksDB::Plugin::Core
         }
 
         std::scoped_lock lock(m_mutex);
+        if (m_sharedIndex)
+        {
+            m_sharedIndex->SetMaxSize(size);
+            m_maxSize = size;
+            return;
+        }
+
         const auto currentSize = GetCurrentSizeUnsafe();
         if (currentSize > size)
         {
@@ -179,6 +249,58 @@ namespace AVEVA::RocksDB::Plugin::Core
         m_maxSize = size;
     }
 
+    FileCacheMetrics::Snapshot FileCache::GetMetrics()
+    {
+        auto snapshot = m_metrics.GetSnapshot();
+        snapshot.UsedBytes = CacheSize();
+
+        std::scoped_lock lock(m_mutex);
+        snapshot.MaxBytes = m_maxSize;
+        return snapshot;
+    }
+
+    FileCacheMetrics::Snapshot FileCache::CombineMetrics(const std::span<FileCache* const> caches)
+    {
+        FileCacheMetrics::Snapshot combined;
+        std::vector<const SharedFileCacheIndex*> counted;
+        for (auto* cache : caches)
+        {
+            auto snapshot = cache->GetMetrics();
+            if (const auto* index = cache->m_sharedIndex.get())
+            {
+                if (std::find(counted.begin(), counted.end(), index) != counted.end())
+                {
+                    snapshot.UsedBytes = 0;
+                    snapshot.MaxBytes = 0;
+                }
+                else
+                {
+                    counted.push_back(index);
+                }
+            }
+
+            combined += snapshot;
+        }
+
+        return combined;
+    }
+
+    std::vector<FileCache::EntryInfo> FileCache::GetEntries()
+    {
+        std::scoped_lock lock(m_mutex);
+        std::vector<EntryInfo> entries;
+        for (const auto& entry : m_entryList)
+        {
+            entries.emplace_back(entry.GetFilePath(),
+                entry.GetState(),
+                entry.GetSize(),
+                entry.GetAccessCount(),
+                entry.GetLastAccessTime());
+        }
+
+        return entries;
+    }
+
     void FileCache::BackgroundDownload(std::stop_token stopToken)
     {
         while (true)
@@ -211,6 +333,7 @@ namespace AVEVA::RocksDB::Plugin::Core
 
                     filePath = m_fileDownloadQueue.front();
                     m_fileDownloadQueue.pop();
+                    m_metrics.AdjustQueueDepth(-1);
 
                     auto it = m_cache.find(filePath);
                     if (it != m_cache.end())
@@ -241,6 +364,7 @@ namespace AVEVA::RocksDB::Plugin::Core
                 catch (std::exception& e)
                 {
                     BOOST_LOG_SEV(*m_logger, error) << "Failed to get file size for '" << filePath << "'. Error: " << e.what();
+                    m_metrics.Record(FileCacheMetrics::Ticker::DownloadsFailed);
                     continue;
                 }
 
@@ -259,8 +383,14 @@ namespace AVEVA::RocksDB::Plugin::Core
                         continue;
                     }
 
-                    const auto currentSize = GetCurrentSizeUnsafe();
-                    if (currentSize + fileSize > m_maxSize)
+                    if (m_sharedIndex)
+                    {
+                        if (!ClaimSharedDownloadUnsafe(it->second))
+                        {
+                            continue;
+                        }
+                    }
+                    else if (const auto currentSize = GetCurrentSizeUnsafe(); currentSize + fileSize > m_maxSize)
                     {
                         if (fileSize <= m_maxSize)
                         {
@@ -278,6 +408,7 @@ namespace AVEVA::RocksDB::Plugin::Core
                             {
                                 BOOST_LOG_SEV(*m_logger, error) << "Couldn't evict enough space to fit new file '" << filePath << "'";
                                 RemoveFileUnsafe(filePath);
+                                m_metrics.Record(FileCacheMetrics::Ticker::DownloadsSkipped);
                                 continue;
                             }
                         }
@@ -291,6 +422,7 @@ namespace AVEVA::RocksDB::Plugin::Core
                                 << m_maxSize;
 
                             RemoveFileUnsafe(filePath);
+                            m_metrics.Record(FileCacheMetrics::Ticker::DownloadsSkipped);
                             continue;
                         }
                     }
@@ -299,10 +431,11 @@ namespace AVEVA::RocksDB::Plugin::Core
                     it->second.SetState(FileCacheEntry::State::Downloading);
                 }
 
+                const auto downloadStart = std::chrono::steady_clock::now();
                 try
                 {
                     auto blobClient = m_containerClient->GetBlobClient(filePath);
-                    const auto actualFilePath = m_cachePath / filePath;
+                    const auto actualFilePath = CachedFilePath(filePath);
 
                     // No need to download the _whole_ blob. There could be lots of padding
                     // at the end of the file. We can just download the actual size.
@@ -314,16 +447,37 @@ namespace AVEVA::RocksDB::Plugin::Core
                     // this operation could _also_ throw. Let the next read be a cache miss which
                     // will queue up the download again.
                     BOOST_LOG_SEV(*m_logger, error) << "Failed to download file '" << filePath << "'. Removing entry from cache. Error: " << e.what();
+                    m_metrics.Record(FileCacheMetrics::Ticker::DownloadsFailed);
 
                     std::scoped_lock lock(m_mutex);
-                    RemoveFileUnsafe(filePath);
+                    if (m_sharedIndex)
+                    {
+                        m_sharedIndex->AbortDownload(SharedKey(filePath));
+                        ForgetFileUnsafe(filePath);
+                    }
+                    else
+                    {
+                        RemoveFileUnsafe(filePath);
+                    }
+
                     continue;
                 }
 
                 BOOST_LOG_SEV(*m_logger, debug) << "Finished downloading file '" << filePath << "'";
+                m_metrics.Record(FileCacheMetrics::Ticker::DownloadsCompleted);
+                m_metrics.Record(FileCacheMetrics::Ticker::BytesDownloaded, static_cast<uint64_t>(fileSize));
+                m_metrics.Record(FileCacheMetrics::Histogram::DownloadMicros, ElapsedMicros(downloadStart));
 
                 // Mark the file as active in the cache.
                 std::unique_lock lock(m_mutex);
+                std::optional<uint64_t> generation;
+                if (m_sharedIndex)
+                {
+                    // Publish the file to the other processes. If it was invalidated or deleted while we
+                    // were downloading it, the index has already thrown the download away.
+                    generation = m_sharedIndex->CompleteDownload(SharedKey(filePath));
+                }
+
                 auto it = m_cache.find(filePath);
                 if (it != m_cache.end())
                 {
@@ -335,15 +489,34 @@ namespace AVEVA::RocksDB::Plugin::Core
                         continue;
                     }
 
+                    if (m_sharedIndex)
+                    {
+                        if (!generation)
+                        {
+                            BOOST_LOG_SEV(*m_logger, debug) << "File '" << filePath << "' was invalidated in the shared cache while we were downloading it. Will not mark as active.";
+                            it->second.SetState(FileCacheEntry::State::Stale);
+                            continue;
+                        }
+
+                        it->second.SetGeneration(*generation);
+                    }
+
                     BOOST_LOG_SEV(*m_logger, debug) << "Marking file '" << filePath << "' as active";
                     it->second.SetState(FileCacheEntry::State::Active);
                 }
+                else if (m_sharedIndex)
+                {
+                    if (generation)
+                    {
+                        m_sharedIndex->Invalidate(SharedKey(filePath));
+                    }
+                }
                 else
                 {
                     // The file was likely deleted. We should clean up after ourselves.
                     BOOST_LOG_SEV(*m_logger, debug) << "File '" << filePath << "' was deleted. Removing file from cache";
                     std::error_code ec;
-                    auto cachedFilePath = m_cachePath / filePath;
+                    auto cachedFilePath = CachedFilePath(filePath);
                     m_filesystem->DeleteFile(cachedFilePath);
                 }
             }
@@ -391,6 +564,14 @@ namespace AVEVA::RocksDB::Plugin::Core
             const auto fileSize = tail->GetSize();
 
             BOOST_LOG_SEV(*m_logger, debug) << "Evicting '" << filePath << "' of size " << fileSize << "'bytes' from file cache";
+            m_metrics.Record(FileCacheMetrics::Ticker::Evictions);
+            m_metrics.Record(FileCacheMetrics::Ticker::BytesEvicted, static_cast<uint64_t>(fileSize));
+            if (tail->GetAccessCount() == 0)
+            {
+                // The file was downloaded and thrown away without ever being read. A high rate means the cache is thrashing.
+                m_metrics.Record(FileCacheMetrics::Ticker::EvictionsUnused);
+            }
+
             tail = --tail;
             bytesEvicted += fileSize;
 
@@ -402,6 +583,18 @@ namespace AVEVA::RocksDB::Plugin::Core
 
     void FileCache::RemoveFileUnsafe(const std::string_view filePath)
     {
+        if (m_sharedIndex)
+        {
+            // The shared index owns the file on disk and deletes it once nobody is reading it.
+            ForgetFileUnsafe(filePath);
+            if (RocksDBHelpers::IsImmutableFile(RocksDBHelpers::GetFileType(filePath)))
+            {
+                m_sharedIndex->Invalidate(SharedKey(filePath));
+            }
+
+            return;
+        }
+
         auto it = m_cache.find(filePath);
         if (it != m_cache.end())
         {
@@ -417,6 +610,100 @@ namespace AVEVA::RocksDB::Plugin::Core
         }
     }
 
+    void FileCache::ForgetFileUnsafe(const std::string_view filePath)
+    {
+        auto it = m_cache.find(filePath);
+        if (it != m_cache.end())
+        {
+            it->second.unlink();
+            m_cache.erase(it);
+        }
+    }
+
+    bool FileCache::ClaimSharedDownloadUnsafe(FileCacheEntry& file)
+    {
+        const auto& filePath = file.GetFilePath();
+        SharedFileCacheIndex::CachedFile existing{};
+        switch (m_sharedIndex->BeginDownload(SharedKey(filePath), file.GetSize(), existing))
+        {
+        case SharedFileCacheIndex::DownloadClaim::Claimed:
+            return true;
+        case SharedFileCacheIndex::DownloadClaim::Cached:
+            BOOST_LOG_SEV(*m_logger, debug) << "File '" << filePath << "' was downloaded by another process. Marking as active";
+            file.SetSize(existing.Size);
+            file.SetGeneration(existing.Generation);
+            file.SetState(FileCacheEntry::State::Active);
+            return false;
+        case SharedFileCacheIndex::DownloadClaim::Busy:
+            BOOST_LOG_SEV(*m_logger, debug) << "File '" << filePath << "' is busy in the shared cache. Skipping download.";
+            break;
+        case SharedFileCacheIndex::DownloadClaim::NoSpace:
+            BOOST_LOG_SEV(*m_logger, debug) << "Couldn't make room for file '" << filePath << "' in the shared cache. Skipping download.";
+            break;
+        }
+
+        // Let the next read try again.
+        ForgetFileUnsafe(filePath);
+        m_metrics.Record(FileCacheMetrics::Ticker::DownloadsSkipped);
+        return false;
+    }
+
+    int64_t FileCache::ReadCachedFile(const std::string_view filePath, int64_t offset, int64_t bytesToRead, char* buffer)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto file = m_filesystem->Open(CachedFilePath(filePath));
+        int64_t bytesRead = 0;
+        if (buffer != nullptr)
+        {
+            bytesRead = file->Read(buffer, offset, bytesToRead);
+        }
+
+        m_metrics.Record(FileCacheMetrics::Ticker::Hits);
+        m_metrics.Record(FileCacheMetrics::Ticker::BytesRead, static_cast<uint64_t>(bytesRead));
+        m_metrics.Record(FileCacheMetrics::Histogram::ReadMicros, ElapsedMicros(start));
+        return bytesRead;
+    }
+
+    void FileCache::RecordMiss(const int64_t bytesToRead, const bool queued) noexcept
+    {
+        m_metrics.Record(FileCacheMetrics::Ticker::Misses);
+        m_metrics.Record(FileCacheMetrics::Ticker::BytesMissed, static_cast<uint64_t>(std::max<int64_t>(bytesToRead, 0)));
+        if (queued)
+        {
+            m_metrics.Record(FileCacheMetrics::Ticker::DownloadsQueued);
+            m_metrics.AdjustQueueDepth(1);
+        }
+    }
+
+    uint64_t FileCache::ElapsedMicros(const std::chrono::steady_clock::time_point start) noexcept
+    {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        return static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 0));
+    }
+
+    std::string FileCache::SharedKey(const std::string_view filePath) const
+    {
+        if (m_keyPrefix.empty())
+        {
+            return std::string(filePath);
+        }
+
+        std::string key;
+        key.reserve(m_keyPrefix.size() + 1 + filePath.size());
+        key.append(m_keyPrefix).append("/").append(filePath);
+        return key;
+    }
+
+    std::filesystem::path FileCache::CachedFilePath(const std::string_view filePath) const
+    {
+        if (m_sharedIndex)
+        {
+            return m_sharedIndex->DataPath() / SharedKey(filePath);
+        }
+
+        return m_cachePath / filePath;
+    }
+
     int64_t FileCache::GetCurrentSizeUnsafe() const noexcept
     {
         int64_t size = 0;
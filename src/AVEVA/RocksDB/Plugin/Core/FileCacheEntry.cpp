@@ -9,12 +9,15 @@ namespace AVEVA::RocksDB::Plugin::Core
     // the file has finished downloading and we can safely return nothing without
     // queuing up another download.
     FileCacheEntry::FileCacheEntry(const std::string_view filePath, const int64_t size)
-        : m_state(State::QueuedForDownload), m_filePath(std::move(filePath)), m_size(size)
+        : m_state(State::QueuedForDownload), m_filePath(std::move(filePath)), m_size(size), m_generation(0), m_accessCount(0),
+        m_lastAccessTime(std::chrono::system_clock::now())
     {
     }
 
     void FileCacheEntry::Accessed()
     {
+        ++m_accessCount;
+        m_lastAccessTime = std::chrono::system_clock::now();
     }
 
     int64_t FileCacheEntry::GetSize() const noexcept
@@ -32,6 +35,21 @@ namespace AVEVA::RocksDB::Plugin::Core
         return m_state;
     }
 
+    uint64_t FileCacheEntry::GetGeneration() const noexcept
+    {
+        return m_generation;
+    }
+
+    uint64_t FileCacheEntry::GetAccessCount() const noexcept
+    {
+        return m_accessCount;
+    }
+
+    std::chrono::time_point<std::chrono::system_clock> FileCacheEntry::GetLastAccessTime() const noexcept
+    {
+        return m_lastAccessTime;
+    }
+
     void FileCacheEntry::SetSize(int64_t size) noexcept
     {
         m_size = size;
@@ -42,6 +60,11 @@ namespace AVEVA::RocksDB::Plugin::Core
         m_state = state;
     }
 
+    void FileCacheEntry::SetGeneration(uint64_t generation) noexcept
+    {
+        m_generation = generation;
+    }
+
     void FileCacheEntry::unlink()
     {
         boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>>::unlink();
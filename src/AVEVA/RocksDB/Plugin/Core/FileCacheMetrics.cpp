@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Core/FileCacheMetrics.hpp"
+
+#include <algorithm>
+#include <bit>
+namespace AVEVA::RocksDB::Plugin::Core
+{
+    static constexpr std::array<std::string_view, FileCacheMetrics::TickerCount> TickerNames =
+    {
+        "file.cache.hit",
+        "file.cache.miss",
+        "file.cache.bytes.read",
+        "file.cache.bytes.missed",
+        "file.cache.download.queued",
+        "file.cache.download.completed",
+        "file.cache.download.failed",
+        "file.cache.download.skipped",
+        "file.cache.bytes.downloaded",
+        "file.cache.eviction",
+        "file.cache.eviction.unused",
+        "file.cache.bytes.evicted",
+        "file.cache.invalidation",
+    };
+
+    static constexpr std::array<std::string_view, FileCacheMetrics::HistogramCount> HistogramNames =
+    {
+        "file.cache.download.micros",
+        "file.cache.read.micros",
+    };
+
+    void LatencyHistogram::Record(const uint64_t value) noexcept
+    {
+        const auto bucket = std::min<size_t>(std::bit_width(value), BucketCount - 1);
+        m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+
+        auto max = m_max.load(std::memory_order_relaxed);
+        while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    LatencyHistogram::Snapshot LatencyHistogram::GetSnapshot() const noexcept
+    {
+        Snapshot snapshot;
+        for (size_t i = 0; i < BucketCount; ++i)
+        {
+            snapshot.Buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+        }
+
+        snapshot.Count = m_count.load(std::memory_order_relaxed);
+        snapshot.Sum = m_sum.load(std::memory_order_relaxed);
+        snapshot.Max = m_max.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    double LatencyHistogram::Snapshot::Average() const noexcept
+    {
+        return Count == 0 ? 0.0 : static_cast<double>(Sum) / static_cast<double>(Count);
+    }
+
+    double LatencyHistogram::Snapshot::Percentile(const double percentile) const noexcept
+    {
+        uint64_t total = 0;
+        for (const auto bucket : Buckets)
+        {
+            total += bucket;
+        }
+
+        if (total == 0)
+        {
+            return 0.0;
+        }
+
+        // The counters are read independently, so the buckets are the source of truth here.
+        const auto rank = std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(total);
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < BucketCount; ++i)
+        {
+            if (Buckets[i] == 0)
+            {
+                continue;
+            }
+
+            const auto previous = cumulative;
+            cumulative += Buckets[i];
+            if (static_cast<double>(cumulative) < rank)
+            {
+                continue;
+            }
+
+            if (i == 0)
+            {
+                return 0.0;
+            }
+
+            // Interpolate linearly inside the bucket, never past the largest value recorded.
+            const auto low = static_cast<double>(uint64_t{ 1 } << (i - 1));
+            const auto high = std::max(low, std::min(static_cast<double>(uint64_t{ 1 } << i), static_cast<double>(Max)));
+            const auto position = (rank - static_cast<double>(previous)) / static_cast<double>(Buckets[i]);
+            return low + (high - low) * position;
+        }
+
+        return static_cast<double>(Max);
+    }
+
+    LatencyHistogram::Snapshot& LatencyHistogram::Snapshot::operator+=(const Snapshot& other) noexcept
+    {
+        Count += other.Count;
+        Sum += other.Sum;
+        Max = std::max(Max, other.Max);
+        for (size_t i = 0; i < BucketCount; ++i)
+        {
+            Buckets[i] += other.Buckets[i];
+        }
+
+        return *this;
+    }
+
+    uint64_t FileCacheMetrics::Snapshot::Get(const Ticker ticker) const noexcept
+    {
+        return Tickers[static_cast<size_t>(ticker)];
+    }
+
+    const LatencyHistogram::Snapshot& FileCacheMetrics::Snapshot::Get(const Histogram histogram) const noexcept
+    {
+        return Histograms[static_cast<size_t>(histogram)];
+    }
+
+    FileCacheMetrics::Snapshot& FileCacheMetrics::Snapshot::operator+=(const Snapshot& other) noexcept
+    {
+        for (size_t i = 0; i < TickerCount; ++i)
+        {
+            Tickers[i] += other.Tickers[i];
+        }
+
+        for (size_t i = 0; i < HistogramCount; ++i)
+        {
+            Histograms[i] += other.Histograms[i];
+        }
+
+        QueueDepth += other.QueueDepth;
+        UsedBytes += other.UsedBytes;
+        MaxBytes += other.MaxBytes;
+        return *this;
+    }
+
+    void FileCacheMetrics::Record(const Ticker ticker, const uint64_t count) noexcept
+    {
+        m_tickers[static_cast<size_t>(ticker)].fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void FileCacheMetrics::Record(const Histogram histogram, const uint64_t value) noexcept
+    {
+        m_histograms[static_cast<size_t>(histogram)].Record(value);
+    }
+
+    void FileCacheMetrics::AdjustQueueDepth(const int64_t delta) noexcept
+    {
+        m_queueDepth.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    FileCacheMetrics::Snapshot FileCacheMetrics::GetSnapshot() const noexcept
+    {
+        Snapshot snapshot;
+        for (size_t i = 0; i < TickerCount; ++i)
+        {
+            snapshot.Tickers[i] = m_tickers[i].load(std::memory_order_relaxed);
+        }
+
+        for (size_t i = 0; i < HistogramCount; ++i)
+        {
+            snapshot.Histograms[i] = m_histograms[i].GetSnapshot();
+        }
+
+        snapshot.QueueDepth = m_queueDepth.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    std::string_view FileCacheMetrics::Name(const Ticker ticker) noexcept
+    {
+        return TickerNames[static_cast<size_t>(ticker)];
+    }
+
+    std::string_view FileCacheMetrics::Name(const Histogram histogram) noexcept
+    {
+        return HistogramNames[static_cast<size_t>(histogram)];
+    }
+}
@@ -2,28 +2,31 @@
 // SPDX-FileCopyrightText: Copyright 2025 AVEVA
 
 #include "AVEVA/RocksDB/Plugin/Core/RocksDBHelpers.hpp"
+
+#include <algorithm>
+#include <cctype>
 namespace AVEVA::RocksDB::Plugin::Core
 {
+    static std::string_view FileName(const std::string_view pathname)
+    {
+        // extract last component of the path
+        const auto offset = pathname.find_last_of('/');
+        return offset != std::string_view::npos ? pathname.substr(offset + 1) : pathname;
+    }
+
     static bool IsFile(const std::string_view pathname, const std::string_view file)
     {
-        static const constexpr std::string_view pathsep{ "/" };
+        return FileName(pathname).starts_with(file);
+    }
 
-        // extract last component of the path
-        std::string fname;
-        size_t offset = pathname.find_last_of(pathsep);
-        if (offset != std::string::npos)
-        {
-            fname = pathname.substr(offset + 1, pathname.size());
-        }
-        else
-        {
-            fname = pathname;
-        }
-        if (fname.find(file) == 0)
-        {
-            return true;
-        }
-        return false;
+    static bool IsNumber(const std::string_view text)
+    {
+        return !text.empty() && std::all_of(text.begin(), text.end(), [](const char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; });
+    }
+
+    static bool IsNumbered(const std::string_view name, const std::string_view prefix)
+    {
+        return name.starts_with(prefix) && IsNumber(name.substr(prefix.size()));
     }
 
     bool RocksDBHelpers::IsManifestFile(const std::string_view pathname)
@@ -36,6 +39,35 @@ namespace AVEVA::RocksDB::Plugin::Core
         return IsFile(pathname, "IDENTITY");
     }
 
+    bool RocksDBHelpers::IsCurrentFile(const std::string_view pathname)
+    {
+        return IsFile(pathname, "CURRENT");
+    }
+
+    bool RocksDBHelpers::IsOptionsFile(const std::string_view pathname)
+    {
+        return IsFile(pathname, "OPTIONS-");
+    }
+
+    bool RocksDBHelpers::IsSmallFile(const std::string_view pathname)
+    {
+        return IsSmallFile(GetFileType(pathname));
+    }
+
+    bool RocksDBHelpers::IsSmallFile(const FileClass fileType)
+    {
+        switch (fileType)
+        {
+        case FileClass::Current:
+        case FileClass::Options:
+        case FileClass::Identity:
+        case FileClass::Temp:
+            return true;
+        default:
+            return false;
+        }
+    }
+
     bool RocksDBHelpers::IsLogFile(const RocksDBHelpers::FileClass fileType)
     {
         // A log file has ".log" suffix or starts with 'MANIFEST"
@@ -49,30 +81,68 @@ namespace AVEVA::RocksDB::Plugin::Core
         }
     }
 
+    bool RocksDBHelpers::IsImmutableFile(const FileClass fileType)
+    {
+        return fileType == FileClass::SST || fileType == FileClass::Blob;
+    }
+
     RocksDBHelpers::FileClass RocksDBHelpers::GetFileType(const std::string_view pathname)
     {
-        // Is this a sst file, i.e. ends in ".sst" or ".ldb"
-        if (pathname.ends_with(FileType::sst) || pathname.ends_with(FileType::ldb))
+        // Follows ParseFileName in RocksDB's file/filename.cc, except that numbered files are recognized by their
+        // suffix alone, whatever comes before it.
+        const auto name = FileName(pathname);
+        if (name.ends_with(FileType::sst) || name.ends_with(FileType::ldb))
         {
             return FileClass::SST;
         }
 
-        // A log file has ".log" suffix
-        if (pathname.ends_with(FileType::log))
+        if (name.ends_with(FileType::log))
         {
             return FileClass::WAL;
         }
 
-        if (IsManifestFile(pathname))
+        if (name.ends_with(FileType::blob))
         {
-            return FileClass::Manifest;
+            return FileClass::Blob;
         }
 
-        if (IsIdentityFile(pathname))
+        if (name.ends_with(FileType::dbtmp))
+        {
+            // Includes OPTIONS-<number>.dbtmp, written before being renamed to the options file.
+            return FileClass::Temp;
+        }
+
+        if (name == "IDENTITY")
         {
             return FileClass::Identity;
         }
 
+        if (name == "CURRENT")
+        {
+            return FileClass::Current;
+        }
+
+        if (name == "LOCK")
+        {
+            return FileClass::Lock;
+        }
+
+        if (IsNumbered(name, "MANIFEST-"))
+        {
+            return FileClass::Manifest;
+        }
+
+        if (IsNumbered(name, "OPTIONS-"))
+        {
+            return FileClass::Options;
+        }
+
+        // The info log may carry a prefix naming the database when it is kept in a separate log directory.
+        if (name.ends_with("LOG") || name.find("LOG.old.") != std::string_view::npos)
+        {
+            return FileClass::InfoLog;
+        }
+
         return FileClass::Directory;
     }
 }
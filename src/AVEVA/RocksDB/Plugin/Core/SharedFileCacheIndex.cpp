@@ -0,0 +1,668 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Core/SharedFileCacheIndex.hpp"
+
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/log/trivial.hpp>
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+using namespace boost::log::trivial;
+namespace AVEVA::RocksDB::Plugin::Core
+{
+    static const constexpr uint64_t g_indexMagic = 0x31584449434F5641; // "AVOCIDX1"
+    static const constexpr uint32_t g_indexVersion = 2;
+    static const constexpr std::string_view g_indexFileName = ".shared-cache.index";
+    static const constexpr std::string_view g_lockFileName = ".shared-cache.lock";
+    static const constexpr std::string_view g_processFilePrefix = ".shared-cache.process.";
+    static const constexpr std::string_view g_dataDirectoryName = ".shared-cache.files";
+
+    // Keep the table sparse enough that linear probing stays short.
+    static const constexpr uint32_t g_maxLoad = SharedFileCacheIndex::MaxEntries / 8 * 7;
+
+    enum class EntryState : uint32_t
+    {
+        Free = 0,
+        Downloading = 1,
+        Active = 2,
+        Stale = 3,
+    };
+
+    struct SharedFileCacheIndex::Header
+    {
+        uint64_t Magic;
+        uint32_t Version;
+        uint32_t EntryCapacity;
+        int64_t MaxSize;
+        int64_t UsedBytes;
+        uint64_t Clock;
+        uint64_t LastGeneration;
+        uint32_t Count;
+        uint32_t Reserved;
+    };
+
+    struct SharedFileCacheIndex::Entry
+    {
+        uint64_t Hash;
+        int64_t Size;
+        uint64_t LastAccess;
+        uint64_t Generation;
+        uint64_t Readers;
+        EntryState State;
+        uint32_t Owner;
+        char Key[MaxKeyLength + 1];
+    };
+
+    static const constexpr size_t g_indexFileSize = 4096 + SharedFileCacheIndex::MaxEntries * 320;
+
+    // A process only ever holds one slot per cache directory through Open, but the
+    // constructor can still be used directly. Tracking the slots held in this process
+    // avoids probing our own lock files, which on POSIX would silently release them.
+    static std::mutex g_processSlotsMutex;
+    static std::set<std::pair<std::filesystem::path, uint32_t>> g_processSlots;
+
+    static uint64_t HashKey(std::string_view key) noexcept
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (const auto c : key)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+
+        // Zero marks an empty slot.
+        return hash == 0 ? 1 : hash;
+    }
+
+    static void EnsureFileExists(const std::filesystem::path& path)
+    {
+        std::ofstream file(path, std::ios::app | std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("Could not create shared cache file '" + path.string() + "'");
+        }
+    }
+
+    SharedFileCacheIndex::SharedFileCacheIndex(std::filesystem::path cachePath,
+        int64_t maxCacheSize,
+        std::shared_ptr<Filesystem> filesystem,
+        std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger)
+        : m_cachePath(std::move(cachePath)),
+        m_dataPath(m_cachePath / g_dataDirectoryName),
+        m_filesystem(std::move(filesystem)),
+        m_logger(std::move(logger)),
+        m_processSlot(MaxProcesses)
+    {
+        static_assert(sizeof(Header) <= 4096);
+        static_assert(sizeof(Entry) <= 320);
+        static_assert(std::is_trivially_copyable_v<Header> && std::is_trivially_copyable_v<Entry>);
+
+        std::filesystem::create_directories(m_dataPath);
+        const auto lockPath = m_cachePath / g_lockFileName;
+        EnsureFileExists(lockPath);
+        m_indexLock = boost::interprocess::file_lock(lockPath.string().c_str());
+
+        boost::interprocess::scoped_lock guard(m_indexLock);
+        const auto indexPath = m_cachePath / g_indexFileName;
+        EnsureFileExists(indexPath);
+        const auto needsInitialize = std::filesystem::file_size(indexPath) != g_indexFileSize;
+        if (needsInitialize)
+        {
+            std::filesystem::resize_file(indexPath, g_indexFileSize);
+        }
+
+        m_mapping = boost::interprocess::file_mapping(indexPath.string().c_str(), boost::interprocess::read_write);
+        m_region = boost::interprocess::mapped_region(m_mapping, boost::interprocess::read_write);
+
+        auto& header = GetHeader();
+        if (needsInitialize ||
+            header.Magic != g_indexMagic ||
+            header.Version != g_indexVersion ||
+            header.EntryCapacity != MaxEntries)
+        {
+            InitializeUnsafe(maxCacheSize);
+        }
+        else if (header.MaxSize != maxCacheSize)
+        {
+            BOOST_LOG_SEV(*m_logger, warning) << "Shared cache '" << m_cachePath.string()
+                << "' already has a budget of " << header.MaxSize
+                << " (bytes). Ignoring requested budget of " << maxCacheSize << " (bytes)";
+        }
+
+        m_processSlot = ClaimProcessSlot();
+
+        // Whoever held this slot before us is gone, so anything it left behind is garbage.
+        ReapProcessUnsafe(m_processSlot);
+        BOOST_LOG_SEV(*m_logger, debug) << "Attached to shared cache '" << m_cachePath.string() << "' as process slot " << m_processSlot;
+    }
+
+    SharedFileCacheIndex::~SharedFileCacheIndex()
+    {
+        try
+        {
+            std::scoped_lock lock(m_mutex);
+            boost::interprocess::scoped_lock guard(m_indexLock);
+            ReapProcessUnsafe(m_processSlot);
+        }
+        catch (const std::exception& e)
+        {
+            BOOST_LOG_SEV(*m_logger, error) << "Failed to detach from shared cache '" << m_cachePath.string() << "'. Error: " << e.what();
+        }
+
+        std::scoped_lock slotsLock(g_processSlotsMutex);
+        g_processSlots.erase({ m_cachePath, m_processSlot });
+    }
+
+    std::shared_ptr<SharedFileCacheIndex> SharedFileCacheIndex::Open(const std::filesystem::path& cachePath,
+        int64_t maxCacheSize,
+        std::shared_ptr<Filesystem> filesystem,
+        std::shared_ptr<boost::log::sources::severity_logger_mt<boost::log::trivial::severity_level>> logger)
+    {
+        static std::mutex s_mutex;
+        static std::map<std::filesystem::path, std::weak_ptr<SharedFileCacheIndex>> s_indexes;
+
+        const auto key = std::filesystem::weakly_canonical(cachePath);
+        std::scoped_lock lock(s_mutex);
+        auto it = s_indexes.find(key);
+        if (it != s_indexes.end())
+        {
+            if (auto index = it->second.lock())
+            {
+                return index;
+            }
+        }
+
+        auto index = std::make_shared<SharedFileCacheIndex>(key, maxCacheSize, std::move(filesystem), std::move(logger));
+        s_indexes[key] = index;
+        return index;
+    }
+
+    std::optional<SharedFileCacheIndex::CachedFile> SharedFileCacheIndex::Find(std::string_view key)
+    {
+        std::scoped_lock lock(m_mutex);
+        boost::interprocess::scoped_lock guard(m_indexLock);
+        const auto* entry = FindUnsafe(key, HashKey(key));
+        if (entry == nullptr || entry->State != EntryState::Active)
+        {
+            return std::nullopt;
+        }
+
+        return CachedFile{ entry->Size, entry->Generation };
+    }
+
+    bool SharedFileCacheIndex::Pin(std::string_view key, uint64_t generation)
+    {
+        std::scoped_lock lock(m_mutex);
+        boost::interprocess::scoped_lock guard(m_indexLock);
+        auto* entry = FindUnsafe(key, HashKey(key));
+        if (entry == nullptr || entry->State != EntryState::Active || entry->Generation != generation)
+        {
+            return false;
+        }
+
+        entry->Readers |= (1ull << m_processSlot);
+        entry->LastAccess = ++GetHeader().Clock;
+
+        auto pin = m_pins.find(key);
+        if (pin == m_pins.end())
+        {
+            m_pins.emplace(std::string(key), 1);
+        }
+        else
+        {
+            pin->second++;
+        }
+
+        return true;
+    }
+
+    void SharedFileCacheIndex::Unpin(std::string_view key)
+    {
+        std::scoped_lock lock(m_mutex);
+        auto pin = m_pins.find(key);
+        if (pin == m_pins.end() || --pin->second > 0)
+        {
+            return;
+        }
+
+        m_pins.erase(pin);
+
+        boost::interprocess::scoped_lock guard(m_indexLock);
+        auto* entry = FindUnsafe(key, HashKey(key));
+        if (entry != nullptr)
+        {
+            entry->Readers &= ~(1ull << m_processSlot);
+            if (entry->State == EntryState::Stale && entry->Readers == 0)
+            {
+                BOOST_LOG_SEV(*m_logger, debug) << "Last reader released invalidated file '" << key << "'. Removing it from shared cache.";
+                EraseUnsafe(*entry);
+            }
+        }
+    }
+
+    SharedFileCacheIndex::DownloadClaim SharedFileCacheIndex::BeginDownload(std::string_view key, int64_t size, CachedFile& existing)
+    {
+        std::scoped_lock lock(m_mutex);
+        boost::interprocess::scoped_lock guard(m_indexLock);
+        auto& header = GetHeader();
+        if (key.size() > MaxKeyLength || size > header.MaxSize)
+        {
+            return DownloadClaim::NoSpace;
+        }
+
+        const auto hash = HashKey(key);
+        auto* entry = FindUnsafe(key, hash);
+        if (entry != nullptr && entry->State == EntryState::Downloading && entry->Owner != m_processSlot && !IsProcessAlive(entry->Owner))
+        {
+            ReapProcessUnsafe(entry->Owner);
+            entry = FindUnsafe(key, hash);
+        }
+
+        if (entry != nullptr)
+        {
+            if (entry->State == EntryState::Active)
+            {
+                entry->LastAccess = ++header.Clock;
+                existing = CachedFile{ entry->Size, entry->Generation };
+                return DownloadClaim::Cached;
+            }
+
+            return DownloadClaim::Busy;
+        }
+
+        if (header.UsedBytes + size > header.MaxSize)
+        {
+            BOOST_LOG_SEV(*m_logger, debug) << "Shared cache is full at "
+                << header.UsedBytes << " (bytes). Max "
+                << header.MaxSize
+                << " (bytes). Evicting files to make room for '"
+                << key
+                << "' of size "
+                << size
+                << " (bytes)";
+            if (!EvictAtLeastUnsafe(header.UsedBytes + size - header.MaxSize))
+            {
+                return DownloadClaim::NoSpace;
+            }
+        }
+
+        if (header.Count >= g_maxLoad && !EvictAtLeastUnsafe(1))
+        {
+            return DownloadClaim::NoSpace;
+        }
+
+        entry = InsertUnsafe(key, hash);
+        entry->Size = size;
+        entry->State = EntryState::Downloading;
+        entry->Owner = m_processSlot;
+        entry->Readers = 0;
+        entry->Generation = 0;
+        entry->LastAccess = ++header.Clock;
+        header.UsedBytes += size;
+        return DownloadClaim::Claimed;
+    }
+
+    std::optional<uint64_t> SharedFileCacheIndex::CompleteDownload(std::string_view key)
+    {
+        std::scoped_lock lock(m_mutex);
+        boost::interprocess::scoped_lock guard(m_indexLock);
+        auto* entry = FindUnsafe(key, HashKey(key));
+        if (entry == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        if (entry->State != EntryState::Downloading || entry->Owner != m_processSlot)
+        {
+            if (entry->State == EntryState::Stale && entry->Readers == 0)
+            {
+                EraseUnsafe(*entry);
+            }
+
+            return std::nullopt;
+        }
+
+        auto& header = GetHeader();
+        entry->State = EntryState::Active;
+        entry->Generation = ++header.LastGeneration;
+        entry->LastAccess = ++header.Clock;
+        return entry->Generation;
+    }
+
+    void SharedFileCacheIndex::AbortDownload(std::string_view key)
+    {
+        std::scoped_lock lock(m_mutex);
+        boost::interprocess::scoped_lock guard(m_indexLock);
+        auto* entry = FindUnsafe(key, HashKey(key));
+        if (entry != nullptr && entry->Owner == m_processSlot && entry->Readers == 0 &&
+            (entry->State == EntryState::Downloading || entry->State == EntryState::Stale))
+        {
+            EraseUnsafe(*entry);
+        }
+    }
+
+    void SharedFileCacheIndex::Invalidate(std::string_view key)
+    {
+        std::scoped_lock lock(m_mutex);
+        boost::interprocess::scoped_lock guard(m_indexLock);
+        auto* entry = FindUnsafe(key, HashKey(key));
+        if (entry == nullptr)
+        {
+            return;
+        }
+
+        if (entry->State == EntryState::Active && entry->Readers == 0)
+        {
+            BOOST_LOG_SEV(*m_logger, debug) << "Removing file '" << key << "' from shared cache.";
+            EraseUnsafe(*entry);
+        }
+        else
+        {
+            // Somebody is still reading or downloading the file. Whoever lets go of it last cleans up.
+            BOOST_LOG_SEV(*m_logger, debug) << "Marking file '" << key << "' in shared cache as stale";
+            entry->State = EntryState::Stale;
+        }
+    }
+
+    int64_t SharedFileCacheIndex::UsedBytes()
+    {
+        std::scoped_lock lock(m_mutex);
+        boost::interprocess::scoped_lock guard(m_indexLock);
+        return GetHeader().UsedBytes;
+    }
+
+    int64_t SharedFileCacheIndex::MaxSize()
+    {
+        std::scoped_lock lock(m_mutex);
+        boost::interprocess::scoped_lock guard(m_indexLock);
+        return GetHeader().MaxSize;
+    }
+
+    void SharedFileCacheIndex::SetMaxSize(int64_t size)
+    {
+        if (size < 0)
+        {
+            throw std::invalid_argument("Cache size cannot be negative");
+        }
+
+        std::scoped_lock lock(m_mutex);
+        boost::interprocess::scoped_lock guard(m_indexLock);
+        auto& header = GetHeader();
+        header.MaxSize = size;
+        if (header.UsedBytes > size)
+        {
+            EvictAtLeastUnsafe(header.UsedBytes - size);
+        }
+    }
+
+    uint32_t SharedFileCacheIndex::ProcessSlot() const noexcept
+    {
+        return m_processSlot;
+    }
+
+    SharedFileCacheIndex::Header& SharedFileCacheIndex::GetHeader() noexcept
+    {
+        return *static_cast<Header*>(m_region.get_address());
+    }
+
+    SharedFileCacheIndex::Entry* SharedFileCacheIndex::Entries() noexcept
+    {
+        return reinterpret_cast<Entry*>(static_cast<char*>(m_region.get_address()) + 4096);
+    }
+
+    SharedFileCacheIndex::Entry* SharedFileCacheIndex::FindUnsafe(std::string_view key, uint64_t hash) noexcept
+    {
+        if (key.size() > MaxKeyLength)
+        {
+            return nullptr;
+        }
+
+        auto* entries = Entries();
+        for (uint32_t probe = 0; probe < MaxEntries; probe++)
+        {
+            auto& entry = entries[(hash + probe) % MaxEntries];
+            if (entry.State == EntryState::Free)
+            {
+                return nullptr;
+            }
+
+            if (entry.Hash == hash && key == std::string_view(entry.Key))
+            {
+                return &entry;
+            }
+        }
+
+        return nullptr;
+    }
+
+    SharedFileCacheIndex::Entry* SharedFileCacheIndex::InsertUnsafe(std::string_view key, uint64_t hash) noexcept
+    {
+        auto* entries = Entries();
+        for (uint32_t probe = 0; probe < MaxEntries; probe++)
+        {
+            auto& entry = entries[(hash + probe) % MaxEntries];
+            if (entry.State == EntryState::Free)
+            {
+                std::memset(&entry, 0, sizeof(Entry));
+                entry.Hash = hash;
+                std::memcpy(entry.Key, key.data(), key.size());
+                GetHeader().Count++;
+                return &entry;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void SharedFileCacheIndex::EraseUnsafe(Entry& entry)
+    {
+        auto& header = GetHeader();
+        m_filesystem->DeleteFile(m_dataPath / std::string_view(entry.Key));
+        header.UsedBytes -= entry.Size;
+        header.Count--;
+
+        // Backward shift deletion keeps probe sequences intact without tombstones.
+        auto* entries = Entries();
+        auto hole = static_cast<uint32_t>(&entry - entries);
+        auto next = hole;
+        while (true)
+        {
+            next = (next + 1) % MaxEntries;
+            auto& candidate = entries[next];
+            if (candidate.State == EntryState::Free)
+            {
+                break;
+            }
+
+            const auto home = static_cast<uint32_t>(candidate.Hash % MaxEntries);
+            const auto canMove = hole <= next
+                ? (home <= hole || home > next)
+                : (home <= hole && home > next);
+            if (canMove)
+            {
+                entries[hole] = candidate;
+                hole = next;
+            }
+        }
+
+        std::memset(&entries[hole], 0, sizeof(Entry));
+    }
+
+    bool SharedFileCacheIndex::EvictAtLeastUnsafe(const int64_t bytes)
+    {
+        ReapDeadProcessesUnsafe();
+
+        auto& header = GetHeader();
+        if (bytes > header.MaxSize)
+        {
+            return false;
+        }
+
+        int64_t bytesEvicted = 0;
+        auto* entries = Entries();
+        while (bytesEvicted < bytes)
+        {
+            Entry* victim = nullptr;
+            for (uint32_t i = 0; i < MaxEntries; i++)
+            {
+                auto& entry = entries[i];
+                if ((entry.State == EntryState::Active || entry.State == EntryState::Stale) &&
+                    entry.Readers == 0 &&
+                    (victim == nullptr || entry.LastAccess < victim->LastAccess))
+                {
+                    victim = &entry;
+                }
+            }
+
+            if (victim == nullptr)
+            {
+                break;
+            }
+
+            BOOST_LOG_SEV(*m_logger, debug) << "Evicting '" << victim->Key << "' of size " << victim->Size << " (bytes) from shared cache";
+            bytesEvicted += victim->Size;
+            EraseUnsafe(*victim);
+        }
+
+        return bytesEvicted >= bytes;
+    }
+
+    bool SharedFileCacheIndex::IsProcessAlive(uint32_t slot)
+    {
+        if (slot == m_processSlot)
+        {
+            return true;
+        }
+
+        {
+            std::scoped_lock slotsLock(g_processSlotsMutex);
+            if (g_processSlots.contains({ m_cachePath, slot }))
+            {
+                return true;
+            }
+        }
+
+        const auto path = ProcessLockPath(slot);
+        if (!std::filesystem::exists(path))
+        {
+            return false;
+        }
+
+        boost::interprocess::file_lock processLock(path.string().c_str());
+        if (processLock.try_lock())
+        {
+            processLock.unlock();
+            return false;
+        }
+
+        return true;
+    }
+
+    void SharedFileCacheIndex::ReapProcessUnsafe(uint32_t slot)
+    {
+        const auto mask = ~(1ull << slot);
+        auto* entries = Entries();
+        uint32_t i = 0;
+        while (i < MaxEntries)
+        {
+            auto& entry = entries[i];
+            entry.Readers &= mask;
+
+            const auto orphaned = entry.State == EntryState::Downloading && entry.Owner == slot;
+            const auto released = entry.State == EntryState::Stale && entry.Readers == 0 &&
+                (entry.Owner == slot || entry.Generation != 0);
+            if (orphaned || released)
+            {
+                // Erasing shifts a later entry into this slot, so look at it again.
+                EraseUnsafe(entry);
+                continue;
+            }
+
+            i++;
+        }
+    }
+
+    void SharedFileCacheIndex::ReapDeadProcessesUnsafe()
+    {
+        uint64_t referenced = 0;
+        auto* entries = Entries();
+        for (uint32_t i = 0; i < MaxEntries; i++)
+        {
+            referenced |= entries[i].Readers;
+            if (entries[i].State == EntryState::Downloading)
+            {
+                referenced |= (1ull << entries[i].Owner);
+            }
+        }
+
+        referenced &= ~(1ull << m_processSlot);
+        while (referenced != 0)
+        {
+            const auto slot = static_cast<uint32_t>(std::countr_zero(referenced));
+            referenced &= referenced - 1;
+            if (!IsProcessAlive(slot))
+            {
+                BOOST_LOG_SEV(*m_logger, warning) << "Process in shared cache slot " << slot << " is gone. Releasing its references.";
+                ReapProcessUnsafe(slot);
+            }
+        }
+    }
+
+    void SharedFileCacheIndex::InitializeUnsafe(int64_t maxCacheSize)
+    {
+        BOOST_LOG_SEV(*m_logger, info) << "Initializing shared cache index in '" << m_cachePath.string() << "'";
+
+        // Anything cached under an index we can't read is unaccounted for. Start over, but only with the
+        // files this index keeps, since the cache path may hold other data, including unshared caches.
+        m_filesystem->DeleteDir(m_dataPath);
+        m_filesystem->CreateDir(m_dataPath);
+
+        std::memset(m_region.get_address(), 0, m_region.get_size());
+        auto& header = GetHeader();
+        header.Magic = g_indexMagic;
+        header.Version = g_indexVersion;
+        header.EntryCapacity = MaxEntries;
+        header.MaxSize = maxCacheSize;
+        m_region.flush();
+    }
+
+    uint32_t SharedFileCacheIndex::ClaimProcessSlot()
+    {
+        std::scoped_lock slotsLock(g_processSlotsMutex);
+        for (uint32_t slot = 0; slot < MaxProcesses; slot++)
+        {
+            if (g_processSlots.contains({ m_cachePath, slot }))
+            {
+                continue;
+            }
+
+            const auto path = ProcessLockPath(slot);
+            EnsureFileExists(path);
+            boost::interprocess::file_lock processLock(path.string().c_str());
+            if (processLock.try_lock())
+            {
+                m_processLock = std::move(processLock);
+                g_processSlots.emplace(m_cachePath, slot);
+                return slot;
+            }
+        }
+
+        throw std::runtime_error("Too many processes are attached to shared cache '" + m_cachePath.string() + "'");
+    }
+
+    const std::filesystem::path& SharedFileCacheIndex::DataPath() const noexcept
+    {
+        return m_dataPath;
+    }
+
+    std::filesystem::path SharedFileCacheIndex::ProcessLockPath(uint32_t slot) const
+    {
+        return m_cachePath / (std::string(g_processFilePrefix) + std::to_string(slot));
+    }
+}
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/BlobAliases.hpp"
+
+#include <gtest/gtest.h>
+
+using AVEVA::RocksDB::Plugin::Azure::Impl::BlobAliases;
+
+TEST(BlobAliasesTests, Resolve_Unknown_OwnName)
+{
+    // Arrange
+    BlobAliases aliases;
+
+    // Act & Assert
+    ASSERT_EQ("db/000010.log", aliases.Resolve("db/000010.log"));
+}
+
+TEST(BlobAliasesTests, Record_RecycledTwice_OnlyNewestNameResolved)
+{
+    // Arrange
+    BlobAliases aliases;
+    aliases.Record("db/000010.log", "db/000007.log");
+
+    // Act
+    aliases.Record("db/000015.log", "db/000007.log");
+
+    // Assert
+    ASSERT_EQ("db/000007.log", aliases.Resolve("db/000015.log"));
+    ASSERT_EQ("db/000010.log", aliases.Resolve("db/000010.log"));
+}
+
+TEST(BlobAliasesTests, Record_OwnName_AliasDropped)
+{
+    // Arrange
+    BlobAliases aliases;
+    aliases.Record("db/000010.log", "db/000007.log");
+
+    // Act
+    aliases.Record("db/000010.log", "db/000010.log");
+
+    // Assert
+    ASSERT_EQ("db/000010.log", aliases.Resolve("db/000010.log"));
+    ASSERT_FALSE(aliases.Forget("db/000010.log"));
+}
+
+TEST(BlobAliasesTests, Forget_Recorded_ReturnsBlob)
+{
+    // Arrange
+    BlobAliases aliases;
+    aliases.Record("db/000010.log", "db/000007.log");
+
+    // Act
+    const auto blobName = aliases.Forget("db/000010.log");
+
+    // Assert
+    ASSERT_EQ("db/000007.log", blobName);
+    ASSERT_EQ("db/000010.log", aliases.Resolve("db/000010.log"));
+}
+
+TEST(BlobAliasesTests, ForgetPrefix_OnlyFilesUnderPrefix)
+{
+    // Arrange
+    BlobAliases aliases;
+    aliases.Record("db/000010.log", "db/000007.log");
+    aliases.Record("other/000010.log", "other/000007.log");
+
+    // Act
+    aliases.ForgetPrefix("db/");
+
+    // Assert
+    ASSERT_EQ("db/000010.log", aliases.Resolve("db/000010.log"));
+    ASSERT_EQ("other/000007.log", aliases.Resolve("other/000010.log"));
+}
+
+TEST(BlobAliasesTests, IsRecycled_BlobHoldsOtherFile_True)
+{
+    // Arrange
+    BlobAliases aliases;
+
+    // Act
+    aliases.Record("db/000012.log", "db/000010.log");
+
+    // Assert
+    ASSERT_TRUE(aliases.IsRecycled("db/000010.log"));
+    ASSERT_FALSE(aliases.IsRecycled("db/000012.log"));
+}
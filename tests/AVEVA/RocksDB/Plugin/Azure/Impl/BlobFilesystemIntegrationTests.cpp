@@ -9,12 +9,16 @@
 #include <azure/storage/blobs.hpp>
 #include <azure/identity.hpp>
 
+#include <algorithm>
 #include <string>
+#include <system_error>
 #include <vector>
 #include <memory>
 
 using AVEVA::RocksDB::Plugin::Azure::Impl::BlobFilesystemImpl;
 using AVEVA::RocksDB::Plugin::Azure::Impl::Configuration;
+using AVEVA::RocksDB::Plugin::Azure::Impl::FilesystemOptions;
+using AVEVA::RocksDB::Plugin::Azure::Impl::NamespaceIndexMode;
 using AVEVA::RocksDB::Plugin::Azure::Impl::Testing::AzureIntegrationTestBase;
 using AVEVA::RocksDB::Plugin::Azure::Impl::Testing::GenerateRandomBlobName;
 
@@ -710,6 +714,71 @@ TEST_F(BlobFilesystemIntegrationTests, ReuseWritableFile_CreatesNewFile)
     EXPECT_EQ(0, m_filesystem->GetFileSize(path));
 }
 
+TEST_F(BlobFilesystemIntegrationTests, ReuseWritableFile_FromOldLog_OldBlobHoldsNewFile)
+{
+    // Arrange
+    const auto directory = m_containerPrefix + "/" + m_blobName;
+    const auto oldPath = directory + "/000010.log";
+    const auto path = directory + "/000012.log";
+    {
+        auto file = m_filesystem->CreateWriteableFile(oldPath);
+        file.Append(std::vector<char>(static_cast<size_t>(Configuration::PageBlob::DefaultSize * 4), 'X'));
+        file.Sync();
+    }
+
+    const auto capacity = m_containerClient->GetPageBlobClient(m_blobName + "/000010.log").GetProperties().Value.BlobSize;
+
+    // Act
+    {
+        auto reusedFile = m_filesystem->ReuseWritableFile(path, oldPath);
+        reusedFile.Append(std::vector<char>(512, 'Y'));
+        reusedFile.Sync();
+    }
+
+    // Assert
+    EXPECT_FALSE(m_filesystem->FileExists(oldPath));
+    EXPECT_TRUE(m_filesystem->FileExists(path));
+    EXPECT_EQ(512, m_filesystem->GetFileSize(path));
+    EXPECT_EQ(capacity, m_containerClient->GetPageBlobClient(m_blobName + "/000010.log").GetProperties().Value.BlobSize);
+    EXPECT_EQ(std::vector<std::string>{ "000012.log" }, m_filesystem->GetChildren(directory));
+
+    auto readable = m_filesystem->CreateReadableFile(path);
+    std::vector<char> buffer(512);
+    EXPECT_EQ(512, readable.SequentialRead(512, buffer.data()));
+    EXPECT_EQ(std::vector<char>(512, 'Y'), buffer);
+}
+
+TEST_F(BlobFilesystemIntegrationTests, ReuseWritableFile_RecycledLog_FoundByNewNameAfterListing)
+{
+    // Arrange
+    const auto directory = m_containerPrefix + "/" + m_blobName;
+    const auto oldPath = directory + "/000010.log";
+    const auto path = directory + "/000012.log";
+    {
+        auto file = m_filesystem->CreateWriteableFile(oldPath);
+        file.Append(std::vector<char>(1024, 'X'));
+        file.Sync();
+    }
+
+    {
+        auto reusedFile = m_filesystem->ReuseWritableFile(path, oldPath);
+        reusedFile.Append(std::vector<char>(512, 'Y'));
+        reusedFile.Sync();
+    }
+
+    BlobFilesystemImpl other(*m_credentials, std::nullopt, Configuration::PageBlob::DefaultSize,
+        Configuration::PageBlob::DefaultBufferSize, m_logger);
+
+    // Act
+    const auto children = other.GetChildren(directory);
+
+    // Assert
+    EXPECT_EQ(std::vector<std::string>{ "000012.log" }, children);
+    EXPECT_EQ(512, other.GetFileSize(path));
+    EXPECT_TRUE(other.DeleteFile(path));
+    EXPECT_TRUE(other.GetChildren(directory).empty());
+}
+
 TEST_F(BlobFilesystemIntegrationTests, CreateLogger_CreatesLogFile)
 {
     // Arrange
@@ -1004,18 +1073,45 @@ TEST_F(BlobFilesystemIntegrationTests, GetFileModificationTime_NonExistentFile_T
     );
 }
 
-TEST_F(BlobFilesystemIntegrationTests, CreateReadableFile_NonExistentFile_ThrowsOrFails)
+TEST_F(BlobFilesystemIntegrationTests, CreateReadableFile_NonExistentFile_FirstReadThrowsNoSuchFile)
 {
     // Arrange
     std::string nonExistentFile = m_containerPrefix + "/nonexistent-read-" + m_blobName;
+    std::vector<char> buffer(100);
 
-    // Act & Assert - Creating readable file from non-existent blob should throw
+    // Act - Without an index opening is local, so the missing blob shows on the first read
+    auto file = m_filesystem->CreateReadableFile(nonExistentFile);
+
+    // Assert
+    try
+    {
+        [[maybe_unused]] const auto bytesRead = file.RandomRead(0, 100, buffer.data());
+        FAIL() << "Reading a non-existent file should throw";
+    }
+    catch (const std::system_error& e)
+    {
+        EXPECT_EQ(std::errc::no_such_file_or_directory, e.code());
+    }
+}
+
+TEST_F(BlobFilesystemIntegrationTests, CreateReadableFile_NonExistentFileInIndexedDirectory_Throws)
+{
+    // Arrange
+    FilesystemOptions options;
+    options.NamespaceIndexing = NamespaceIndexMode::Authoritative;
+    BlobFilesystemImpl filesystem(*m_credentials, std::nullopt, Configuration::PageBlob::DefaultSize,
+        Configuration::PageBlob::DefaultBufferSize, m_logger, std::nullopt, Configuration::MaxCacheSize, options);
+    const auto dirPath = m_containerPrefix + "/" + m_blobName;
+    auto lock = filesystem.LockFile(dirPath + "/LOCK");
+
+    // Act & Assert - The index knows the file is missing, so opening fails
     EXPECT_THROW(
         {
-            auto file = m_filesystem->CreateReadableFile(nonExistentFile);
+            auto file = filesystem.CreateReadableFile(dirPath + "/000001.sst");
         },
-        std::exception
+        ::Azure::Core::RequestFailedException
     );
+    filesystem.UnlockFile(*lock);
 }
 
 TEST_F(BlobFilesystemIntegrationTests, ReopenWriteableFile_NonExistentFile_ThrowsOrFails)
@@ -1300,3 +1396,104 @@ TEST_F(BlobFilesystemIntegrationTests, RandomRead_AfterBlobGrows_UpdatesSize)
     // Cleanup
     EXPECT_TRUE(m_filesystem->DeleteFile(blobName));
 }
+
+TEST_F(BlobFilesystemIntegrationTests, CreateWriteableFile_BlockBlobSst_ReadBackWithCommittedSize)
+{
+    // Arrange
+    FilesystemOptions options;
+    options.BlockBlobSst = true;
+    BlobFilesystemImpl filesystem(*m_credentials, std::nullopt, Configuration::PageBlob::DefaultSize,
+        Configuration::PageBlob::DefaultBufferSize, m_logger, std::nullopt, Configuration::MaxCacheSize, options);
+    const auto path = m_containerPrefix + "/" + m_blobName + "/000010.sst";
+    std::vector<char> data(static_cast<size_t>(Configuration::PageBlob::DefaultBufferSize + 1000));
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<char>(i % 251);
+    }
+
+    // Act
+    {
+        auto file = filesystem.CreateWriteableFile(path);
+        file.Append(std::span(data).first(700));
+        file.Flush();
+        file.Append(std::span(data).subspan(700));
+        file.Close();
+    }
+
+    // Assert
+    EXPECT_EQ(static_cast<int64_t>(data.size()), filesystem.GetFileSize(path));
+    auto readable = filesystem.CreateReadableFile(path);
+    std::vector<char> readBuffer(data.size());
+    EXPECT_EQ(static_cast<int64_t>(data.size()), readable.RandomRead(0, static_cast<int64_t>(readBuffer.size()), readBuffer.data()));
+    EXPECT_EQ(data, readBuffer);
+}
+
+TEST_F(BlobFilesystemIntegrationTests, DeleteFile_AsyncDelete_HiddenAtOnceAndNameReusable)
+{
+    // Arrange
+    FilesystemOptions options;
+    options.AsyncDelete = true;
+    BlobFilesystemImpl filesystem(*m_credentials, std::nullopt, Configuration::PageBlob::DefaultSize,
+        Configuration::PageBlob::DefaultBufferSize, m_logger, std::nullopt, Configuration::MaxCacheSize, options);
+    const auto dirPath = m_containerPrefix + "/" + m_blobName;
+    const auto path = dirPath + "/000011.sst";
+    {
+        auto file = filesystem.CreateWriteableFile(path);
+        file.Append(std::vector<char>(512, 'A'));
+        file.Close();
+    }
+
+    // Act
+    EXPECT_TRUE(filesystem.DeleteFile(path));
+    const auto existsAfterDelete = filesystem.FileExists(path);
+    const auto childrenAfterDelete = filesystem.GetChildren(dirPath);
+    {
+        auto file = filesystem.CreateWriteableFile(path);
+        file.Append(std::vector<char>(1024, 'B'));
+        file.Close();
+    }
+
+    // Assert
+    EXPECT_FALSE(existsAfterDelete);
+    EXPECT_TRUE(childrenAfterDelete.empty());
+    EXPECT_EQ(1024, filesystem.GetFileSize(path));
+    EXPECT_EQ(0, filesystem.DeleteDir(dirPath));
+}
+
+TEST_F(BlobFilesystemIntegrationTests, NamespaceIndex_Authoritative_TracksOwnChanges)
+{
+    // Arrange
+    FilesystemOptions options;
+    options.NamespaceIndexing = NamespaceIndexMode::Authoritative;
+    BlobFilesystemImpl filesystem(*m_credentials, std::nullopt, Configuration::PageBlob::DefaultSize,
+        Configuration::PageBlob::DefaultBufferSize, m_logger, std::nullopt, Configuration::MaxCacheSize, options);
+    const auto dirPath = m_containerPrefix + "/" + m_blobName;
+    const auto existingPath = dirPath + "/000001.sst";
+    {
+        auto file = filesystem.CreateWriteableFile(existingPath);
+        file.Append(std::vector<char>(700, 'A'));
+        file.Close();
+    }
+
+    auto lock = filesystem.LockFile(dirPath + "/LOCK");
+
+    // Act
+    const auto path = dirPath + "/000002.log";
+    auto file = filesystem.CreateWriteableFile(path);
+    file.Append(std::vector<char>(100, 'B'));
+    file.Sync();
+    const auto syncedSize = filesystem.GetFileSize(path);
+    file.Close();
+    filesystem.RenameFile(existingPath, dirPath + "/000003.sst");
+    EXPECT_TRUE(filesystem.DeleteFile(path));
+
+    // Assert
+    EXPECT_EQ(100, syncedSize);
+    EXPECT_FALSE(filesystem.FileExists(path));
+    EXPECT_FALSE(filesystem.FileExists(existingPath));
+    EXPECT_EQ(700, filesystem.GetFileSize(dirPath + "/000003.sst"));
+    auto children = filesystem.GetChildren(dirPath);
+    std::sort(children.begin(), children.end());
+    EXPECT_EQ((std::vector<std::string>{ "000003.sst", "LOCK" }), children);
+    filesystem.UnlockFile(*lock);
+}
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/BlobPool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using AVEVA::RocksDB::Plugin::Azure::Impl::BlobPool;
+
+TEST(BlobPoolTests, PredictNames_SstFile_FollowingNumbersWithSameWidth)
+{
+    // Act
+    const auto names = BlobPool::PredictNames("db/000123.sst", 3);
+
+    // Assert
+    ASSERT_EQ((std::vector<std::string>{ "db/000124.sst", "db/000125.sst", "db/000126.sst" }), names);
+}
+
+TEST(BlobPoolTests, PredictNames_NumberOutgrowsWidth_Widened)
+{
+    // Act
+    const auto names = BlobPool::PredictNames("000099.log", 2);
+
+    // Assert
+    ASSERT_EQ((std::vector<std::string>{ "000100.log", "000101.log" }), names);
+
+    // Act
+    const auto widened = BlobPool::PredictNames("db/999999.log", 1);
+
+    // Assert
+    ASSERT_EQ((std::vector<std::string>{ "db/1000000.log" }), widened);
+}
+
+TEST(BlobPoolTests, PredictNames_NotAFileNumber_NoNames)
+{
+    // Act & Assert
+    ASSERT_TRUE(BlobPool::PredictNames("db/MANIFEST-000005", 2).empty());
+    ASSERT_TRUE(BlobPool::PredictNames("db/LOG", 2).empty());
+    ASSERT_TRUE(BlobPool::PredictNames("db/000005.dir/CURRENT", 2).empty());
+    ASSERT_TRUE(BlobPool::PredictNames("db/.sst", 2).empty());
+}
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/BlobFilesystemImpl.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+using AVEVA::RocksDB::Plugin::Azure::Impl::BlobFilesystemImpl;
+using AVEVA::RocksDB::Plugin::Azure::Impl::BlobKind;
+using AVEVA::RocksDB::Plugin::Azure::Impl::Configuration;
+using AVEVA::RocksDB::Plugin::Azure::Impl::FileProfileOverride;
+using AVEVA::RocksDB::Plugin::Azure::Impl::FilesystemOptions;
+using FileClass = AVEVA::RocksDB::Plugin::Core::RocksDBHelpers::FileClass;
+
+static FilesystemOptions WithBlobKind(const FileClass fileType, const BlobKind blobType)
+{
+    FilesystemOptions options;
+    options.FileProfiles[fileType] = FileProfileOverride{ .BlobType = blobType };
+    return options;
+}
+
+static void Resolve(const FilesystemOptions& options)
+{
+    (void)BlobFilesystemImpl::ResolveProfiles(Configuration::PageBlob::DefaultSize, Configuration::PageBlob::DefaultBufferSize, options);
+}
+
+TEST(FileProfileTests, ResolveProfiles_OverridesApplied)
+{
+    // Arrange
+    auto options = WithBlobKind(FileClass::SST, BlobKind::Block);
+    options.FileProfiles[FileClass::WAL] = FileProfileOverride{ .BufferSize = Configuration::PageBlob::PageSize * 4 };
+
+    // Act
+    const auto profiles = BlobFilesystemImpl::ResolveProfiles(Configuration::PageBlob::DefaultSize, Configuration::PageBlob::DefaultBufferSize, options);
+
+    // Assert
+    ASSERT_EQ(BlobKind::Block, profiles.at(FileClass::SST).BlobType);
+    ASSERT_EQ(Configuration::PageBlob::PageSize * 4, profiles.at(FileClass::WAL).BufferSize);
+    ASSERT_EQ(BlobKind::Page, profiles.at(FileClass::WAL).BlobType);
+}
+
+TEST(FileProfileTests, ResolveProfiles_UnsupportedBlobKind_Throws)
+{
+    // Act & Assert
+    ASSERT_THROW(Resolve(WithBlobKind(FileClass::WAL, BlobKind::OneShot)), std::invalid_argument);
+    ASSERT_THROW(Resolve(WithBlobKind(FileClass::Manifest, BlobKind::OneShot)), std::invalid_argument);
+    ASSERT_THROW(Resolve(WithBlobKind(FileClass::SST, BlobKind::OneShot)), std::invalid_argument);
+    ASSERT_THROW(Resolve(WithBlobKind(FileClass::WAL, BlobKind::Block)), std::invalid_argument);
+    ASSERT_THROW(Resolve(WithBlobKind(FileClass::Manifest, BlobKind::Block)), std::invalid_argument);
+    ASSERT_THROW(Resolve(WithBlobKind(FileClass::Temp, BlobKind::Block)), std::invalid_argument);
+    ASSERT_THROW(Resolve(WithBlobKind(FileClass::InfoLog, BlobKind::Block)), std::invalid_argument);
+    ASSERT_NO_THROW(Resolve(WithBlobKind(FileClass::Current, BlobKind::OneShot)));
+    ASSERT_NO_THROW(Resolve(WithBlobKind(FileClass::WAL, BlobKind::Append)));
+}
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/LogRing.hpp"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using AVEVA::RocksDB::Plugin::Azure::Impl::LogRing;
+
+TEST(LogRingTests, TryPop_AfterPushes_RecordsInOrder)
+{
+    // Arrange
+    LogRing ring(4);
+    std::string first = "first";
+    std::string second = "second";
+    ASSERT_TRUE(ring.TryPush(first));
+    ASSERT_TRUE(ring.TryPush(second));
+
+    // Act
+    std::string popped[2];
+    ASSERT_TRUE(ring.TryPop(popped[0]));
+    ASSERT_TRUE(ring.TryPop(popped[1]));
+
+    // Assert
+    ASSERT_EQ("first", popped[0]);
+    ASSERT_EQ("second", popped[1]);
+    std::string empty;
+    ASSERT_FALSE(ring.TryPop(empty));
+}
+
+TEST(LogRingTests, TryPush_Full_RecordKept)
+{
+    // Arrange
+    LogRing ring(2);
+    for (int i = 0; i < 2; ++i)
+    {
+        std::string record = "record";
+        ASSERT_TRUE(ring.TryPush(record));
+    }
+
+    // Act
+    std::string record = "overflow";
+    const auto pushed = ring.TryPush(record);
+
+    // Assert
+    ASSERT_FALSE(pushed);
+    ASSERT_EQ("overflow", record);
+}
+
+TEST(LogRingTests, TryPush_ConcurrentProducers_EveryRecordPoppedOnce)
+{
+    // Arrange
+    static constexpr int producers = 4;
+    static constexpr int recordsPerProducer = 1000;
+    LogRing ring(64);
+    std::vector<std::jthread> threads;
+
+    // Act
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&ring, p]()
+            {
+                for (int i = 0; i < recordsPerProducer; ++i)
+                {
+                    auto record = std::to_string(p) + ":" + std::to_string(i);
+                    while (!ring.TryPush(record))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+
+    std::set<std::string> popped;
+    std::string record;
+    while (popped.size() < static_cast<size_t>(producers * recordsPerProducer))
+    {
+        if (ring.TryPop(record))
+        {
+            ASSERT_TRUE(popped.insert(record).second);
+        }
+    }
+
+    // Assert
+    ASSERT_FALSE(ring.TryPop(record));
+}
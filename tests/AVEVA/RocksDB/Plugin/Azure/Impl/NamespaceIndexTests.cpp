@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/NamespaceIndex.hpp"
+
+#include <gtest/gtest.h>
+
+using AVEVA::RocksDB::Plugin::Azure::Impl::NamespaceIndex;
+
+TEST(NamespaceIndexTests, Covers_PathsInsideDirectory_True)
+{
+    // Arrange
+    NamespaceIndex index("db");
+
+    // Act & Assert
+    ASSERT_TRUE(index.Covers("db"));
+    ASSERT_TRUE(index.Covers("db/000001.log"));
+    ASSERT_FALSE(index.Covers("db2/000001.log"));
+    ASSERT_FALSE(index.Covers("other"));
+    ASSERT_EQ("db/", index.ListingPrefix());
+}
+
+TEST(NamespaceIndexTests, Update_RemovedFile_StaysRemoved)
+{
+    // Arrange
+    NamespaceIndex index("db");
+    index.Put("db/000001.log", 0, 1);
+    index.Put("db/000002.log", 0, 1);
+    ASSERT_TRUE(index.Remove("db/000001.log"));
+    ASSERT_FALSE(index.Remove("db/000001.log"));
+
+    // Act
+    index.Update("db/000001.log", 100, 2);
+    index.Update("db/000002.log", 200, 3);
+
+    // Assert
+    ASSERT_FALSE(index.Find("db/000001.log").has_value());
+    const auto entry = index.Find("db/000002.log");
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_EQ(200, entry->Size);
+    ASSERT_EQ(3u, entry->ModifiedTime);
+}
+
+TEST(NamespaceIndexTests, Rename_KeepsSizeUnderNewName)
+{
+    // Arrange
+    NamespaceIndex index("db");
+    index.Put("db/000003.dbtmp", 16, 1);
+    index.Put("db/CURRENT", 16, 1);
+
+    // Act
+    index.Rename("db/000003.dbtmp", "db/CURRENT", 5);
+
+    // Assert
+    ASSERT_FALSE(index.Find("db/000003.dbtmp").has_value());
+    const auto entry = index.Find("db/CURRENT");
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_EQ(16, entry->Size);
+    ASSERT_EQ(5u, entry->ModifiedTime);
+}
+
+TEST(NamespaceIndexTests, List_Prefix_EntriesInNameOrder)
+{
+    // Arrange
+    NamespaceIndex index("");
+    index.Put("db/b", 2, 1);
+    index.Put("db/a", 1, 1);
+    index.Put("db/sub/c", std::nullopt, 1);
+    index.Put("dbx/d", 4, 1);
+
+    // Act
+    const auto entries = index.List("db/");
+    index.RemovePrefix("db/sub/");
+
+    // Assert
+    ASSERT_EQ(3u, entries.size());
+    ASSERT_EQ("db/a", entries[0].first);
+    ASSERT_EQ("db/b", entries[1].first);
+    ASSERT_EQ("db/sub/c", entries[2].first);
+    ASSERT_FALSE(entries[2].second.Size.has_value());
+    ASSERT_TRUE(index.HasChildren("db"));
+    ASSERT_FALSE(index.HasChildren("db/sub"));
+}
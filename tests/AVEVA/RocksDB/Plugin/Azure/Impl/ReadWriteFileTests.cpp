@@ -9,6 +9,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <algorithm>
+#include <mutex>
+
 using namespace AVEVA::RocksDB::Plugin::Azure::Impl;
 using namespace AVEVA::RocksDB::Plugin::Core;
 using namespace AVEVA::RocksDB::Plugin::Core::Mocks;
@@ -523,3 +526,152 @@ TEST_F(ReadWriteFileImplTests, Write_Overlapping_OverwritesData) {
     EXPECT_EQ('Q', readBuffer[150]);
     EXPECT_EQ('Q', readBuffer[199]);
 }
+
+TEST_F(ReadWriteFileImplTests, Flush_AdjacentWrites_CoalescedIntoOneUpload) {
+    // Arrange
+    std::vector<char> existing(Configuration::PageBlob::PageSize * 4, 'E');
+    m_blobSim->UploadPages(existing, 0);
+    m_blobSim->SetSize(static_cast<int64_t>(existing.size()));
+
+    EXPECT_CALL(*m_mockBlobClient, GetCapacity())
+        .Times(1);
+    EXPECT_CALL(*m_mockBlobClient, UploadPages(_, _))
+        .Times(1);
+    EXPECT_CALL(*m_mockBlobClient, DownloadTo(testing::A<std::span<char>>(), testing::A<int64_t>(), testing::A<int64_t>()))
+        .Times(2);
+
+    auto file = CreateFile();
+    const std::vector<char> data(100, 'S');
+
+    // Act
+    for (int64_t offset = 50; offset < 50 + 100 * 10; offset += 100)
+    {
+        file->Write(offset, data.data(), static_cast<int64_t>(data.size()));
+    }
+    file->Flush();
+
+    // Assert
+    const auto& blob = m_blobSim->GetData();
+    EXPECT_EQ('E', static_cast<char>(blob[49]));
+    EXPECT_EQ('S', static_cast<char>(blob[50]));
+    EXPECT_EQ('S', static_cast<char>(blob[1049]));
+    EXPECT_EQ('E', static_cast<char>(blob[1050]));
+}
+
+TEST_F(ReadWriteFileImplTests, Flush_OverlappingWritesInSamePage_PageDownloadedOnce) {
+    // Arrange
+    std::vector<char> existing(Configuration::PageBlob::PageSize * 2, 'E');
+    m_blobSim->UploadPages(existing, 0);
+    m_blobSim->SetSize(static_cast<int64_t>(existing.size()));
+
+    std::mutex downloadsMutex;
+    std::vector<int64_t> downloads;
+    EXPECT_CALL(*m_mockBlobClient, DownloadTo(testing::A<std::span<char>>(), testing::A<int64_t>(), testing::A<int64_t>()))
+        .WillRepeatedly(Invoke([this, &downloads, &downloadsMutex](std::span<char> buffer, int64_t offset, int64_t length)
+            {
+                std::scoped_lock lock(downloadsMutex);
+                downloads.push_back(offset);
+                return m_blobSim->DownloadTo(buffer, offset, length);
+            }));
+
+    auto file = CreateFile();
+    const std::vector<char> first(100, 'A');
+    const std::vector<char> second(100, 'B');
+
+    // Act
+    file->Write(10, first.data(), static_cast<int64_t>(first.size()));
+    file->Write(60, second.data(), static_cast<int64_t>(second.size()));
+    file->Write(Configuration::PageBlob::PageSize + 10, first.data(), static_cast<int64_t>(first.size()));
+    file->Flush();
+
+    // Assert
+    // The pages are downloaded concurrently, so the order isn't fixed.
+    std::sort(downloads.begin(), downloads.end());
+    const auto& blob = m_blobSim->GetData();
+    EXPECT_EQ((std::vector<int64_t>{ 0, Configuration::PageBlob::PageSize }), downloads);
+    EXPECT_EQ('E', static_cast<char>(blob[9]));
+    EXPECT_EQ('A', static_cast<char>(blob[59]));
+    EXPECT_EQ('B', static_cast<char>(blob[60]));
+    EXPECT_EQ('B', static_cast<char>(blob[159]));
+    EXPECT_EQ('E', static_cast<char>(blob[160]));
+    EXPECT_EQ('A', static_cast<char>(blob[Configuration::PageBlob::PageSize + 10]));
+}
+
+TEST_F(ReadWriteFileImplTests, Read_UnflushedWrites_ServedFromCache) {
+    // Arrange
+    std::vector<char> existing(Configuration::PageBlob::PageSize, 'E');
+    m_blobSim->UploadPages(existing, 0);
+    m_blobSim->SetSize(static_cast<int64_t>(existing.size()));
+
+    EXPECT_CALL(*m_mockBlobClient, UploadPages(_, _))
+        .Times(0);
+
+    auto file = CreateFile();
+    const std::vector<char> page(Configuration::PageBlob::PageSize, 'P');
+    const std::vector<char> partial(100, 'Q');
+
+    // Act
+    file->Write(Configuration::PageBlob::PageSize, page.data(), static_cast<int64_t>(page.size()));
+    file->Write(10, partial.data(), static_cast<int64_t>(partial.size()));
+    std::vector<char> readBuffer(Configuration::PageBlob::PageSize * 2);
+    const auto bytesRead = file->Read(0, static_cast<int64_t>(readBuffer.size()), readBuffer.data());
+
+    // Assert
+    EXPECT_EQ(Configuration::PageBlob::PageSize * 2, bytesRead);
+    EXPECT_EQ('E', readBuffer[9]);
+    EXPECT_EQ('Q', readBuffer[10]);
+    EXPECT_EQ('Q', readBuffer[109]);
+    EXPECT_EQ('E', readBuffer[110]);
+    EXPECT_EQ(page, std::vector<char>(readBuffer.begin() + Configuration::PageBlob::PageSize, readBuffer.end()));
+    ::testing::Mock::VerifyAndClearExpectations(m_mockBlobClient.get());
+}
+
+TEST_F(ReadWriteFileImplTests, Flush_AfterEarlierFlush_OnlyDirtyPagesWrittenBack) {
+    // Arrange
+    std::vector<std::pair<int64_t, size_t>> uploads;
+    EXPECT_CALL(*m_mockBlobClient, UploadPages(_, _))
+        .WillRepeatedly(Invoke([this, &uploads](const std::span<char> buffer, int64_t offset)
+            {
+                uploads.emplace_back(offset, buffer.size());
+                m_blobSim->UploadPages(buffer, offset);
+            }));
+    EXPECT_CALL(*m_mockBlobClient, DownloadTo(testing::A<std::span<char>>(), testing::A<int64_t>(), testing::A<int64_t>()))
+        .Times(0);
+
+    auto file = CreateFile();
+    const std::vector<char> data(Configuration::PageBlob::PageSize * 4, 'D');
+    const std::vector<char> update(10, 'U');
+
+    // Act
+    file->Write(0, data.data(), static_cast<int64_t>(data.size()));
+    file->Flush();
+    file->Write(Configuration::PageBlob::PageSize * 2 + 5, update.data(), static_cast<int64_t>(update.size()));
+    file->Flush();
+
+    // Assert
+    const std::vector<std::pair<int64_t, size_t>> expected{
+        { 0, static_cast<size_t>(Configuration::PageBlob::PageSize * 4) },
+        { Configuration::PageBlob::PageSize * 2, static_cast<size_t>(Configuration::PageBlob::PageSize) } };
+    EXPECT_EQ(expected, uploads);
+    EXPECT_EQ('D', static_cast<char>(m_blobSim->GetData()[Configuration::PageBlob::PageSize * 2 + 4]));
+    EXPECT_EQ('U', static_cast<char>(m_blobSim->GetData()[Configuration::PageBlob::PageSize * 2 + 5]));
+}
+
+TEST_F(ReadWriteFileImplTests, Write_CacheBudgetReached_DirtyPagesWrittenBack) {
+    // Arrange
+    constexpr int64_t cacheSize = Configuration::PageBlob::PageSize * 2;
+    EXPECT_CALL(*m_mockBlobClient, UploadPages(_, _))
+        .Times(1);
+
+    ReadWriteFileImpl file(m_testFileName, m_mockBlobClient, nullptr, m_logger, cacheSize);
+    const std::vector<char> data(Configuration::PageBlob::PageSize * 3, 'B');
+
+    // Act
+    file.Write(0, data.data(), static_cast<int64_t>(data.size()));
+
+    // Assert
+    std::vector<char> readBuffer(data.size());
+    EXPECT_EQ(static_cast<int64_t>(data.size()), file.Read(0, static_cast<int64_t>(readBuffer.size()), readBuffer.data()));
+    EXPECT_EQ(data, readBuffer);
+    ::testing::Mock::VerifyAndClearExpectations(m_mockBlobClient.get());
+}
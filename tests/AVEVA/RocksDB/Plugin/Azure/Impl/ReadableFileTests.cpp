@@ -7,6 +7,9 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <azure/core/exception.hpp>
+
+#include <system_error>
 
 using AVEVA::RocksDB::Plugin::Azure::Impl::ReadableFileImpl;
 using AVEVA::RocksDB::Plugin::Azure::Impl::Configuration;
@@ -62,6 +65,46 @@ TEST_F(ReadableFileTests, Constructor_InitializesWithBlobSize)
     EXPECT_EQ(0, file.GetOffset());
 }
 
+TEST_F(ReadableFileTests, Constructor_NoBlobRequests)
+{
+    // Arrange
+    EXPECT_CALL(*m_blobClient, GetSize())
+        .Times(0);
+    EXPECT_CALL(*m_blobClient, GetEtag())
+        .Times(0);
+
+    // Act
+    ReadableFileImpl file{ "test.sst", m_blobClient, nullptr, m_logger };
+
+    // Assert
+    EXPECT_EQ(0, file.GetOffset());
+}
+
+TEST_F(ReadableFileTests, RandomRead_SecondRead_MetadataFetchedOnce)
+{
+    // Arrange
+    static const constexpr int64_t bytesToRead = 100;
+    std::vector<char> buffer(bytesToRead);
+
+    EXPECT_CALL(*m_blobClient, GetSize())
+        .WillOnce(Return(DefaultBlobSize));
+    EXPECT_CALL(*m_blobClient, GetEtag())
+        .WillOnce(Return(::Azure::ETag{ "etag" }));
+    EXPECT_CALL(*m_blobClient, Download(::testing::A<std::span<char>>(), ::testing::_, bytesToRead, ::Azure::ETag{ "etag" }))
+        .Times(2)
+        .WillRepeatedly(Return(bytesToRead));
+
+    ReadableFileImpl file{ "test.sst", m_blobClient, nullptr, m_logger };
+
+    // Act
+    const auto firstRead = file.RandomRead(0, bytesToRead, buffer.data());
+    const auto secondRead = file.RandomRead(bytesToRead, bytesToRead, buffer.data());
+
+    // Assert
+    EXPECT_EQ(bytesToRead, firstRead);
+    EXPECT_EQ(bytesToRead, secondRead);
+}
+
 TEST_F(ReadableFileTests, SequentialRead_WithoutCache_ReadsFromBlob)
 {
     // Arrange
@@ -121,6 +164,36 @@ TEST_F(ReadableFileTests, SequentialRead_MultipleReads_IncrementsOffset)
     EXPECT_EQ(firstRead + secondRead, file.GetOffset());
 }
 
+TEST_F(ReadableFileTests, SequentialRead_WithReadahead_LaterReadsFromBuffer)
+{
+    // Arrange
+    const constexpr int64_t readahead = 200;
+    const constexpr int64_t readSize = 50;
+    std::vector<char> buffer1(readSize);
+    std::vector<char> buffer2(readSize);
+
+    EXPECT_CALL(*m_blobClient, Download(::testing::A<std::span<char>>(), 0, readahead, ::testing::_))
+        .WillOnce([](std::span<char> buffer, int64_t /*offset*/, int64_t /*length*/, const ::Azure::ETag& /*ifMatch*/)
+            {
+                std::fill_n(buffer.begin(), readSize, 'X');
+                std::fill_n(buffer.begin() + readSize, readahead - readSize, 'Y');
+                return static_cast<int64_t>(readahead);
+            });
+
+    ReadableFileImpl file{ "MANIFEST-000001", m_blobClient, nullptr, m_logger, readahead };
+
+    // Act
+    const auto bytesRead1 = file.SequentialRead(readSize, buffer1.data());
+    const auto bytesRead2 = file.SequentialRead(readSize, buffer2.data());
+
+    // Assert
+    EXPECT_EQ(readSize, bytesRead1);
+    EXPECT_EQ(readSize, bytesRead2);
+    EXPECT_EQ(std::vector<char>(readSize, 'X'), buffer1);
+    EXPECT_EQ(std::vector<char>(readSize, 'Y'), buffer2);
+    EXPECT_EQ(readSize * 2, file.GetOffset());
+}
+
 TEST_F(ReadableFileTests, SequentialRead_RequestMoreThanAvailable_ReadsOnlyAvailableBytes)
 {
     // Arrange
@@ -362,6 +435,33 @@ TEST_F(ReadableFileTests, RandomRead_DownloadReturnsNegative_ReturnsZero)
     EXPECT_EQ(0, bytesRead);
 }
 
+TEST_F(ReadableFileTests, RandomRead_BlobMissing_ThrowsNoSuchFile)
+{
+    // Arrange
+    std::vector<char> buffer(100);
+
+    EXPECT_CALL(*m_blobClient, GetSize())
+        .WillOnce([]() -> int64_t
+            {
+                ::Azure::Core::RequestFailedException notFound("The specified blob does not exist.");
+                notFound.StatusCode = ::Azure::Core::Http::HttpStatusCode::NotFound;
+                throw notFound;
+            });
+
+    ReadableFileImpl file{ "test.sst", m_blobClient, nullptr, m_logger };
+
+    // Act & Assert
+    try
+    {
+        [[maybe_unused]] const auto bytesRead = file.RandomRead(0, 100, buffer.data());
+        FAIL() << "Reading a missing blob should throw";
+    }
+    catch (const std::system_error& e)
+    {
+        EXPECT_EQ(std::errc::no_such_file_or_directory, e.code());
+    }
+}
+
 TEST_F(ReadableFileTests, SequentialRead_EmptyBlob_ReturnsZero)
 {
     // Arrange
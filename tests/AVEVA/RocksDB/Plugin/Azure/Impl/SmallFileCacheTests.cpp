@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/SmallFileCache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using AVEVA::RocksDB::Plugin::Azure::Impl::SmallFileCache;
+
+TEST(SmallFileCacheTests, Find_AfterPut_ReturnsContentsAndETag)
+{
+    // Arrange
+    SmallFileCache cache;
+    cache.Put("db/CURRENT", SmallFileCache::Entry{ { 'a', 'b' }, ::Azure::ETag("etag") });
+
+    // Act
+    const auto entry = cache.Find("db/CURRENT");
+
+    // Assert
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_EQ((std::vector<char>{ 'a', 'b' }), entry->Contents);
+    ASSERT_EQ(::Azure::ETag("etag"), entry->ETag);
+}
+
+TEST(SmallFileCacheTests, Put_Full_LeastRecentlyUsedEvicted)
+{
+    // Arrange
+    SmallFileCache cache(2);
+    cache.Put("db/CURRENT", SmallFileCache::Entry{});
+    cache.Put("db/IDENTITY", SmallFileCache::Entry{});
+    ASSERT_TRUE(cache.Find("db/CURRENT").has_value());
+
+    // Act
+    cache.Put("db/OPTIONS-000005", SmallFileCache::Entry{});
+
+    // Assert
+    ASSERT_TRUE(cache.Find("db/CURRENT").has_value());
+    ASSERT_FALSE(cache.Find("db/IDENTITY").has_value());
+    ASSERT_TRUE(cache.Find("db/OPTIONS-000005").has_value());
+}
+
+TEST(SmallFileCacheTests, RemovePrefix_OtherDirectoryKept)
+{
+    // Arrange
+    SmallFileCache cache;
+    cache.Put("db/CURRENT", SmallFileCache::Entry{});
+    cache.Put("other/CURRENT", SmallFileCache::Entry{});
+
+    // Act
+    cache.RemovePrefix("db/");
+
+    // Assert
+    ASSERT_FALSE(cache.Find("db/CURRENT").has_value());
+    ASSERT_TRUE(cache.Find("other/CURRENT").has_value());
+}
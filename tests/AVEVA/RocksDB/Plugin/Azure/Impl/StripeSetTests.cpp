@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/StripeSet.hpp"
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+using AVEVA::RocksDB::Plugin::Azure::Impl::StripeSet;
+
+static std::vector<StripeSet::Stripe> MakeStripes(const size_t count)
+{
+    std::vector<StripeSet::Stripe> stripes;
+    for (size_t i = 0; i < count; ++i)
+    {
+        stripes.push_back(StripeSet::Stripe{ "account/stripe" + std::to_string(i), {}, true });
+    }
+
+    return stripes;
+}
+
+static std::string SstName(const int number)
+{
+    return "db/" + std::to_string(number) + ".sst";
+}
+
+TEST(StripeSetTests, Place_MetadataFiles_Primary)
+{
+    // Arrange
+    StripeSet stripes(MakeStripes(4));
+
+    // Act & Assert
+    ASSERT_EQ(0u, stripes.Place("db/CURRENT"));
+    ASSERT_EQ(0u, stripes.Place("db/MANIFEST-000005"));
+    ASSERT_EQ(0u, stripes.Place("db/000007.log"));
+    ASSERT_EQ(0u, stripes.Place("db/OPTIONS-000009"));
+}
+
+TEST(StripeSetTests, Place_DataFiles_SpreadAndDeterministic)
+{
+    // Arrange
+    StripeSet stripes(MakeStripes(4));
+    StripeSet sameStripes(MakeStripes(4));
+
+    // Act
+    std::set<size_t> used;
+    for (int i = 1; i <= 200; ++i)
+    {
+        const auto stripe = stripes.Place(SstName(i));
+        ASSERT_EQ(stripe, sameStripes.Place(SstName(i)));
+        used.insert(stripe);
+    }
+
+    // Assert
+    ASSERT_EQ(4u, used.size());
+    ASSERT_EQ(stripes.Place("db/000012.sst"), stripes.Place("db/000012.blob"));
+}
+
+TEST(StripeSetTests, Place_StripeAdded_OnlyFilesOnNewStripeMove)
+{
+    // Arrange
+    StripeSet before(MakeStripes(3));
+    StripeSet after(MakeStripes(4));
+
+    // Act
+    size_t moved = 0;
+    for (int i = 1; i <= 200; ++i)
+    {
+        const auto was = before.Place(SstName(i));
+        const auto now = after.Place(SstName(i));
+        if (was != now)
+        {
+            // Assert
+            ASSERT_EQ(3u, now);
+            ++moved;
+        }
+    }
+
+    ASSERT_GT(moved, 0u);
+}
+
+TEST(StripeSetTests, Place_StripeNotAcceptingNewFiles_NeverChosen)
+{
+    // Arrange
+    auto config = MakeStripes(3);
+    config[1].AcceptsNewFiles = false;
+    config[0].AcceptsNewFiles = false;
+    StripeSet stripes(std::move(config));
+
+    // Act & Assert
+    for (int i = 1; i <= 200; ++i)
+    {
+        ASSERT_NE(1u, stripes.Place(SstName(i)));
+    }
+}
+
+TEST(StripeSetTests, RecordListed_OnTwoStripes_KeepsCopyNotBeingMovedTo)
+{
+    // Arrange
+    StripeSet stripes(MakeStripes(4));
+    const auto name = SstName(42);
+    const auto target = stripes.Place(name);
+    const auto other = (target + 1) % stripes.Size();
+
+    // Act
+    stripes.RecordListed(name, other);
+    stripes.RecordListed(name, target);
+    const auto first = stripes.Locate(name);
+    stripes.Forget(name);
+    stripes.RecordListed(name, target);
+    stripes.RecordListed(name, other);
+    const auto second = stripes.Locate(name);
+
+    // Assert
+    ASSERT_EQ(other, first);
+    ASSERT_EQ(other, second);
+}
+
+TEST(StripeSetTests, ForgetPrefix_LocateFallsBackToPlacement)
+{
+    // Arrange
+    StripeSet stripes(MakeStripes(4));
+    const auto name = SstName(7);
+    const auto other = (stripes.Place(name) + 1) % stripes.Size();
+    stripes.Record(name, other);
+    stripes.Record("dbx/000007.sst", other);
+
+    // Act
+    stripes.ForgetPrefix("db/");
+
+    // Assert
+    ASSERT_FALSE(stripes.Find(name).has_value());
+    ASSERT_EQ(stripes.Place(name), stripes.Locate(name));
+    ASSERT_EQ(other, stripes.Find("dbx/000007.sst"));
+}
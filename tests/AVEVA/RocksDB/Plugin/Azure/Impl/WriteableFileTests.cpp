@@ -2,13 +2,25 @@
 // SPDX-FileCopyrightText: Copyright 2025 AVEVA
 
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/WriteableFileImpl.hpp"
+#include "AVEVA/RocksDB/Plugin/Azure/Impl/BlobHelpers.hpp"
 #include "AVEVA/RocksDB/Plugin/Azure/Impl/Configuration.hpp"
 #include "AVEVA/RocksDB/Plugin/Core/Mocks/BlobClientMock.hpp"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+
 using AVEVA::RocksDB::Plugin::Azure::Impl::WriteableFileImpl;
 using AVEVA::RocksDB::Plugin::Azure::Impl::Configuration;
+using AVEVA::RocksDB::Plugin::Azure::Impl::BlobHelpers;
+using AVEVA::RocksDB::Plugin::Azure::Impl::DurabilityMode;
 using AVEVA::RocksDB::Plugin::Core::Mocks::BlobClientMock;
 using boost::log::sources::severity_logger_mt;
 using boost::log::trivial::severity_level;
@@ -919,3 +931,575 @@ TEST_F(WriteableFileTests, MoveAssignment_TransfersState_Correctly)
 
 
 
+
+TEST_F(WriteableFileTests, Append_MultipleBuffers_UploadsInBackground)
+{
+    // Arrange
+    constexpr int64_t bufferSize = Configuration::PageBlob::PageSize * 2;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::mutex uploadsMutex;
+    std::map<int64_t, std::vector<char>> uploads;
+    int64_t syncedSize = 0;
+
+    EXPECT_CALL(*m_blobClient, GetCapacity())
+        .WillRepeatedly(::testing::Return(Configuration::PageBlob::PageSize * 64));
+    EXPECT_CALL(*m_blobClient, UploadPages(_, _))
+        .WillRepeatedly([&](const std::span<char> buffer, const int64_t blobOffset)
+            {
+                released.wait();
+                std::scoped_lock lock(uploadsMutex);
+                uploads[blobOffset] = std::vector<char>(buffer.begin(), buffer.end());
+            });
+    EXPECT_CALL(*m_blobClient, SetSize(_))
+        .WillRepeatedly(::testing::SaveArg<0>(&syncedSize));
+
+    std::vector<char> data(static_cast<size_t>(Configuration::PageBlob::PageSize * 4 + 100));
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<char>(i / Configuration::PageBlob::PageSize);
+    }
+
+    WriteableFileImpl file{ "1.sst", m_blobClient, nullptr, m_logger, bufferSize, 3 };
+
+    // Act
+    // Two buffers can be uploading while the third is filled, so this doesn't block on the gated uploads.
+    // Append a page at a time so the data goes through the buffers rather than straight to the blob.
+    for (size_t offset = 0; offset < data.size(); offset += Configuration::PageBlob::PageSize)
+    {
+        const auto count = std::min(data.size() - offset, static_cast<size_t>(Configuration::PageBlob::PageSize));
+        file.Append(std::span(data).subspan(offset, count));
+    }
+    release.set_value();
+    file.Sync();
+
+    // Assert
+    ASSERT_EQ(static_cast<int64_t>(data.size()), syncedSize);
+    ASSERT_EQ(3, uploads.size());
+    ASSERT_EQ(std::vector<char>(data.begin(), data.begin() + bufferSize), uploads[0]);
+    ASSERT_EQ(std::vector<char>(data.begin() + bufferSize, data.begin() + bufferSize * 2), uploads[bufferSize]);
+    ASSERT_EQ(Configuration::PageBlob::PageSize, uploads[bufferSize * 2].size());
+    ASSERT_EQ(std::vector<char>(data.begin() + bufferSize * 2, data.end()),
+        std::vector<char>(uploads[bufferSize * 2].begin(), uploads[bufferSize * 2].begin() + 100));
+}
+
+TEST_F(WriteableFileTests, Sync_BackgroundUploadFailed_ThrowsAndDoesNotSetSize)
+{
+    // Arrange
+    EXPECT_CALL(*m_blobClient, GetCapacity())
+        .WillRepeatedly(::testing::Return(Configuration::PageBlob::PageSize * 64));
+    EXPECT_CALL(*m_blobClient, UploadPages(_, _))
+        .WillRepeatedly([](const std::span<char>, const int64_t)
+            {
+                throw std::runtime_error("upload failed");
+            });
+    EXPECT_CALL(*m_blobClient, SetSize(_))
+        .Times(0);
+
+    std::vector<char> data(static_cast<size_t>(Configuration::PageBlob::PageSize), 'u');
+    WriteableFileImpl file{ "1.sst", m_blobClient, nullptr, m_logger, Configuration::PageBlob::PageSize * 2, 2 };
+    file.Append(data);
+    file.Flush();
+
+    // Act & Assert
+    ASSERT_THROW(file.Sync(), std::runtime_error);
+    ASSERT_THROW(file.Sync(), std::runtime_error);
+}
+
+TEST_F(WriteableFileTests, Sync_BufferLargerThanUploadLimit_UploadsChunksConcurrently)
+{
+    // Arrange
+    constexpr int64_t chunkSize = Configuration::PageBlob::MaxUploadSize;
+    std::mutex uploadsMutex;
+    std::condition_variable allStarted;
+    std::map<int64_t, int64_t> uploads;
+    bool concurrent = false;
+    int64_t capacity = 0;
+    int64_t syncedSize = 0;
+
+    EXPECT_CALL(*m_blobClient, GetCapacity())
+        .WillRepeatedly(::testing::Return(Configuration::PageBlob::PageSize * 2));
+    EXPECT_CALL(*m_blobClient, SetCapacity(_))
+        .WillOnce(::testing::SaveArg<0>(&capacity));
+    EXPECT_CALL(*m_blobClient, UploadPages(_, _))
+        .Times(3)
+        .WillRepeatedly([&](const std::span<char> buffer, const int64_t blobOffset)
+            {
+                std::unique_lock lock(uploadsMutex);
+                uploads[blobOffset] = static_cast<int64_t>(buffer.size());
+                allStarted.notify_all();
+
+                // Each chunk waits for the others, which only succeeds if they are all in flight at once.
+                if (allStarted.wait_for(lock, std::chrono::seconds(5), [&]() { return uploads.size() == 3; }))
+                {
+                    concurrent = true;
+                }
+            });
+    EXPECT_CALL(*m_blobClient, SetSize(_))
+        .WillRepeatedly(::testing::SaveArg<0>(&syncedSize));
+
+    std::vector<char> data(static_cast<size_t>(chunkSize * 2 + 100), 'c');
+    WriteableFileImpl file{ "1.sst", m_blobClient, nullptr, m_logger, chunkSize * 2 + Configuration::PageBlob::PageSize, 1, 3 };
+
+    // Act
+    file.Append(data);
+    file.Sync();
+
+    // Assert
+    ASSERT_TRUE(concurrent);
+    ASSERT_EQ(static_cast<int64_t>(data.size()), syncedSize);
+    ASSERT_GE(capacity, chunkSize * 2 + Configuration::PageBlob::PageSize);
+    ASSERT_EQ(chunkSize, uploads[0]);
+    ASSERT_EQ(chunkSize, uploads[chunkSize]);
+    ASSERT_EQ(Configuration::PageBlob::PageSize, uploads[chunkSize * 2]);
+}
+
+TEST_F(WriteableFileTests, Sync_SizeTrailer_SizeUploadedWithData)
+{
+    // Arrange
+    std::vector<char> uploaded;
+    int64_t uploadOffset = -1;
+    EXPECT_CALL(*m_blobClient, GetCapacity())
+        .WillRepeatedly(::testing::Return(Configuration::PageBlob::PageSize * 4));
+    EXPECT_CALL(*m_blobClient, UploadPages(_, _))
+        .WillOnce([&](const std::span<char> buffer, const int64_t blobOffset)
+            {
+                uploaded.assign(buffer.begin(), buffer.end());
+                uploadOffset = blobOffset;
+            });
+    EXPECT_CALL(*m_blobClient, SetSize(_))
+        .Times(0);
+
+    WriteableFileImpl file{ "000001.log", m_blobClient, nullptr, m_logger, Configuration::PageBlob::DefaultBufferSize, 1, 1, true };
+    std::vector<char> data(100, 'w');
+
+    // Act
+    file.Append(data);
+    file.Sync();
+
+    // Assert
+    ASSERT_EQ(0, uploadOffset);
+    ASSERT_EQ(Configuration::PageBlob::PageSize * 2, uploaded.size());
+    ASSERT_EQ(data, std::vector<char>(uploaded.begin(), uploaded.begin() + 100));
+    const auto trailer = std::span<const char>(uploaded).subspan(Configuration::PageBlob::PageSize);
+    ASSERT_EQ(100, BlobHelpers::ReadSizeTrailer(trailer, Configuration::PageBlob::PageSize));
+    ASSERT_FALSE(BlobHelpers::ReadSizeTrailer(trailer, 0));
+    ASSERT_FALSE(BlobHelpers::ReadSizeTrailer(std::span<const char>(uploaded).first(Configuration::PageBlob::PageSize), 0));
+
+    // The size moves to the metadata when the file is closed.
+    ASSERT_TRUE(::testing::Mock::VerifyAndClearExpectations(m_blobClient.get()));
+    EXPECT_CALL(*m_blobClient, SetSize(100))
+        .Times(1);
+    file.Close();
+}
+
+TEST_F(WriteableFileTests, Sync_SizeTrailerLargerThanUploadLimit_EveryChunkEndsWithTrailer)
+{
+    // Arrange
+    constexpr int64_t chunkSize = Configuration::PageBlob::MaxUploadSize;
+    constexpr int64_t pageSize = Configuration::PageBlob::PageSize;
+    std::vector<std::pair<int64_t, int64_t>> uploads;
+    std::vector<std::optional<int64_t>> trailers;
+    EXPECT_CALL(*m_blobClient, GetCapacity())
+        .WillRepeatedly(::testing::Return(chunkSize * 4));
+    EXPECT_CALL(*m_blobClient, UploadPages(_, _))
+        .WillRepeatedly([&](const std::span<char> buffer, const int64_t blobOffset)
+            {
+                const auto size = static_cast<int64_t>(buffer.size());
+                uploads.emplace_back(blobOffset, size);
+                trailers.push_back(BlobHelpers::ReadSizeTrailer(buffer.last(static_cast<size_t>(pageSize)), blobOffset + size - pageSize));
+            });
+    EXPECT_CALL(*m_blobClient, SetSize(_))
+        .Times(::testing::AtMost(1));
+
+    WriteableFileImpl file{ "000001.log", m_blobClient, nullptr, m_logger, chunkSize * 2, 1, 1, true };
+    std::vector<char> data(static_cast<size_t>(chunkSize + 10), 'w');
+
+    // Act
+    file.Append(data);
+    file.Sync();
+
+    // Assert
+    const auto firstData = chunkSize - pageSize;
+    ASSERT_EQ(2, uploads.size());
+    ASSERT_EQ(std::make_pair(int64_t{ 0 }, chunkSize), uploads[0]);
+    ASSERT_EQ(firstData, trailers[0]);
+    ASSERT_EQ(std::make_pair(firstData, pageSize * 3), uploads[1]);
+    ASSERT_EQ(chunkSize + 10, trailers[1]);
+}
+
+TEST_F(WriteableFileTests, Sync_SizeTrailerSecondChunkFails_ReadersSeeFirstChunk)
+{
+    // Arrange
+    constexpr int64_t chunkSize = Configuration::PageBlob::MaxUploadSize;
+    constexpr int64_t pageSize = Configuration::PageBlob::PageSize;
+    std::vector<char> blob(static_cast<size_t>(chunkSize * 4));
+    int64_t written = 0;
+    int uploadCount = 0;
+    EXPECT_CALL(*m_blobClient, GetCapacity())
+        .WillRepeatedly(::testing::Return(chunkSize * 4));
+    EXPECT_CALL(*m_blobClient, UploadPages(_, _))
+        .WillRepeatedly([&](const std::span<char> buffer, const int64_t blobOffset)
+            {
+                if (++uploadCount == 2)
+                {
+                    throw std::runtime_error("Put Page failed");
+                }
+
+                std::copy(buffer.begin(), buffer.end(), blob.begin() + blobOffset);
+                written = std::max(written, blobOffset + static_cast<int64_t>(buffer.size()));
+            });
+
+    WriteableFileImpl file{ "000001.log", m_blobClient, nullptr, m_logger, chunkSize * 2, 1, 1, true };
+    std::vector<char> data(static_cast<size_t>(chunkSize + 10), 'w');
+    file.Append(data);
+
+    // Act
+    ASSERT_THROW(file.Sync(), std::runtime_error);
+
+    // Assert
+    // A reader takes the size from the last written page, as BlobHelpers::GetFileSize does.
+    const auto trailerOffset = written - pageSize;
+    const auto size = BlobHelpers::ReadSizeTrailer(std::span<const char>(blob).subspan(static_cast<size_t>(trailerOffset), static_cast<size_t>(pageSize)), trailerOffset);
+    ASSERT_EQ(chunkSize - pageSize, size);
+    ASSERT_TRUE(std::all_of(blob.begin(), blob.begin() + *size, [](const char c) { return c == 'w'; }));
+}
+
+TEST(BlobHelpersTests, GetFileSize_ListedBlobWithSizeTrailer_ReportedEmptyWithoutRequest)
+{
+    // Arrange
+    ::Azure::Storage::Blobs::Models::BlobItem open;
+    open.BlobType = ::Azure::Storage::Blobs::Models::BlobType::PageBlob;
+    open.BlobSize = Configuration::PageBlob::DefaultSize;
+    open.Details.Metadata = BlobHelpers::SizeTrailerMetadata();
+    auto closed = open;
+    closed.Details.Metadata = BlobHelpers::FileSizeMetadata(100);
+
+    // Act & Assert
+    ASSERT_TRUE(BlobHelpers::HasSizeTrailer(open));
+    ASSERT_EQ(0, BlobHelpers::GetFileSize(open));
+    ASSERT_FALSE(BlobHelpers::HasSizeTrailer(closed));
+    ASSERT_EQ(100, BlobHelpers::GetFileSize(closed));
+}
+
+TEST_F(WriteableFileTests, Sync_ConcurrentSyncs_GroupedIntoFewerUploads)
+{
+    // Arrange
+    constexpr int threadCount = 8;
+    constexpr size_t recordSize = 10;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<int> uploadCount = 0;
+    std::mutex uploadsMutex;
+    std::vector<char> lastUpload;
+    std::vector<int64_t> syncedSizes;
+
+    EXPECT_CALL(*m_blobClient, UploadPages(_, _))
+        .WillRepeatedly([&](const std::span<char> buffer, const int64_t blobOffset)
+            {
+                ASSERT_EQ(0, blobOffset);
+                uploadCount++;
+                released.wait();
+                std::scoped_lock lock(uploadsMutex);
+                lastUpload.assign(buffer.begin(), buffer.end());
+            });
+    EXPECT_CALL(*m_blobClient, SetSize(_))
+        .WillRepeatedly([&](const int64_t size)
+            {
+                std::scoped_lock lock(uploadsMutex);
+                syncedSizes.push_back(size);
+            });
+
+    WriteableFileImpl file{ "000001.log", m_blobClient, nullptr, m_logger };
+
+    // Act
+    std::vector<std::thread> writers;
+    for (int i = 0; i < threadCount; ++i)
+    {
+        writers.emplace_back([&file, i]()
+            {
+                const std::vector<char> record(recordSize, static_cast<char>('a' + i));
+                file.Append(record);
+                file.Sync();
+            });
+    }
+
+    // Appends aren't blocked by the sync that is waiting on its upload.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (file.GetFileSize() < static_cast<int64_t>(threadCount * recordSize) && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const auto appendedWhileUploading = file.GetFileSize();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    release.set_value();
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+
+    // Assert
+    ASSERT_EQ(static_cast<int64_t>(threadCount * recordSize), appendedWhileUploading);
+    ASSERT_LT(uploadCount, threadCount);
+    ASSERT_EQ(static_cast<int64_t>(threadCount * recordSize), syncedSizes.back());
+    ASSERT_TRUE(std::is_sorted(syncedSizes.begin(), syncedSizes.end()));
+    for (int i = 0; i < threadCount; ++i)
+    {
+        ASSERT_EQ(recordSize, std::count(lastUpload.begin(), lastUpload.begin() + threadCount * recordSize, static_cast<char>('a' + i)));
+    }
+}
+
+TEST_F(WriteableFileTests, Reserve_CapacityReservedUpFront_FlushDoesNotResize)
+{
+    // Arrange
+    std::vector<int64_t> capacities;
+    EXPECT_CALL(*m_blobClient, GetCapacity())
+        .WillRepeatedly(::testing::Return(Configuration::PageBlob::PageSize));
+    EXPECT_CALL(*m_blobClient, SetCapacity(_))
+        .WillRepeatedly([&capacities](const int64_t capacity) { capacities.push_back(capacity); });
+    EXPECT_CALL(*m_blobClient, UploadPages(_, _))
+        .Times(::testing::AtLeast(1));
+    EXPECT_CALL(*m_blobClient, SetSize(_))
+        .Times(::testing::AnyNumber());
+
+    WriteableFileImpl file{ "000010.sst", m_blobClient, nullptr, m_logger, Configuration::PageBlob::PageSize * 4 };
+    const std::vector<char> data(static_cast<size_t>(Configuration::PageBlob::PageSize * 10), 's');
+
+    // Act
+    file.Reserve(Configuration::PageBlob::PageSize * 16 - 100);
+    file.Reserve(Configuration::PageBlob::PageSize * 8);
+    file.Append(data);
+    file.Sync();
+
+    // Assert
+    ASSERT_EQ(std::vector<int64_t>{ Configuration::PageBlob::PageSize * 16 }, capacities);
+}
+
+TEST_F(WriteableFileTests, Flush_PastCapacityWithPreallocationBlockSize_GrowsByWholeBlocks)
+{
+    // Arrange
+    constexpr int64_t blockSize = Configuration::PageBlob::PageSize * 6;
+    std::vector<int64_t> capacities;
+    EXPECT_CALL(*m_blobClient, GetCapacity())
+        .WillRepeatedly(::testing::Return(Configuration::PageBlob::PageSize));
+    EXPECT_CALL(*m_blobClient, SetCapacity(_))
+        .WillRepeatedly([&capacities](const int64_t capacity) { capacities.push_back(capacity); });
+    EXPECT_CALL(*m_blobClient, UploadPages(_, _))
+        .Times(::testing::AtLeast(1));
+    EXPECT_CALL(*m_blobClient, SetSize(_))
+        .Times(::testing::AnyNumber());
+
+    WriteableFileImpl file{ "000010.sst", m_blobClient, nullptr, m_logger, Configuration::PageBlob::PageSize * 4 };
+    file.SetPreallocationBlockSize(blockSize);
+    const std::vector<char> page(static_cast<size_t>(Configuration::PageBlob::PageSize), 's');
+
+    // Act
+    for (int64_t written = 0; written < blockSize + Configuration::PageBlob::PageSize; written += Configuration::PageBlob::PageSize)
+    {
+        file.Append(page);
+    }
+    file.Sync();
+
+    // Assert
+    ASSERT_EQ((std::vector<int64_t>{ blockSize, blockSize * 2 }), capacities);
+}
+
+TEST_F(WriteableFileTests, Append_LargerThanBuffer_PagesUploadedFromCallerMemory)
+{
+    // Arrange
+    constexpr int64_t bufferSize = Configuration::PageBlob::PageSize * 2;
+    std::vector<char> data(static_cast<size_t>(Configuration::PageBlob::PageSize * 3 + 100), 'd');
+    std::vector<std::pair<const char*, int64_t>> uploads;
+    EXPECT_CALL(*m_blobClient, GetCapacity())
+        .WillRepeatedly(::testing::Return(Configuration::PageBlob::PageSize * 64));
+    EXPECT_CALL(*m_blobClient, UploadPages(_, _))
+        .WillRepeatedly([&uploads](const std::span<char> buffer, const int64_t blobOffset)
+            {
+                uploads.emplace_back(buffer.data(), blobOffset);
+            });
+    EXPECT_CALL(*m_blobClient, SetSize(static_cast<int64_t>(data.size())))
+        .Times(::testing::AtLeast(1));
+
+    WriteableFileImpl file{ "1.sst", m_blobClient, nullptr, m_logger, bufferSize };
+
+    // Act
+    file.Append(data);
+    file.Sync();
+
+    // Assert
+    ASSERT_EQ(2, uploads.size());
+    ASSERT_EQ(data.data(), uploads[0].first);
+    ASSERT_EQ(0, uploads[0].second);
+    ASSERT_NE(data.data() + Configuration::PageBlob::PageSize * 3, uploads[1].first);
+    ASSERT_EQ(Configuration::PageBlob::PageSize * 3, uploads[1].second);
+}
+
+TEST_F(WriteableFileTests, Append_LargerThanBufferAfterPartialPage_HeadCompletedThroughBuffer)
+{
+    // Arrange
+    constexpr int64_t bufferSize = Configuration::PageBlob::PageSize * 2;
+    const std::vector<char> first(100, 'a');
+    std::vector<char> second(static_cast<size_t>(Configuration::PageBlob::PageSize * 3), 'b');
+    std::map<int64_t, std::vector<char>> uploads;
+    std::vector<const char*> sources;
+    EXPECT_CALL(*m_blobClient, GetCapacity())
+        .WillRepeatedly(::testing::Return(Configuration::PageBlob::PageSize * 64));
+    EXPECT_CALL(*m_blobClient, UploadPages(_, _))
+        .WillRepeatedly([&](const std::span<char> buffer, const int64_t blobOffset)
+            {
+                uploads[blobOffset] = std::vector<char>(buffer.begin(), buffer.end());
+                sources.push_back(buffer.data());
+            });
+    EXPECT_CALL(*m_blobClient, SetSize(static_cast<int64_t>(first.size() + second.size())))
+        .Times(::testing::AtLeast(1));
+
+    WriteableFileImpl file{ "1.sst", m_blobClient, nullptr, m_logger, bufferSize };
+
+    // Act
+    file.Append(first);
+    file.Append(second);
+    file.Sync();
+
+    // Assert
+    constexpr auto head = static_cast<size_t>(Configuration::PageBlob::PageSize) - 100;
+    ASSERT_EQ(3, uploads.size());
+    ASSERT_EQ(std::vector<char>(first.begin(), first.end()), std::vector<char>(uploads[0].begin(), uploads[0].begin() + 100));
+    ASSERT_EQ(std::vector<char>(second.begin(), second.begin() + head), std::vector<char>(uploads[0].begin() + 100, uploads[0].end()));
+    ASSERT_EQ(second.data() + head, sources[1]);
+    ASSERT_EQ(Configuration::PageBlob::PageSize * 2, uploads[Configuration::PageBlob::PageSize].size());
+    const auto& tail = uploads[Configuration::PageBlob::PageSize * 3];
+    ASSERT_EQ(std::vector<char>(second.end() - 100, second.end()), std::vector<char>(tail.begin(), tail.begin() + 100));
+}
+
+TEST_F(WriteableFileTests, Flush_SyncDurability_UploadedOnlyOnSync)
+{
+    // Arrange
+    std::vector<int64_t> uploads;
+    EXPECT_CALL(*m_blobClient, UploadPages(_, _))
+        .WillRepeatedly([&uploads](const std::span<char>, const int64_t blobOffset) { uploads.push_back(blobOffset); });
+    EXPECT_CALL(*m_blobClient, SetSize(200))
+        .Times(::testing::AtLeast(1));
+
+    WriteableFileImpl file{ "000010.log", m_blobClient, nullptr, m_logger, Configuration::PageBlob::DefaultBufferSize, 1,
+        Configuration::PageBlob::DefaultUploadConcurrency, false, DurabilityMode::Sync };
+    const std::vector<char> data(100, 'w');
+
+    // Act
+    file.Append(data);
+    file.Flush();
+    file.Append(data);
+    file.Flush();
+    const auto uploadsBeforeSync = uploads.size();
+    file.Sync();
+
+    // Assert
+    ASSERT_EQ(0, uploadsBeforeSync);
+    ASSERT_EQ((std::vector<int64_t>{ 0 }), uploads);
+}
+
+TEST_F(WriteableFileTests, Sync_CloseDurability_UploadedOnlyOnClose)
+{
+    // Arrange
+    std::vector<int64_t> uploads;
+    std::vector<int64_t> sizes;
+    EXPECT_CALL(*m_blobClient, UploadPages(_, _))
+        .WillRepeatedly([&uploads](const std::span<char>, const int64_t blobOffset) { uploads.push_back(blobOffset); });
+    EXPECT_CALL(*m_blobClient, SetSize(_))
+        .WillRepeatedly([&sizes](const int64_t size) { sizes.push_back(size); });
+
+    WriteableFileImpl file{ "000010.sst", m_blobClient, nullptr, m_logger, Configuration::PageBlob::DefaultBufferSize, 1,
+        Configuration::PageBlob::DefaultUploadConcurrency, false, DurabilityMode::Close };
+    const std::vector<char> data(100, 's');
+
+    // Act
+    file.Append(data);
+    file.Flush();
+    file.Sync();
+    const auto uploadsBeforeClose = uploads.size();
+    const auto sizesBeforeClose = sizes.size();
+    file.Close();
+
+    // Assert
+    ASSERT_EQ(0, uploadsBeforeClose);
+    ASSERT_EQ(0, sizesBeforeClose);
+    ASSERT_EQ((std::vector<int64_t>{ 0 }), uploads);
+    ASSERT_EQ((std::vector<int64_t>{ 100 }), sizes);
+}
+
+TEST_F(WriteableFileTests, Flush_AppendOnlyBlob_AppendsExactlyTheNewBytes)
+{
+    // Arrange
+    m_blobClient->AppendOnly = true;
+    std::vector<std::pair<int64_t, std::string>> appends;
+    EXPECT_CALL(*m_blobClient, AppendBlock(_, _))
+        .WillRepeatedly([&appends](const std::span<const char> data, const int64_t blobOffset)
+            {
+                appends.emplace_back(blobOffset, std::string(data.begin(), data.end()));
+            });
+    EXPECT_CALL(*m_blobClient, UploadPages(_, _)).Times(0);
+    EXPECT_CALL(*m_blobClient, SetSize(_)).Times(0);
+
+    WriteableFileImpl file{ "000010.log", m_blobClient, nullptr, m_logger };
+
+    // Act
+    file.Append(std::string_view("abc"));
+    file.Flush();
+    file.Append(std::string_view("de"));
+    file.Sync();
+    file.Flush();
+
+    // Assert
+    ASSERT_EQ((std::vector<std::pair<int64_t, std::string>>{ { 0, "abc" }, { 3, "de" } }), appends);
+    ASSERT_EQ(5, file.GetFileSize());
+}
+
+TEST_F(WriteableFileTests, Append_ReopenedAppendOnlyBlob_AppendsAtBlobEnd)
+{
+    // Arrange
+    m_blobClient->AppendOnly = true;
+    EXPECT_CALL(*m_blobClient, GetSize()).WillRepeatedly(::testing::Return(1000));
+    EXPECT_CALL(*m_blobClient, DownloadTo(::testing::An<std::span<char>>(), _, _)).Times(0);
+    EXPECT_CALL(*m_blobClient, AppendBlock(_, 1000))
+        .WillOnce([](const std::span<const char> data, const int64_t) { ASSERT_EQ(10, data.size()); });
+
+    WriteableFileImpl file{ "000010.log", m_blobClient, nullptr, m_logger };
+
+    // Act
+    file.Append(std::vector<char>(10, 'r'));
+    file.Flush();
+
+    // Assert
+    ASSERT_EQ(1010, file.GetFileSize());
+}
+
+TEST_F(WriteableFileTests, Truncate_AppendOnlyBlobBelowSize_Throws)
+{
+    // Arrange
+    m_blobClient->AppendOnly = true;
+    EXPECT_CALL(*m_blobClient, AppendBlock(_, 0)).Times(1);
+    WriteableFileImpl file{ "LOG", m_blobClient, nullptr, m_logger };
+    file.Append(std::vector<char>(10, 't'));
+
+    // Act & Assert
+    ASSERT_THROW(file.Truncate(5), std::invalid_argument);
+    ASSERT_NO_THROW(file.Truncate(10));
+}
+
+TEST_F(WriteableFileTests, Constructor_KnownBlobState_PropertiesNotFetched)
+{
+    // Arrange
+    EXPECT_CALL(*m_blobClient, GetSize()).Times(0);
+    EXPECT_CALL(*m_blobClient, GetCapacity()).Times(0);
+    EXPECT_CALL(*m_blobClient, SetCapacity(_)).Times(0);
+    EXPECT_CALL(*m_blobClient, UploadPages(_, 0)).Times(1);
+    EXPECT_CALL(*m_blobClient, SetSize(100)).Times(::testing::AtLeast(1));
+
+    // Act
+    WriteableFileImpl file{ "MANIFEST-000001", m_blobClient, WriteableFileImpl::BlobState{ 0, Configuration::PageBlob::DefaultSize }, nullptr, m_logger };
+    file.Append(std::vector<char>(100, 'm'));
+    file.Sync();
+
+    // Assert
+    ASSERT_EQ(100, file.GetFileSize());
+}
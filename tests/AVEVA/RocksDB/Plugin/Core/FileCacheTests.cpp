@@ -315,3 +315,89 @@ TEST_F(FileCacheTests, CacheSizeExceeded)
     ASSERT_EQ(fileSize, m_cache.CacheSize());
     ASSERT_EQ(3, m_removedFiles.size());
 }
+
+TEST_F(FileCacheTests, Metrics_CountHitsMissesAndDownloads)
+{
+    // Arrange
+    using AVEVA::RocksDB::Plugin::Core::FileCacheMetrics;
+    const auto fileSize = static_cast<size_t>(20000);
+    EXPECT_CALL(*m_containerClient, GetBlobClient(_))
+        .WillRepeatedly(Invoke([fileSize](const std::string&)
+            {
+                auto blob = std::make_unique<BlobClientMock>();
+                EXPECT_CALL(*blob, GetSize())
+                    .WillRepeatedly(Return(fileSize));
+                return blob;
+            }));
+
+    EXPECT_CALL(*m_filesystem, Open(_))
+        .WillRepeatedly(Invoke([](const std::filesystem::path&)
+            {
+                auto file = std::make_unique<FileMock>();
+                EXPECT_CALL(*file, Read(_, _, _))
+                    .WillRepeatedly(Return(1));
+                return file;
+            }));
+
+    EnsureReadFromCache("1.sst", fileSize);
+    EnsureReadFromCache("2.sst", fileSize * 2);
+
+    // Act
+    m_cache.SetCacheSize(fileSize);
+    const auto metrics = m_cache.GetMetrics();
+
+    // Assert
+    ASSERT_EQ(2, metrics.Get(FileCacheMetrics::Ticker::Hits));
+    ASSERT_EQ(2, metrics.Get(FileCacheMetrics::Ticker::BytesRead));
+    ASSERT_LE(2, metrics.Get(FileCacheMetrics::Ticker::Misses));
+    ASSERT_EQ(2, metrics.Get(FileCacheMetrics::Ticker::DownloadsQueued));
+    ASSERT_EQ(2, metrics.Get(FileCacheMetrics::Ticker::DownloadsCompleted));
+    ASSERT_EQ(fileSize * 2, metrics.Get(FileCacheMetrics::Ticker::BytesDownloaded));
+    ASSERT_EQ(1, metrics.Get(FileCacheMetrics::Ticker::Evictions));
+    ASSERT_EQ(0, metrics.Get(FileCacheMetrics::Ticker::EvictionsUnused));
+    ASSERT_EQ(fileSize, metrics.Get(FileCacheMetrics::Ticker::BytesEvicted));
+    ASSERT_EQ(2, metrics.Get(FileCacheMetrics::Histogram::DownloadMicros).Count);
+    ASSERT_EQ(2, metrics.Get(FileCacheMetrics::Histogram::ReadMicros).Count);
+    ASSERT_EQ(0, metrics.QueueDepth);
+    ASSERT_EQ(fileSize, metrics.UsedBytes);
+    ASSERT_EQ(fileSize, metrics.MaxBytes);
+}
+
+TEST_F(FileCacheTests, GetEntries_ReturnsStateSizeAndLastAccess)
+{
+    // Arrange
+    using AVEVA::RocksDB::Plugin::Core::FileCacheEntry;
+    const auto fileSize = static_cast<size_t>(20000);
+    EXPECT_CALL(*m_containerClient, GetBlobClient(_))
+        .WillRepeatedly(Invoke([fileSize](const std::string&)
+            {
+                auto blob = std::make_unique<BlobClientMock>();
+                EXPECT_CALL(*blob, GetSize())
+                    .WillRepeatedly(Return(fileSize));
+                return blob;
+            }));
+
+    EXPECT_CALL(*m_filesystem, Open(_))
+        .WillRepeatedly(Invoke([](const std::filesystem::path&)
+            {
+                return std::make_unique<FileMock>();
+            }));
+
+    const auto start = std::chrono::system_clock::now();
+    EnsureReadFromCache("1.sst");
+    EnsureReadFromCache("2.sst");
+    m_cache.MarkFileAsStaleIfExists("1.sst");
+
+    // Act
+    const auto entries = m_cache.GetEntries();
+
+    // Assert
+    ASSERT_EQ(2, entries.size());
+    ASSERT_EQ("2.sst", entries[0].FilePath);
+    ASSERT_EQ(FileCacheEntry::State::Active, entries[0].State);
+    ASSERT_EQ(fileSize, entries[0].Size);
+    ASSERT_EQ(1, entries[0].AccessCount);
+    ASSERT_LE(start, entries[0].LastAccessTime);
+    ASSERT_EQ("1.sst", entries[1].FilePath);
+    ASSERT_EQ(FileCacheEntry::State::Stale, entries[1].State);
+}
@@ -9,6 +9,8 @@ namespace AVEVA::RocksDB::Plugin::Core::Mocks
     class BlobClientMock : public BlobClient
     {
     public:
+        bool AppendOnly = false;
+
         BlobClientMock();
         virtual ~BlobClientMock();
 
@@ -19,7 +21,13 @@ namespace AVEVA::RocksDB::Plugin::Core::Mocks
         MOCK_METHOD(void, DownloadTo, (const std::string& path, int64_t offset, int64_t length), (override));
         MOCK_METHOD(int64_t, DownloadTo, (std::span<char> buffer, int64_t blobOffset, int64_t length), (override));
         MOCK_METHOD(void, UploadPages, (const std::span<char> buffer, int64_t blobOffset), (override));
+        MOCK_METHOD(void, AppendBlock, (std::span<const char> data, int64_t blobOffset), (override));
         MOCK_METHOD(::Azure::ETag, GetEtag, (), (override));
         MOCK_METHOD(int64_t, Download, (std::span<char> buffer, int64_t blobOffset, int64_t length, const ::Azure::ETag& ifMatch), (override));
+
+        virtual bool IsAppendOnly() const override
+        {
+            return AppendOnly;
+        }
     };
 }
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Core/RocksDBHelpers.hpp"
+
+#include <gtest/gtest.h>
+
+using AVEVA::RocksDB::Plugin::Core::RocksDBHelpers;
+using FileClass = AVEVA::RocksDB::Plugin::Core::RocksDBHelpers::FileClass;
+
+TEST(RocksDBHelpersTests, GetFileType_DatabaseFiles_Classified)
+{
+    // Act & Assert
+    ASSERT_EQ(FileClass::SST, RocksDBHelpers::GetFileType("db/000012.sst"));
+    ASSERT_EQ(FileClass::SST, RocksDBHelpers::GetFileType("db/000012.ldb"));
+    ASSERT_EQ(FileClass::WAL, RocksDBHelpers::GetFileType("db/000013.log"));
+    ASSERT_EQ(FileClass::Blob, RocksDBHelpers::GetFileType("db/000014.blob"));
+    ASSERT_EQ(FileClass::Manifest, RocksDBHelpers::GetFileType("db/MANIFEST-000005"));
+    ASSERT_EQ(FileClass::Options, RocksDBHelpers::GetFileType("db/OPTIONS-000007"));
+    ASSERT_EQ(FileClass::Temp, RocksDBHelpers::GetFileType("db/OPTIONS-000007.dbtmp"));
+    ASSERT_EQ(FileClass::Temp, RocksDBHelpers::GetFileType("db/000003.dbtmp"));
+    ASSERT_EQ(FileClass::Current, RocksDBHelpers::GetFileType("db/CURRENT"));
+    ASSERT_EQ(FileClass::Identity, RocksDBHelpers::GetFileType("db/IDENTITY"));
+    ASSERT_EQ(FileClass::Lock, RocksDBHelpers::GetFileType("db/LOCK"));
+    ASSERT_EQ(FileClass::InfoLog, RocksDBHelpers::GetFileType("db/LOG"));
+    ASSERT_EQ(FileClass::InfoLog, RocksDBHelpers::GetFileType("db/LOG.old.1700000000000000"));
+    ASSERT_EQ(FileClass::InfoLog, RocksDBHelpers::GetFileType("logs/data_db_LOG"));
+}
+
+TEST(RocksDBHelpersTests, GetFileType_OutsideGrammar_Directory)
+{
+    // Act & Assert
+    ASSERT_EQ(FileClass::Directory, RocksDBHelpers::GetFileType("db"));
+    ASSERT_EQ(FileClass::Directory, RocksDBHelpers::GetFileType("db/"));
+    ASSERT_EQ(FileClass::Directory, RocksDBHelpers::GetFileType("db/MANIFEST-"));
+    ASSERT_EQ(FileClass::Directory, RocksDBHelpers::GetFileType("db/OPTIONS-12x"));
+    ASSERT_EQ(FileClass::Directory, RocksDBHelpers::GetFileType("db/CURRENT.bak"));
+    ASSERT_EQ(FileClass::Directory, RocksDBHelpers::GetFileType("MANIFEST.sst/dir"));
+}
+
+TEST(RocksDBHelpersTests, IsSmallFile_OnlyFilesWrittenInOneGo)
+{
+    // Act & Assert
+    ASSERT_TRUE(RocksDBHelpers::IsSmallFile("db/CURRENT"));
+    ASSERT_TRUE(RocksDBHelpers::IsSmallFile("db/OPTIONS-000007"));
+    ASSERT_TRUE(RocksDBHelpers::IsSmallFile("db/IDENTITY"));
+    ASSERT_TRUE(RocksDBHelpers::IsSmallFile("db/000003.dbtmp"));
+    ASSERT_FALSE(RocksDBHelpers::IsSmallFile("db/MANIFEST-000005"));
+    ASSERT_FALSE(RocksDBHelpers::IsSmallFile("db/LOCK"));
+    ASSERT_FALSE(RocksDBHelpers::IsSmallFile("db/000012.sst"));
+    ASSERT_TRUE(RocksDBHelpers::IsImmutableFile(FileClass::Blob));
+    ASSERT_FALSE(RocksDBHelpers::IsImmutableFile(FileClass::WAL));
+}
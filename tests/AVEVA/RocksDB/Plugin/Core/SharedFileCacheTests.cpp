@@ -0,0 +1,292 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: Copyright 2025 AVEVA
+
+#include "AVEVA/RocksDB/Plugin/Core/FileCache.hpp"
+#include "AVEVA/RocksDB/Plugin/Core/SharedFileCacheIndex.hpp"
+#include "AVEVA/RocksDB/Plugin/Core/Mocks/FilesystemMock.hpp"
+#include "AVEVA/RocksDB/Plugin/Core/Mocks/ContainerClientMock.hpp"
+#include "AVEVA/RocksDB/Plugin/Core/Mocks/BlobClientMock.hpp"
+#include "AVEVA/RocksDB/Plugin/Core/Mocks/FileMock.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <random>
+using boost::log::trivial::severity_level;
+using boost::log::sources::severity_logger_mt;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::Matcher;
+using AVEVA::RocksDB::Plugin::Core::FileCache;
+using AVEVA::RocksDB::Plugin::Core::SharedFileCacheIndex;
+using AVEVA::RocksDB::Plugin::Core::Mocks::FilesystemMock;
+using AVEVA::RocksDB::Plugin::Core::Mocks::ContainerClientMock;
+using AVEVA::RocksDB::Plugin::Core::Mocks::BlobClientMock;
+using AVEVA::RocksDB::Plugin::Core::Mocks::FileMock;
+
+// Each SharedFileCacheIndex constructed directly takes its own process slot, so two
+// instances pointed at the same directory behave like two separate processes.
+class SharedFileCacheTests : public ::testing::Test
+{
+protected:
+    std::filesystem::path m_cachePath;
+    std::shared_ptr<FilesystemMock> m_filesystem;
+    std::shared_ptr<severity_logger_mt<severity_level>> m_logger;
+    std::vector<std::filesystem::path> m_removedFiles;
+    std::mutex m_removedFilesMutex;
+
+public:
+    SharedFileCacheTests()
+        : m_cachePath(std::filesystem::temp_directory_path() / ("shared-cache-" + std::to_string(std::random_device{}()))),
+        m_filesystem(std::make_shared<FilesystemMock>()),
+        m_logger(std::make_shared<severity_logger_mt<severity_level>>())
+    {
+        ON_CALL(*m_filesystem, DeleteFile(_))
+            .WillByDefault([this](const std::filesystem::path& path)
+                {
+                    std::scoped_lock lock(m_removedFilesMutex);
+                    m_removedFiles.push_back(path);
+                    return true;
+                });
+        EXPECT_CALL(*m_filesystem, DeleteFile(_)).Times(::testing::AnyNumber());
+        EXPECT_CALL(*m_filesystem, CreateDir(_)).WillRepeatedly(Return(true));
+    }
+
+    ~SharedFileCacheTests() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(m_cachePath, ec);
+    }
+
+    std::shared_ptr<SharedFileCacheIndex> Attach(int64_t maxSize)
+    {
+        return std::make_shared<SharedFileCacheIndex>(m_cachePath, maxSize, m_filesystem, m_logger);
+    }
+
+    static std::shared_ptr<ContainerClientMock> CreateContainer(int64_t fileSize, std::shared_ptr<std::atomic<int>> downloads)
+    {
+        auto container = std::make_shared<ContainerClientMock>();
+        EXPECT_CALL(*container, GetBlobClient(_))
+            .WillRepeatedly(Invoke([fileSize, downloads](const std::string&)
+                {
+                    auto blob = std::make_unique<BlobClientMock>();
+                    EXPECT_CALL(*blob, GetSize())
+                        .WillRepeatedly(Return(fileSize));
+                    EXPECT_CALL(*blob, DownloadTo(Matcher<const std::string&>(_), _, _))
+                        .WillRepeatedly([downloads](const std::string&, int64_t, int64_t) { (*downloads)++; });
+                    return blob;
+                }));
+        return container;
+    }
+
+    void ExpectReads()
+    {
+        EXPECT_CALL(*m_filesystem, Open(_))
+            .WillRepeatedly(Invoke([](const std::filesystem::path&)
+                {
+                    auto file = std::make_unique<FileMock>();
+                    EXPECT_CALL(*file, Read(_, _, _))
+                        .WillRepeatedly(Return(1));
+                    return file;
+                }));
+    }
+
+    static void EnsureReadFromCache(FileCache& cache, const std::string_view filePath)
+    {
+        char buffer[1];
+        while (!cache.ReadFile(filePath, 0, 1, buffer))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+};
+
+TEST_F(SharedFileCacheTests, Index_SecondProcessSeesCompletedDownload)
+{
+    // Arrange
+    auto first = Attach(1000);
+    auto second = Attach(1000);
+    SharedFileCacheIndex::CachedFile existing{};
+
+    // Act
+    ASSERT_EQ(SharedFileCacheIndex::DownloadClaim::Claimed, first->BeginDownload("db/1.sst", 100, existing));
+    const auto busy = second->BeginDownload("db/1.sst", 100, existing);
+    const auto generation = first->CompleteDownload("db/1.sst");
+    const auto cached = second->BeginDownload("db/1.sst", 100, existing);
+
+    // Assert
+    ASSERT_NE(first->ProcessSlot(), second->ProcessSlot());
+    ASSERT_EQ(SharedFileCacheIndex::DownloadClaim::Busy, busy);
+    ASSERT_TRUE(generation);
+    ASSERT_EQ(SharedFileCacheIndex::DownloadClaim::Cached, cached);
+    ASSERT_EQ(100, existing.Size);
+    ASSERT_EQ(*generation, existing.Generation);
+    ASSERT_EQ(100, second->UsedBytes());
+}
+
+TEST_F(SharedFileCacheTests, Index_Initialize_LeavesOtherDirectoriesAlone)
+{
+    // Arrange
+    std::filesystem::create_directories(m_cachePath / "db");
+    EXPECT_CALL(*m_filesystem, DeleteDir(m_cachePath / "db")).Times(0);
+    EXPECT_CALL(*m_filesystem, DeleteDir(m_cachePath / ".shared-cache.files")).WillOnce(Return(true));
+
+    // Act
+    auto index = Attach(1000);
+
+    // Assert
+    ASSERT_EQ(m_cachePath / ".shared-cache.files", index->DataPath());
+    ASSERT_TRUE(std::filesystem::exists(m_cachePath / "db"));
+}
+
+TEST_F(SharedFileCacheTests, Index_PinnedFileIsNotEvictedByOtherProcess)
+{
+    // Arrange
+    auto first = Attach(100);
+    auto second = Attach(100);
+    SharedFileCacheIndex::CachedFile existing{};
+    ASSERT_EQ(SharedFileCacheIndex::DownloadClaim::Claimed, first->BeginDownload("db/1.sst", 100, existing));
+    const auto generation = first->CompleteDownload("db/1.sst");
+    ASSERT_TRUE(first->Pin("db/1.sst", *generation));
+
+    // Act
+    const auto whilePinned = second->BeginDownload("db/2.sst", 100, existing);
+    first->Unpin("db/1.sst");
+    const auto afterUnpin = second->BeginDownload("db/2.sst", 100, existing);
+
+    // Assert
+    ASSERT_EQ(SharedFileCacheIndex::DownloadClaim::NoSpace, whilePinned);
+    ASSERT_EQ(SharedFileCacheIndex::DownloadClaim::Claimed, afterUnpin);
+    ASSERT_FALSE(first->Pin("db/1.sst", *generation));
+    ASSERT_EQ(1, m_removedFiles.size());
+    ASSERT_EQ(first->DataPath() / "db/1.sst", m_removedFiles[0]);
+}
+
+TEST_F(SharedFileCacheTests, Index_InvalidateWhilePinnedDefersDeletion)
+{
+    // Arrange
+    auto first = Attach(1000);
+    auto second = Attach(1000);
+    SharedFileCacheIndex::CachedFile existing{};
+    ASSERT_EQ(SharedFileCacheIndex::DownloadClaim::Claimed, first->BeginDownload("db/1.sst", 100, existing));
+    const auto generation = first->CompleteDownload("db/1.sst");
+    ASSERT_TRUE(first->Pin("db/1.sst", *generation));
+
+    // Act
+    second->Invalidate("db/1.sst");
+    const auto removedWhilePinned = m_removedFiles.size();
+    const auto found = second->Find("db/1.sst");
+    first->Unpin("db/1.sst");
+
+    // Assert
+    ASSERT_EQ(0, removedWhilePinned);
+    ASSERT_FALSE(found);
+    ASSERT_EQ(1, m_removedFiles.size());
+    ASSERT_EQ(0, second->UsedBytes());
+}
+
+TEST_F(SharedFileCacheTests, Index_DetachingReleasesReferences)
+{
+    // Arrange
+    auto first = Attach(100);
+    auto second = Attach(100);
+    SharedFileCacheIndex::CachedFile existing{};
+    ASSERT_EQ(SharedFileCacheIndex::DownloadClaim::Claimed, first->BeginDownload("db/1.sst", 100, existing));
+    const auto generation = first->CompleteDownload("db/1.sst");
+    ASSERT_TRUE(first->Pin("db/1.sst", *generation));
+    ASSERT_EQ(SharedFileCacheIndex::DownloadClaim::Claimed, first->BeginDownload("db/3.sst", 0, existing));
+
+    // Act
+    first.reset();
+    const auto claim = second->BeginDownload("db/2.sst", 100, existing);
+
+    // Assert
+    ASSERT_EQ(SharedFileCacheIndex::DownloadClaim::Claimed, claim);
+    ASSERT_FALSE(second->Find("db/3.sst"));
+}
+
+TEST_F(SharedFileCacheTests, FileCache_ReusesFileDownloadedByAnotherProcess)
+{
+    // Arrange
+    ExpectReads();
+    auto firstDownloads = std::make_shared<std::atomic<int>>(0);
+    auto secondDownloads = std::make_shared<std::atomic<int>>(0);
+    FileCache first(m_cachePath, 1000, CreateContainer(100, firstDownloads), m_filesystem, m_logger, Attach(1000), "db");
+    FileCache second(m_cachePath, 1000, CreateContainer(100, secondDownloads), m_filesystem, m_logger, Attach(1000), "db");
+    EnsureReadFromCache(first, "1.sst");
+
+    // Act
+    char buffer[1];
+    const auto bytesRead = second.ReadFile("1.sst", 0, 1, buffer);
+
+    // Assert
+    ASSERT_TRUE(bytesRead);
+    ASSERT_EQ(1, *firstDownloads);
+    ASSERT_EQ(0, *secondDownloads);
+    ASSERT_EQ(100, second.CacheSize());
+}
+
+TEST_F(SharedFileCacheTests, CombineMetrics_CachesSharingIndex_BytesCountedOnce)
+{
+    // Arrange
+    ExpectReads();
+    auto downloads = std::make_shared<std::atomic<int>>(0);
+    auto index = Attach(1000);
+    FileCache first(m_cachePath, 1000, CreateContainer(100, downloads), m_filesystem, m_logger, index, "db1");
+    FileCache second(m_cachePath, 1000, CreateContainer(100, downloads), m_filesystem, m_logger, index, "db2");
+    EnsureReadFromCache(first, "1.sst");
+    EnsureReadFromCache(second, "1.sst");
+    std::vector<FileCache*> caches{ &first, &second };
+
+    // Act
+    const auto metrics = FileCache::CombineMetrics(caches);
+
+    // Assert
+    ASSERT_EQ(200, metrics.UsedBytes);
+    ASSERT_EQ(1000, metrics.MaxBytes);
+    ASSERT_EQ(2, metrics.Get(AVEVA::RocksDB::Plugin::Core::FileCacheMetrics::Ticker::DownloadsCompleted));
+}
+
+TEST_F(SharedFileCacheTests, FileCache_BudgetIsSharedBetweenProcesses)
+{
+    // Arrange
+    ExpectReads();
+    auto downloads = std::make_shared<std::atomic<int>>(0);
+    FileCache first(m_cachePath, 200, CreateContainer(100, downloads), m_filesystem, m_logger, Attach(200), "db1");
+    FileCache second(m_cachePath, 200, CreateContainer(100, downloads), m_filesystem, m_logger, Attach(200), "db2");
+    EnsureReadFromCache(first, "1.sst");
+    EnsureReadFromCache(first, "2.sst");
+
+    // Act
+    EnsureReadFromCache(second, "1.sst");
+
+    // Assert
+    ASSERT_EQ(200, first.CacheSize());
+    ASSERT_EQ(200, second.CacheSize());
+    ASSERT_EQ(1, m_removedFiles.size());
+    ASSERT_EQ(m_cachePath / ".shared-cache.files/db1/1.sst", m_removedFiles[0]);
+
+    char buffer[1];
+    ASSERT_FALSE(first.ReadFile("1.sst", 0, 1, buffer));
+    ASSERT_TRUE(first.ReadFile("2.sst", 0, 1, buffer));
+}
+
+TEST_F(SharedFileCacheTests, FileCache_RemoveFileInvalidatesOtherProcesses)
+{
+    // Arrange
+    ExpectReads();
+    auto downloads = std::make_shared<std::atomic<int>>(0);
+    FileCache first(m_cachePath, 1000, CreateContainer(100, downloads), m_filesystem, m_logger, Attach(1000), "db");
+    FileCache second(m_cachePath, 1000, CreateContainer(100, downloads), m_filesystem, m_logger, Attach(1000), "db");
+    EnsureReadFromCache(first, "1.sst");
+    EnsureReadFromCache(second, "1.sst");
+
+    // Act
+    second.RemoveFile("1.sst");
+
+    // Assert
+    char buffer[1];
+    ASSERT_FALSE(first.ReadFile("1.sst", 0, 1, buffer));
+    ASSERT_EQ(1, m_removedFiles.size());
+}